@@ -23,6 +23,19 @@
 */
 #include "pch.h"
 #include "CppUnitTest.h"
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include "../inc/linmat.hpp"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -177,10 +190,16 @@ namespace MatLinAlgUnitTests
 			m1 = m1 * c1;
 			m2 = m1.mult(I);
 
+			// Zero times infinity is NaN, as in the reference product
+			mat<double> m3 = I.mult(mat<double>{ {1,2,3}, {4,5,6}, {std::numeric_limits<double>::infinity(),8,9} });
+
 			// Evaluate result
 			for (unsigned int i = 0; i < rows; i++)
 				for (unsigned int j = 0; j < cols; j++)
 					Assert::AreEqual(m2[i][j], m1[i][j]);
+			Assert::IsTrue(std::isnan(m3[0][0]) && std::isnan(m3[1][0]));
+			Assert::IsTrue(std::isinf(m3[2][0]));
+			Assert::AreEqual(2.0, m3[0][1]);
 		}
 
 		TEST_METHOD(TestAddition)
@@ -513,5 +532,1742 @@ namespace MatLinAlgUnitTests
 				for (unsigned int j = 0; j < cols; j++)
 					Assert::AreEqual(m2[i][j], L[i][j], 0.001);
 		}
+
+		TEST_METHOD(TestQRDecomposition)
+		{
+			unsigned int rows = 4;
+			unsigned int cols = 3;
+
+			mat<double> m1{ {9,7,2},
+							{2,4,7},
+							{4,3,8},
+							{5,5,2} };
+
+			mat<double> Q;
+			mat<double> R;
+
+			// Perform QR decomposition
+			m1.qr_decomposition(Q, R);
+			mat<double> m2 = Q.mult(R);
+			mat<double> m3 = Q.transpose().mult(Q);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < rows; i++)
+				for (unsigned int j = 0; j < cols; j++)
+					Assert::AreEqual(m1[i][j], m2[i][j], 0.001);
+			for (unsigned int i = 0; i < cols; i++)
+				for (unsigned int j = 0; j < cols; j++)
+				{
+					Assert::AreEqual(i == j ? 1.0 : 0.0, m3[i][j], 0.001);
+					if (i > j)
+						Assert::AreEqual(0.0, R[i][j]);
+				}
+		}
+
+		TEST_METHOD(TestSVD)
+		{
+			unsigned int rows = 4;
+			unsigned int cols = 4;
+
+			mat<double> m1{ {9,7,2,3},
+							{2,4,7,7},
+							{4,3,8,5},
+							{5,5,2,3} };
+
+			mat<double> U;
+			mat<double> S;
+			mat<double> V;
+
+			// Perform singular value decomposition
+			m1.svd(U, S, V);
+			mat<double> m2 = U.mult(S).mult(V.transpose());
+
+			// Evaluate result
+			Assert::AreEqual(19.1573, S[0][0], 0.001);
+			for (unsigned int i = 0; i < rows; i++)
+				for (unsigned int j = 0; j < cols; j++)
+					Assert::AreEqual(m1[i][j], m2[i][j], 0.001);
+		}
+
+		TEST_METHOD(TestSVDFloat)
+		{
+			std::mt19937 engine(10);
+			mat<double> A = mat<double>::make_randn(60, 60, engine);
+			mat<float> Af(60, 60);
+			for (unsigned int i = 0; i < 60; i++)
+				for (unsigned int j = 0; j < 60; j++)
+					Af[i][j] = static_cast<float>(A[i][j]);
+			mat<double> U, S, V;
+			mat<float> Uf, Sf, Vf;
+
+			// Float stops at its own precision, in time comparable to double
+			auto start = std::chrono::steady_clock::now();
+			A.svd(U, S, V);
+			auto middle = std::chrono::steady_clock::now();
+			Af.svd(Uf, Sf, Vf);
+			auto end = std::chrono::steady_clock::now();
+			mat<float> Ar = Uf.mult(Sf).mult(Vf.transpose());
+
+			// Evaluate result
+			Assert::IsTrue(end - middle < 10 * (middle - start) + std::chrono::milliseconds(50));
+			for (unsigned int i = 0; i < 60; i++)
+			{
+				Assert::AreEqual(static_cast<float>(S[i][i]), Sf[i][i], 1e-4f * Sf[0][0]);
+				for (unsigned int j = 0; j < 60; j++)
+					Assert::AreEqual(Af[i][j], Ar[i][j], 1e-4f);
+			}
+		}
+
+		TEST_METHOD(TestRandomizedSVD)
+		{
+			unsigned int rows = 6;
+			unsigned int cols = 5;
+			unsigned int k = 2;
+
+			// Setup a rank 2 matrix
+			mat<double> a{ {1}, {2}, {3}, {4}, {5}, {6} };
+			mat<double> b{ {1, 0, -1, 2, 1} };
+			mat<double> c{ {0}, {1}, {0}, {-1}, {2}, {1} };
+			mat<double> d{ {3, 1, 1, 0, -2} };
+			mat<double> m1 = a.mult(b) + c.mult(d);
+
+			mat<double> U;
+			mat<double> S;
+			mat<double> V;
+
+			// Calculate low-rank approximation
+			randomized_svd(m1, k, U, S, V, 2, 1);
+			mat<double> m2 = U.mult(S).mult(V.transpose());
+
+			// Evaluate result
+			Assert::AreEqual(k, S.rows());
+			for (unsigned int i = 0; i < rows; i++)
+				for (unsigned int j = 0; j < cols; j++)
+					Assert::AreEqual(m1[i][j], m2[i][j], 0.001);
+		}
+
+		TEST_METHOD(TestEstimateSpectralNorm)
+		{
+			unsigned int rows = 3;
+			unsigned int cols = 3;
+			double c1 = 2;
+			double c2 = 3;
+			double c3 = 8;
+
+			mat<double> m1(rows, cols);
+
+			// Setup matrix
+			for (unsigned int i = 0; i < rows; i++)
+				for (unsigned int j = 0; j < cols; j++)
+					if (i == j)
+						m1[i][j] = c1;
+					else
+						m1[i][j] = c2;
+
+			// Evaluate result
+			Assert::AreEqual(c3, estimate_spectral_norm(m1), 0.001);
+		}
+
+		TEST_METHOD(TestEstimateTrace)
+		{
+			mat<double> m1{ {4,1,0},
+							{1,3,1},
+							{0,1,2} };
+
+			// Hutchinson's estimate is exact for a diagonal matrix
+			mat<double> m2{ {4,0,0},
+							{0,3,0},
+							{0,0,2} };
+
+			// Evaluate result
+			Assert::AreEqual(9, estimate_trace(m2, 4), 0.001);
+			Assert::AreEqual(9, estimate_trace(m1, 1000), 0.5);
+		}
+
+		TEST_METHOD(TestEstimateConditionNumber)
+		{
+			mat<double> m1{ {10,0,0},
+							{0,5,0},
+							{0,0,0.5} };
+
+			// Evaluate result
+			Assert::AreEqual(20, estimate_condition_number(m1), 0.01);
+		}
+
+		TEST_METHOD(TestConstSharedAcrossThreads)
+		{
+			const unsigned int n_threads = 4;
+
+			const mat<double> m1{ {9,7,2,3},
+								  {2,4,7,7},
+								  {4,3,8,5},
+								  {5,5,2,3} };
+
+			// Results from a single thread
+			const double norm = m1.spectral_norm();
+			const double det = m1.det();
+			const mat<double> inv = m1.inv();
+
+			std::vector<std::thread> threads;
+			std::vector<int> failures(n_threads, 0);
+
+			// Share the read-only matrix between threads
+			for (unsigned int t = 0; t < n_threads; t++)
+				threads.push_back(std::thread([&m1, &failures, &inv, norm, det, t]() {
+					for (unsigned int k = 0; k < 5; k++)
+					{
+						mat<double> m2 = m1.inv();
+						if (m1.spectral_norm() != norm || m1.det() != det)
+							failures[t]++;
+						for (unsigned int i = 0; i < m1.rows(); i++)
+							for (unsigned int j = 0; j < m1.cols(); j++)
+								if (m2[i][j] != inv[i][j])
+									failures[t]++;
+					}
+				}));
+			for (auto& thread : threads)
+				thread.join();
+
+			// Evaluate result
+			for (unsigned int t = 0; t < n_threads; t++)
+				Assert::AreEqual(0, failures[t]);
+		}
+
+		TEST_METHOD(TestKrylovSymmetric)
+		{
+			const unsigned int n = 20;
+
+			// Setup the 1D Laplacian, which is symmetric positive-definite
+			mat<double> A(n, n);
+			mat<double> x_true(n, 1);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				A[i][i] = 2;
+				if (i > 0)
+					A[i][i - 1] = -1;
+				if (i + 1 < n)
+					A[i][i + 1] = -1;
+				x_true[i][0] = static_cast<double>(i % 3) - 1;
+			}
+			mat<double> b = A.mult(x_true);
+
+			jacobi_preconditioner<double> jacobi(A);
+			ichol_preconditioner<double> ichol(A);
+			solver_options options;
+			options.tol = 1e-10;
+
+			// Solve with each method and preconditioner
+			mat<double> x1, x2, x3, x4;
+			Assert::IsTrue(cg(A, b, x1, options).converged);
+			Assert::IsTrue(cg(A, b, x2, options, &jacobi).converged);
+			Assert::IsTrue(minres(A, b, x3, options, &jacobi).converged);
+
+			// The IC(0) factor of a tridiagonal matrix is exact
+			solver_result result = cg(A, b, x4, options, &ichol);
+			Assert::IsTrue(result.converged);
+			Assert::IsTrue(result.iterations <= 2);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < n; i++)
+			{
+				Assert::AreEqual(x_true[i][0], x1[i][0], 1e-6);
+				Assert::AreEqual(x_true[i][0], x2[i][0], 1e-6);
+				Assert::AreEqual(x_true[i][0], x3[i][0], 1e-6);
+				Assert::AreEqual(x_true[i][0], x4[i][0], 1e-6);
+			}
+		}
+
+		TEST_METHOD(TestKrylovIndefinite)
+		{
+			mat<double> A{ {2,1,0,0},
+						   {1,-3,1,0},
+						   {0,1,1,2},
+						   {0,0,2,-4} };
+			mat<double> b{ {1}, {2}, {3}, {4} };
+			mat<double> x;
+
+			// MINRES handles symmetric indefinite systems
+			Assert::IsTrue(minres(A, b, x).converged);
+
+			// Evaluate result
+			mat<double> r = A.mult(x) - b;
+			Assert::AreEqual(0, r.frobenius_norm(), 1e-6);
+		}
+
+		TEST_METHOD(TestKrylovNonsymmetric)
+		{
+			const unsigned int n = 30;
+
+			// Setup a diagonally dominant nonsymmetric matrix
+			mat<double> A(n, n);
+			mat<double> b(n, 1);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				A[i][i] = 4;
+				if (i > 0)
+					A[i][i - 1] = -2;
+				if (i + 1 < n)
+					A[i][i + 1] = 1;
+				if (i + 3 < n)
+					A[i][i + 3] = 0.5;
+				b[i][0] = 1;
+			}
+
+			ilu_preconditioner<double> ilu(A);
+			solver_options options;
+			options.restart = 10;
+
+			// Solve with each method and preconditioner
+			mat<double> x1, x2, x3, x4;
+			Assert::IsTrue(gmres(A, b, x1, options).converged);
+			Assert::IsTrue(gmres(A, b, x2, options, &ilu).converged);
+			Assert::IsTrue(bicgstab(A, b, x3, options).converged);
+			Assert::IsTrue(bicgstab(A, b, x4, options, &ilu).converged);
+
+			// Evaluate result
+			Assert::AreEqual(0, (A.mult(x1) - b).frobenius_norm(), 1e-6);
+			Assert::AreEqual(0, (A.mult(x2) - b).frobenius_norm(), 1e-6);
+			Assert::AreEqual(0, (A.mult(x3) - b).frobenius_norm(), 1e-6);
+			Assert::AreEqual(0, (A.mult(x4) - b).frobenius_norm(), 1e-6);
+
+			// Skew-symmetric matrix where r.A.r = 0 breaks down at once
+			mat<double> K{ {0,1}, {-1,0} };
+			mat<double> k{ {1}, {2} };
+			mat<double> x5;
+			Assert::IsFalse(bicgstab(K, k, x5, options).converged);
+			Assert::IsTrue(std::isfinite(x5[0][0]) && std::isfinite(x5[1][0]));
+		}
+
+		TEST_METHOD(TestKrylovMatrixFree)
+		{
+			const unsigned int n = 50;
+
+			// The 1D Laplacian applied without storing a matrix
+			matvec_fn<double> A = [](const mat<double>& v) {
+				mat<double> y(v.rows(), 1);
+				for (unsigned int i = 0; i < v.rows(); i++)
+				{
+					y[i][0] = 2 * v[i][0];
+					if (i > 0)
+						y[i][0] -= v[i - 1][0];
+					if (i + 1 < v.rows())
+						y[i][0] -= v[i + 1][0];
+				}
+				return y;
+			};
+			mat<double> b = mat<double>::make_ones(n, 1);
+			mat<double> x;
+
+			// Iteration limit is configured per call
+			solver_options options;
+			options.max_iter = 5;
+			Assert::IsFalse(cg(A, b, x, options).converged);
+			options.max_iter = n;
+			Assert::IsTrue(cg(A, b, x, options).converged);
+
+			// Evaluate result
+			Assert::AreEqual(0, (A(x) - b).frobenius_norm(), 1e-6);
+		}
+
+		TEST_METHOD(TestLinearOperator)
+		{
+			mat<double> A{ {1,2}, {3,4}, {5,6} };
+			mat<double> B{ {2,0}, {1,3} };
+			mat<double> X{ {1,-1}, {2,0}, {0,1} };
+
+			dense_operator<double> opA(A);
+			dense_operator<double> opB(B);
+			gram_operator<double> gram(opA);
+			kronecker_operator<double> kron(opA, opB);
+
+			// Products with the transpose
+			mat<double> m1 = opA.apply_transpose(X);
+			mat<double> m2 = A.transpose().mult(X);
+			for (unsigned int i = 0; i < m1.rows(); i++)
+				for (unsigned int j = 0; j < m1.cols(); j++)
+					Assert::AreEqual(m2[i][j], m1[i][j], 1e-12);
+
+			// Gram operator
+			mat<double> v{ {1}, {-2} };
+			mat<double> m3 = gram.apply(v);
+			mat<double> m4 = A.transpose().mult(A).mult(v);
+			for (unsigned int i = 0; i < 2; i++)
+				Assert::AreEqual(m4[i][0], m3[i][0], 1e-12);
+
+			// Kronecker product against the explicit 6x4 matrix
+			mat<double> K(6, 4);
+			for (unsigned int i = 0; i < 3; i++)
+				for (unsigned int j = 0; j < 2; j++)
+					for (unsigned int k = 0; k < 2; k++)
+						for (unsigned int l = 0; l < 2; l++)
+							K[i * 2 + k][j * 2 + l] = A[i][j] * B[k][l];
+			mat<double> w{ {1}, {2}, {3}, {4} };
+			mat<double> u{ {1}, {0}, {-1}, {2}, {1}, {1} };
+			mat<double> m5 = kron.apply(w);
+			mat<double> m6 = K.mult(w);
+			mat<double> m7 = kron.apply_transpose(u);
+			mat<double> m8 = K.transpose().mult(u);
+			Assert::AreEqual(6u, kron.rows());
+			Assert::AreEqual(4u, kron.cols());
+			for (unsigned int i = 0; i < 6; i++)
+				Assert::AreEqual(m6[i][0], m5[i][0], 1e-12);
+			for (unsigned int i = 0; i < 4; i++)
+				Assert::AreEqual(m8[i][0], m7[i][0], 1e-12);
+		}
+
+		TEST_METHOD(TestPowerIteration)
+		{
+			mat<double> A{ {2,3,3}, {3,2,3}, {3,3,2} };
+			mat<double> v = mat<double>::make_ones(3, 1);
+			v[0][0] = 2;
+
+			// Evaluate result
+			dense_operator<double> op(A);
+			Assert::AreEqual(8, power_iteration<double>(op, v), 1e-6);
+			Assert::AreEqual(1 / std::sqrt(3.0), v[0][0], 1e-6);
+		}
+
+		TEST_METHOD(TestOperatorIterativeRoutines)
+		{
+			mat<double> A{ {4,1}, {2,3} };
+			mat<double> B{ {2,1}, {1,2} };
+			mat<double> A_inv = A.inv();
+			mat<double> B_inv = B.inv();
+
+			// A (x) B is never formed
+			dense_operator<double> opA(A);
+			dense_operator<double> opB(B);
+			kronecker_operator<double> kron(opA, opB);
+
+			// The inverse of a Kronecker product is the product of inverses
+			mat<double> X = inv_shulz<double>(kron);
+			for (unsigned int i = 0; i < 2; i++)
+				for (unsigned int j = 0; j < 2; j++)
+					for (unsigned int k = 0; k < 2; k++)
+						for (unsigned int l = 0; l < 2; l++)
+							Assert::AreEqual(A_inv[i][j] * B_inv[k][l], X[i * 2 + k][j * 2 + l], 1e-9);
+
+			// Norms of a Kronecker product are products of the norms
+			Assert::AreEqual(A.spectral_norm() * B.spectral_norm(), estimate_spectral_norm<double>(kron, 200, 1e-12), 1e-6);
+
+			// Krylov solvers accept operators
+			mat<double> b{ {1}, {2}, {3}, {4} };
+			mat<double> x;
+			Assert::IsTrue(gmres<double>(kron, b, x).converged);
+			Assert::AreEqual(0, (kron.apply(x) - b).frobenius_norm(), 1e-6);
+		}
+
+		TEST_METHOD(TestNorms1Inf)
+		{
+			mat<double> m{ {1,-2}, {-3,4}, {5,0} };
+
+			// Evaluate result
+			Assert::AreEqual(9.0, m.norm_1());
+			Assert::AreEqual(7.0, m.norm_inf());
+		}
+
+		TEST_METHOD(TestInvHyperpower)
+		{
+			unsigned int rows = 4;
+			unsigned int cols = 4;
+
+			mat<double> m1{ {9,7,2,3},
+							{2,4,7,7},
+							{4,3,8,5},
+							{5,5,2,3} };
+			mat<double> m2{ {1, 0.4, -0.2, -1.6},
+							{-1.5, -0.8, 0.4, 2.7},
+							{-0.785714, -0.542857, 0.485714, 1.24286},
+							{1.35714, 1.02857, -0.657143, -2.32857} };
+
+			// Higher orders converge in fewer iterations
+			dense_operator<double> op(m1);
+			unsigned int iterations = 0;
+			for (unsigned int order = 2; order <= 4; order++)
+			{
+				mat<double> X = m1.transpose() / (m1.norm_1() * m1.norm_inf());
+				solver_result result = inv_hyperpower<double>(op, X, order);
+				Assert::IsTrue(result.converged);
+				if (order > 2)
+					Assert::IsTrue(result.iterations < iterations);
+				iterations = result.iterations;
+
+				// Evaluate result
+				mat<double> m3 = m1.inv_hyperpower(order);
+				for (unsigned int i = 0; i < rows; i++)
+					for (unsigned int j = 0; j < cols; j++)
+					{
+						Assert::AreEqual(m2[i][j], X[i][j], 0.001);
+						Assert::AreEqual(m2[i][j], m3[i][j], 0.001);
+					}
+			}
+
+			// A singular matrix does not converge
+			bool thrown = false;
+			try
+			{
+				mat<double>::make_ones(rows, cols).inv_hyperpower(2);
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+		}
+
+		TEST_METHOD(TestInvSchulzZeroEntries)
+		{
+			mat<double> m1{ {2,0,0,0},
+							{0,4,0,0},
+							{0,0,4,1},
+							{0,0,1,4} };
+
+			// Calculate the inverse, which has exact zeros
+			mat<double> m2 = m1.inv_shulz();
+			mat<double> m3 = m1.mult(m2);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+					Assert::AreEqual(i == j ? 1.0 : 0.0, m3[i][j], 1e-9);
+			Assert::AreEqual(0.0, m2[0][1], 1e-12);
+		}
+
+		TEST_METHOD(TestLUFactorization)
+		{
+			// Requires pivoting, as the leading entry is zero
+			mat<double> m1{ {0,2,1},
+							{1,1,1},
+							{2,1,3} };
+			mat<double> b{ {3,1}, {3,0}, {6,2} };
+
+			lu_factorization<double> lu(m1);
+			mat<double> x = lu.solve(b);
+			mat<double> m2 = m1.mult(lu.inverse());
+
+			// Zero times infinity is NaN, as in the dense product
+			mat<double> y{ {std::numeric_limits<double>::infinity()}, {1}, {1} };
+			mat<double> m3 = lu_factorization<double>(mat<double>::make_eye(3, 3)).solve(y);
+
+			// Evaluate result
+			Assert::IsTrue(std::isnan(m3[1][0]));
+			Assert::AreEqual(m1.det(), lu.det(), 1e-12);
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				for (unsigned int j = 0; j < 2; j++)
+					Assert::AreEqual(b[i][j], m1.mult(x)[i][j], 1e-12);
+				for (unsigned int j = 0; j < 3; j++)
+					Assert::AreEqual(i == j ? 1.0 : 0.0, m2[i][j], 1e-12);
+			}
+		}
+
+		TEST_METHOD(TestInvUpdate)
+		{
+			const unsigned int n = 6;
+
+			mat<double> A(n, n);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < n; j++)
+					A[i][j] = (i == j) ? 10.0 : 1.0 / (1 + i + j);
+			mat<double> X = A.inv();
+
+			// Track the inverse of a slowly varying matrix
+			for (unsigned int t = 0; t < 5; t++)
+			{
+				for (unsigned int i = 0; i < n; i++)
+					A[i][(i + t) % n] += 0.001;
+
+				solver_result result = inv_update(A, X);
+				Assert::IsTrue(result.converged);
+				Assert::IsTrue(result.iterations > 0 && result.iterations <= 3);
+			}
+
+			// A large change falls back to the direct method
+			A[0][0] = -50;
+			mat<double> X_1 = A.inv_update(X);
+			mat<double> m1 = A.mult(X_1);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < n; j++)
+					Assert::AreEqual(i == j ? 1.0 : 0.0, m1[i][j], 1e-9);
+
+			// Float iteration stops at its rounding floor and is accepted
+			const unsigned int m = 100;
+			mat<float> F(m, m);
+			for (unsigned int i = 0; i < m; i++)
+				for (unsigned int j = 0; j < m; j++)
+					F[i][j] = (i == j) ? 10.0f : 1.0f / (1 + i + j);
+			mat<float> Y = F.inv();
+			for (unsigned int i = 0; i < m; i++)
+				F[i][i] += 0.01f;
+			solver_result result_f = inv_update(F, Y);
+			Assert::IsTrue(result_f.converged);
+			Assert::IsTrue(result_f.iterations > 0);
+			Assert::IsTrue(result_f.residual < 1e-4);
+		}
+
+		TEST_METHOD(TestWoodburyUpdate)
+		{
+			mat<double> A{ {4,1,0,1},
+						   {1,5,2,0},
+						   {0,2,6,1},
+						   {1,0,1,3} };
+			mat<double> U{ {1,0}, {0,1}, {2,0}, {0,-1} };
+			mat<double> C{ {2,1}, {0,1} };
+			mat<double> V{ {0,1}, {1,0}, {1,1}, {-1,0} };
+			mat<double> u{ {1}, {-1}, {0}, {2} };
+			mat<double> v{ {0}, {1}, {1}, {1} };
+			mat<double> A_1 = A + U.mult(C).mult(V.transpose());
+			mat<double> A_2 = A_1 + u.mult(v.transpose());
+
+			// Update an inverse and its determinant
+			mat<double> X = A.inv();
+			double det = A.det();
+			woodbury_update(X, det, U, C, V);
+			sherman_morrison_update(X, det, u, v);
+			mat<double> m1 = A_2.mult(X);
+
+			// Update a factorization
+			lu_factorization<double> lu(A);
+			lu.woodbury_update(U, C, V);
+			lu.sherman_morrison_update(u, v);
+			mat<double> m2 = A_2.mult(lu.inverse());
+
+			// The rank 2 update exceeds a quarter of the order and refactorizes
+			Assert::AreEqual(1u, lu.updates());
+			Assert::AreEqual(1u, lu.update_rank());
+
+			// Evaluate result
+			Assert::AreEqual(A_2.det(), det, 1e-9);
+			Assert::AreEqual(A_2.det(), lu.det(), 1e-9);
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+				{
+					Assert::AreEqual(i == j ? 1.0 : 0.0, m1[i][j], 1e-9);
+					Assert::AreEqual(i == j ? 1.0 : 0.0, m2[i][j], 1e-9);
+				}
+		}
+
+		TEST_METHOD(TestWoodburyUpdateStream)
+		{
+			const unsigned int n = 40;
+			std::mt19937 engine(11);
+			mat<double> A = mat<double>::make_randn(n, n, engine);
+			for (unsigned int i = 0; i < n; i++)
+				A[i][i] += 2 * n;
+			mat<double> b = mat<double>::make_randn(n, 1, engine);
+
+			// A stream of rank-1 updates keeps the stored rank bounded
+			lu_factorization<double> lu(A);
+			unsigned int max_rank = 0;
+			for (unsigned int t = 0; t < 200; t++)
+			{
+				mat<double> u = mat<double>::make_randn(n, 1, engine);
+				mat<double> v = mat<double>::make_randn(n, 1, engine) * 0.1;
+				A = A + u.mult(v.transpose());
+				lu.sherman_morrison_update(u, v);
+				max_rank = std::max(max_rank, lu.update_rank());
+			}
+			mat<double> x = lu.solve(b);
+			double det = lu.det();
+
+			// Updates of a Cholesky factorization refactorize on request
+			mat<double> S = A.gram();
+			mat<double> w = mat<double>::make_randn(n, 1, engine);
+			cholesky_factorization<double> chol(S);
+			chol.sherman_morrison_update(w, w);
+			chol.refactorize();
+			mat<double> y = chol.solve(b);
+			mat<double> z = (S + w.mult(w.transpose())).mult(y);
+
+			// Evaluate result
+			Assert::IsTrue(max_rank <= n / 4);
+			Assert::IsTrue(chol.updates() == 0);
+			Assert::AreEqual(lu_factorization<double>(A).det() / det, 1.0, 1e-9);
+			mat<double> r = A.mult(x);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				Assert::AreEqual(b[i][0], r[i][0], 1e-9);
+				Assert::AreEqual(b[i][0], z[i][0], 1e-9);
+			}
+		}
+
+		TEST_METHOD(TestCholeskyUpdate)
+		{
+			mat<double> A{ {4,1,0,1},
+						   {1,5,2,0},
+						   {0,2,6,1},
+						   {1,0,1,3} };
+			mat<double> x{ {1}, {-1}, {0.5}, {2} };
+			mat<double> y{ {0.5}, {0}, {1}, {-0.5} };
+
+			cholesky_factorization<double> chol(A);
+			chol.update(x);
+			chol.update(y);
+			chol.downdate(x);
+			mat<double> m1 = A + y.mult(y.transpose());
+			mat<double> m2 = chol.factor().mult(chol.factor().transpose());
+
+			// Evaluate result
+			Assert::AreEqual(m1.det(), chol.det(), 1e-9);
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+					Assert::AreEqual(m1[i][j], m2[i][j], 1e-12);
+		}
+
+		TEST_METHOD(TestCholeskyWindow)
+		{
+			const unsigned int n = 3, window = 4;
+			mat<double> X{ {1,2,0},
+						   {0,1,1},
+						   {2,0,1},
+						   {1,1,1},
+						   {-1,0,2},
+						   {0,3,1},
+						   {2,-1,0} };
+
+			cholesky_window<double> sliding(n, window, 0.1);
+			for (unsigned int t = 0; t < X.rows(); t++)
+			{
+				mat<double> row(1, n);
+				row[0] = X[t];
+				sliding.push(row);
+			}
+
+			// Gram matrix of the last four observations
+			mat<double> G = mat<double>::make_eye(n, n) * 0.1;
+			for (unsigned int t = X.rows() - window; t < X.rows(); t++)
+				for (unsigned int i = 0; i < n; i++)
+					for (unsigned int j = 0; j < n; j++)
+						G[i][j] += X[t][i] * X[t][j];
+			const mat<double>& L = sliding.cholesky().factor();
+			mat<double> m1 = L.mult(L.transpose());
+
+			// A failed downdate leaves the factor and window unchanged
+			cholesky_window<double> tiny(2, 1, 1e-12);
+			tiny.push(mat<double>{ {1e9, 1e9} });
+			mat<double> L0 = tiny.cholesky().factor();
+			bool thrown = false;
+			try
+			{
+				tiny.push(mat<double>{ {1, 0} });
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+			cholesky_factorization<double> chol(mat<double>{ {4,1,0}, {1,5,2}, {0,2,6} });
+			mat<double> L1 = chol.factor();
+			bool thrown_downdate = false;
+			try
+			{
+				chol.downdate(mat<double>{ {10}, {0}, {0} });
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown_downdate = true;
+			}
+
+			// Evaluate result
+			Assert::AreEqual(window, sliding.count());
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < n; j++)
+					Assert::AreEqual(G[i][j], m1[i][j], 1e-9);
+			Assert::IsTrue(thrown);
+			Assert::IsTrue(tiny.count() == 1);
+			for (unsigned int i = 0; i < 2; i++)
+				for (unsigned int j = 0; j < 2; j++)
+					Assert::IsTrue(tiny.cholesky().factor()[i][j] == L0[i][j]);
+			Assert::IsTrue(thrown_downdate);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < n; j++)
+					Assert::IsTrue(chol.factor()[i][j] == L1[i][j]);
+		}
+
+		TEST_METHOD(TestGram)
+		{
+			mat<double> m1{ {9,7,2},
+							{2,4,7},
+							{4,3,8},
+							{5,5,2} };
+
+			mat<double> m2 = m1.gram();
+			mat<double> m3 = m1.transpose().mult(m1);
+			mat<double> m4 = m1.outer_gram();
+			mat<double> m5 = m1.mult(m1.transpose());
+
+			// Zero times infinity is NaN, as in the dense product
+			mat<double> m6{ {0, std::numeric_limits<double>::infinity()}, {1, 1} };
+			mat<double> m7 = m6.gram();
+
+			// Evaluate result
+			for (unsigned int i = 0; i < 3; i++)
+				for (unsigned int j = 0; j < 3; j++)
+					Assert::AreEqual(m3[i][j], m2[i][j]);
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+					Assert::AreEqual(m5[i][j], m4[i][j]);
+			Assert::IsTrue(std::isnan(m7[0][1]) && std::isnan(m7[1][0]));
+			Assert::IsTrue(std::isnan(m6.transpose().mult(m6)[0][1]));
+			Assert::AreEqual(1.0, m7[0][0]);
+		}
+
+		TEST_METHOD(TestGramAccumulator)
+		{
+			mat<double> X{ {1e6 + 1, 2, 0},
+						   {1e6 + 0, 1, 1},
+						   {1e6 + 2, 0, 1},
+						   {1e6 + 1, 1, 1},
+						   {1e6 - 1, 0, 2} };
+			mat<double> b1{ {1e6 + 1, 2, 0}, {1e6 + 0, 1, 1} };
+			mat<double> b2{ {1e6 + 2, 0, 1}, {1e6 + 1, 1, 1}, {1e6 - 1, 0, 2} };
+
+			// Accumulate blocks separately and merge them
+			gram_accumulator<double> acc1(3), acc2(3);
+			acc1.add(b1);
+			acc2.add(b2);
+			acc1.merge(acc2);
+
+			// Reference covariance from the centered data
+			mat<double> mu = acc1.mean();
+			mat<double> C(X);
+			for (unsigned int i = 0; i < 5; i++)
+				for (unsigned int j = 0; j < 3; j++)
+					C[i][j] -= mu[0][j];
+			mat<double> cov = C.gram() / 4.0;
+			mat<double> G = X.gram();
+			mat<double> m1 = acc1.covariance();
+			mat<double> m2 = acc1.gram();
+
+			// Evaluate result
+			Assert::IsTrue(acc1.count() == 5);
+			Assert::AreEqual(1e6 + 0.6, mu[0][0], 1e-9);
+			for (unsigned int i = 0; i < 3; i++)
+				for (unsigned int j = 0; j < 3; j++)
+				{
+					Assert::AreEqual(cov[i][j], m1[i][j], 1e-9);
+					Assert::AreEqual(G[i][j], m2[i][j], 1e-9 * G[0][0]);
+				}
+		}
+
+		TEST_METHOD(TestStructuredMatrices)
+		{
+			mat<double> m1{ {9,7,2},
+							{2,4,7},
+							{4,3,8} };
+			diag_mat<double> D{ 2,-1,4 };
+			perm_mat<double> P(std::vector<unsigned int>{ 2,0,1 });
+			identity<double> I(3);
+			const_mat<double> J(3, 3, 0.5);
+
+			// Compare each product and sum with the dense equivalent
+			mat<double> m2[] = {
+				D.mult(m1), m1.mult(D), P.mult(m1), m1.mult(P),
+				J.mult(m1), m1.mult(J), I * 2.0 - m1, m1 + D, m1 - J,
+				D.inv().mult(D.mult(m1)), P.inv().mult(P.mult(m1)) };
+			mat<double> m3[] = {
+				D.dense().mult(m1), m1.mult(D.dense()), P.dense().mult(m1), m1.mult(P.dense()),
+				J.dense().mult(m1), m1.mult(J.dense()), mat<double>::make_eye(3, 3) * 2.0 - m1,
+				m1 + D.dense(), m1 - J.dense(), m1, m1 };
+
+			// Evaluate result
+			for (unsigned int k = 0; k < 11; k++)
+				for (unsigned int i = 0; i < 3; i++)
+					for (unsigned int j = 0; j < 3; j++)
+						Assert::AreEqual(m3[k][i][j], m2[k][i][j], 1e-12);
+			Assert::AreEqual(-8.0, D.det());
+			Assert::AreEqual(P.dense().det(), P.det());
+			Assert::AreEqual(8.0, (I * 2.0).det());
+		}
+
+		TEST_METHOD(TestPow)
+		{
+			mat<double> m1{ {1,1},
+							{1,0} };
+
+			// Fibonacci numbers
+			mat<double> m2 = m1.pow(10);
+			mat<double> m3 = m1.pow(0);
+
+			// Evaluate result
+			Assert::AreEqual(89.0, m2[0][0]);
+			Assert::AreEqual(55.0, m2[0][1]);
+			Assert::AreEqual(34.0, m2[1][1]);
+			Assert::AreEqual(1.0, m3[0][0]);
+			Assert::AreEqual(0.0, m3[0][1]);
+		}
+
+		TEST_METHOD(TestStrassenMult)
+		{
+			// Odd sizes exercise padding, and the cutoff forces recursion
+			std::mt19937 engine(1);
+			mat<double> A = mat<double>::make_randn(301, 157, engine);
+			mat<double> B = mat<double>::make_randn(157, 203, engine);
+
+			mat<double> m1 = A.mult(B);
+			mat<double> m2 = A.mult_strassen(B, 16);
+			mat<double> m3 = A.mult(B, mult_algorithm::strassen);
+
+			// Evaluate result against the naive product
+			for (unsigned int i = 0; i < 301; i++)
+				for (unsigned int j = 0; j < 203; j++)
+				{
+					double sum = 0;
+					for (unsigned int k = 0; k < 157; k++)
+						sum += A[i][k] * B[k][j];
+					Assert::AreEqual(sum, m1[i][j], 1e-10);
+					Assert::AreEqual(sum, m2[i][j], 1e-9);
+					Assert::AreEqual(sum, m3[i][j], 1e-9);
+				}
+		}
+
+		TEST_METHOD(TestTaskScheduler)
+		{
+			task_scheduler scheduler(4);
+
+			// Nested fork-join
+			std::function<unsigned long long(unsigned int)> fib = [&](unsigned int n) -> unsigned long long
+			{
+				if (n < 2)
+					return n;
+				unsigned long long a = 0, b = 0;
+				task_group group(scheduler);
+				group.run([&]() { a = fib(n - 1); });
+				b = fib(n - 2);
+				group.wait();
+				return a + b;
+			};
+			unsigned long long f = fib(20);
+
+			// Dependencies complete before their successors
+			task_graph graph(scheduler);
+			std::vector<unsigned int> order;
+			std::mutex lock;
+			auto record = [&](unsigned int i) { std::lock_guard<std::mutex> guard(lock); order.push_back(i); };
+			unsigned int t0 = graph.add([&]() { record(0); });
+			unsigned int t1 = graph.add([&]() { record(1); }, { t0 });
+			unsigned int t2 = graph.add([&]() { record(2); }, { t0 });
+			graph.add([&]() { record(3); }, { t1, t2 });
+			graph.run();
+
+			// Exceptions propagate to the waiting thread
+			bool thrown = false;
+			try
+			{
+				task_group group(scheduler);
+				group.run([]() { throw std::runtime_error("Task failed."); });
+				group.wait();
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+
+			// Evaluate result
+			Assert::IsTrue(f == 6765);
+			Assert::IsTrue(order.size() == 4);
+			Assert::IsTrue(order[0] == 0);
+			Assert::IsTrue(order[3] == 3);
+			Assert::IsTrue(thrown);
+		}
+
+		TEST_METHOD(TestTiledCholesky)
+		{
+			// Diagonally dominant matrix, of order not a multiple of the tile
+			unsigned int n = 203;
+			std::mt19937 engine(3);
+			mat<double> X = mat<double>::make_randn(n, n, engine);
+			mat<double> A = X.gram();
+			for (unsigned int i = 0; i < n; i++)
+				A[i][i] += n;
+
+			mat<double> L1(n, n), L2(n, n);
+			A.cholesky_decomposition_tiled(L1, 16);
+			A.cholesky_decomposition(L2);
+			mat<double> m1 = L1.mult(L1.transpose());
+
+			// An indefinite matrix throws on both paths
+			mat<double> B{ {1,2,0}, {2,1,0}, {0,0,1} };
+			mat<double> L3, L4;
+			bool thrown_serial = false, thrown_tiled = false;
+			try
+			{
+				B.cholesky_decomposition(L3);
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown_serial = true;
+			}
+			try
+			{
+				B.cholesky_decomposition_tiled(L4, 2);
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown_tiled = true;
+			}
+
+			// Evaluate result
+			Assert::IsTrue(thrown_serial && thrown_tiled);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < n; j++)
+				{
+					Assert::AreEqual(L2[i][j], L1[i][j], 1e-10);
+					Assert::AreEqual(A[i][j], m1[i][j], 1e-8);
+				}
+		}
+
+		TEST_METHOD(TestMappedMat)
+		{
+			mat<double> m1{ {1,2,3},
+							{4,5,6} };
+			save_binary(m1, "TestMappedMat.bin");
+			save_binary(m1, "TestMappedMatCol.bin", storage_layout::col_major);
+
+			// Load by copying rows, and by mapping in place
+			mat<double> m2("TestMappedMat.bin");
+			mat<double> m3 = load_binary<double>("TestMappedMatCol.bin");
+			double x, y, z;
+			{
+				mapped_mat<double> a("TestMappedMat.bin");
+				mapped_mat<double> b("TestMappedMat.bin", map_mode::copy_on_write);
+				b(1, 2) = 60;
+				x = a(1, 2);
+				y = b(1, 2);
+			}
+			{
+				mapped_mat<double> c("TestMappedMat.bin", map_mode::read_write);
+				c(0, 0) = 10;
+				c.flush();
+			}
+			mat<double> m4("TestMappedMat.bin");
+
+			// Create a file-backed matrix
+			{
+				mapped_mat<double> d = mapped_mat<double>::create("TestMappedMatNew.bin", 3, 2);
+				d(2, 1) = 7;
+			}
+			mat<double> m5("TestMappedMatNew.bin");
+
+			// Element type must match
+			bool thrown = false;
+			try
+			{
+				mapped_mat<float> e("TestMappedMat.bin");
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+
+			std::remove("TestMappedMat.bin");
+			std::remove("TestMappedMatCol.bin");
+			std::remove("TestMappedMatNew.bin");
+
+			// Evaluate result
+			for (unsigned int i = 0; i < 2; i++)
+				for (unsigned int j = 0; j < 3; j++)
+				{
+					Assert::AreEqual(m1[i][j], m2[i][j]);
+					Assert::AreEqual(m1[i][j], m3[i][j]);
+				}
+			Assert::AreEqual(6.0, x);
+			Assert::AreEqual(60.0, y);
+			Assert::AreEqual(10.0, m4[0][0]);
+			Assert::AreEqual(6.0, m4[1][2]);
+			Assert::AreEqual(7.0, m5[2][1]);
+			Assert::AreEqual(0.0, m5[0][0]);
+			Assert::IsTrue(thrown);
+		}
+
+		TEST_METHOD(TestOutOfCore)
+		{
+			std::mt19937 engine(4);
+			mat<double> X = mat<double>::make_randn(37, 23, engine);
+			mat<double> Y = mat<double>::make_randn(23, 29, engine);
+			mat<double> A = X.outer_gram();
+			for (unsigned int i = 0; i < 37; i++)
+				A[i][i] += 37;
+			save_binary(X, "TestOutOfCoreX.bin");
+			save_binary(Y, "TestOutOfCoreY.bin", storage_layout::col_major);
+			save_binary(A, "TestOutOfCoreA.bin");
+
+			// Budget of a few 8x8 tiles, so that the edge tiles are partial
+			{
+				mapped_mat<double> x("TestOutOfCoreX.bin");
+				mapped_mat<double> y("TestOutOfCoreY.bin");
+				mapped_mat<double> a("TestOutOfCoreA.bin");
+				mapped_mat<double> c = mapped_mat<double>::create("TestOutOfCoreC.bin", 37, 29);
+				mapped_mat<double> l = mapped_mat<double>::create("TestOutOfCoreL.bin", 37, 37);
+				mapped_mat<double> u = mapped_mat<double>::create("TestOutOfCoreU.bin", 37, 37);
+				mapped_mat<double> g = mapped_mat<double>::create("TestOutOfCoreG.bin", 37, 37);
+				mult_out_of_core(x, y, c, 6 * 64 * sizeof(double));
+				lu_decomposition_out_of_core(a, l, u, 8 * 64 * sizeof(double));
+				cholesky_decomposition_out_of_core(a, g, 7 * 64 * sizeof(double));
+			}
+			mat<double> m1("TestOutOfCoreC.bin");
+			mat<double> m2("TestOutOfCoreL.bin");
+			mat<double> m3("TestOutOfCoreU.bin");
+			mat<double> m4("TestOutOfCoreG.bin");
+			for (const char* path : { "TestOutOfCoreX.bin", "TestOutOfCoreY.bin", "TestOutOfCoreA.bin",
+				"TestOutOfCoreC.bin", "TestOutOfCoreL.bin", "TestOutOfCoreU.bin", "TestOutOfCoreG.bin" })
+				std::remove(path);
+
+			// Evaluate result against the in-memory methods
+			mat<double> m5 = X.mult(Y);
+			mat<double> L(37, 37), U(37, 37), G(37, 37);
+			A.lu_decomposition(L, U);
+			A.cholesky_decomposition(G);
+			for (unsigned int i = 0; i < 37; i++)
+			{
+				for (unsigned int j = 0; j < 29; j++)
+					Assert::AreEqual(m5[i][j], m1[i][j], 1e-10);
+				for (unsigned int j = 0; j < 37; j++)
+				{
+					Assert::AreEqual(L[i][j], m2[i][j], 1e-10);
+					Assert::AreEqual(U[i][j], m3[i][j], 1e-9);
+					Assert::AreEqual(G[i][j], m4[i][j], 1e-10);
+				}
+			}
+		}
+
+		TEST_METHOD(TestTextIO)
+		{
+			// Round trip of a file large enough to parse in chunks
+			std::mt19937 engine(5);
+			mat<double> m1 = mat<double>::make_randn(5000, 40, engine);
+			write_csv(m1, "TestTextIO.csv");
+			mat<double> m2 = read_csv<double>("TestTextIO.csv");
+
+			// Blanks, plus signs, carriage returns and blank lines
+			{
+				std::ofstream file("TestTextIO.txt", std::ios::binary);
+				file << "1; +2.5 ;-3e2\r\n\r\n 4;5;6\n";
+			}
+			mat<double> m3 = read_csv<double>("TestTextIO.txt", ';');
+
+			// Symmetric coordinate Matrix Market file
+			{
+				std::ofstream file("TestTextIO.mtx", std::ios::binary);
+				file << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 4\n1 1 4\n2 1 -1\n3 2 -2.5\n3 3 6\n";
+			}
+			sparse_mat<double> s1 = read_matrix_market<double>("TestTextIO.mtx");
+			write_matrix_market(s1, "TestTextIO2.mtx");
+			sparse_mat<double> s2 = read_matrix_market<double>("TestTextIO2.mtx");
+			write_matrix_market(m3, "TestTextIO3.mtx");
+			mat<double> m4 = read_matrix_market<double>("TestTextIO3.mtx").dense();
+
+			bool thrown = false;
+			try
+			{
+				std::ofstream file("TestTextIO.txt", std::ios::binary);
+				file << "1,2\n3\n";
+				file.close();
+				read_csv<double>("TestTextIO.txt");
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+
+			for (const char* path : { "TestTextIO.csv", "TestTextIO.txt", "TestTextIO.mtx", "TestTextIO2.mtx", "TestTextIO3.mtx" })
+				std::remove(path);
+
+			// Evaluate result, with values read back exactly
+			Assert::IsTrue(m2.rows() == 5000 && m2.cols() == 40);
+			for (unsigned int i = 0; i < 5000; i++)
+				for (unsigned int j = 0; j < 40; j++)
+					Assert::AreEqual(m1[i][j], m2[i][j]);
+			Assert::IsTrue(m3.rows() == 2 && m3.cols() == 3);
+			Assert::AreEqual(2.5, m3[0][1]);
+			Assert::AreEqual(-300.0, m3[0][2]);
+			Assert::AreEqual(6.0, m3[1][2]);
+			Assert::IsTrue(s1.nnz() == 6 && s2.nnz() == 6);
+			Assert::AreEqual(-1.0, s1(0, 1));
+			Assert::AreEqual(-2.5, s2(1, 2));
+			Assert::AreEqual(-2.5, s2(2, 1));
+			for (unsigned int i = 0; i < 2; i++)
+				for (unsigned int j = 0; j < 3; j++)
+					Assert::AreEqual(m3[i][j], m4[i][j]);
+			Assert::IsTrue(thrown);
+		}
+
+		TEST_METHOD(TestInstrument)
+		{
+			mat<double> m1{ {1,2},
+							{3,4} };
+
+			instrument::reset();
+			mat<double> m2 = m1.mult(m1);
+			mat<double> m3 = m1 + m2;
+			mat<double> m4 = m1.mult(m3);
+			std::map<std::string, instrument::op_stats> stats = instrument::snapshot();
+
+			// Evaluate result, counted only when built with LINMAT_INSTRUMENT
+			if (instrument::enabled())
+			{
+				Assert::IsTrue(stats["mat::mult"].calls == 2);
+				Assert::IsTrue(stats["mat::mult"].flops == 32);
+				Assert::IsTrue(stats["mat::mult"].bytes == 2 * 4 * sizeof(double));
+				Assert::IsTrue(stats["operator+"].calls == 1);
+				instrument::reset();
+				Assert::IsTrue(instrument::snapshot().empty());
+			}
+			else
+				Assert::IsTrue(stats.empty());
+		}
+
+		TEST_METHOD(TestTraceEvents)
+		{
+			std::mt19937 engine(6);
+			mat<double> A = mat<double>::make_randn(40, 40, engine).gram();
+			for (unsigned int i = 0; i < 40; i++)
+				A[i][i] += 40;
+
+			trace::clear();
+			mat<double> L(40, 40);
+			A.cholesky_decomposition_tiled(L, 8);
+			double norm = A.spectral_norm();
+			trace::dump("TestTrace.json");
+
+			std::ifstream file("TestTrace.json");
+			std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			file.close();
+
+			// Threads which exit return their buffers for reuse
+			for (unsigned int t = 0; t < 16; t++)
+				std::thread([]() { trace::record("thread", trace::now(), trace::now(), -1); }).join();
+			trace::dump("TestTrace.json");
+			std::ifstream file2("TestTrace.json");
+			std::string json2((std::istreambuf_iterator<char>(file2)), std::istreambuf_iterator<char>());
+			file2.close();
+			std::remove("TestTrace.json");
+			auto buffers = [](const std::string& s) {
+				unsigned int count = 0;
+				for (std::size_t p = s.find("thread_name"); p != std::string::npos; p = s.find("thread_name", p + 1))
+					count++;
+				return count;
+			};
+
+			// Evaluate result, with events only when built with LINMAT_TRACE
+			Assert::IsTrue(norm > 0);
+			Assert::IsTrue(json.find("\"traceEvents\"") != std::string::npos);
+			Assert::IsTrue(buffers(json2) <= buffers(json) + 1);
+			if (trace::enabled())
+			{
+				Assert::IsTrue(json.find("\"name\":\"cholesky_tiled::potrf\",\"ph\":\"X\"") != std::string::npos);
+				Assert::IsTrue(json.find("\"name\":\"spectral_norm\"") != std::string::npos);
+				Assert::IsTrue(json.find("\"name\":\"task\"") != std::string::npos);
+			}
+			else
+				Assert::IsTrue(json.find("\"ph\":\"X\"") == std::string::npos);
+		}
+
+		TEST_METHOD(TestTuning)
+		{
+			std::mt19937 engine(7);
+			mat<double> A = mat<double>::make_randn(37, 29, engine);
+			mat<double> B = mat<double>::make_randn(29, 41, engine);
+			mat<double> C = A.mult(B);
+			tuning_params original = tuning();
+
+			// Odd block sizes give the same product
+			tuning_params params = default_tuning();
+			params.gemm_mc = 5;
+			params.gemm_kc = 3;
+			params.gemm_nc = 7;
+			params.inv_iterative_threshold = 20;
+			set_tuning(params);
+			mat<double> C2 = A.mult(B);
+			Assert::IsTrue(tuning().gemm_kc == 3);
+
+			// Parameters round trip through a file, and a partial file
+			// overrides only its keys
+			save_tuning(params, "TestTuning.txt");
+			tuning_params loaded = load_tuning("TestTuning.txt");
+			std::ofstream file("TestTuning.txt");
+			file << "# partial\ncholesky_tile = 96\n";
+			file.close();
+			tuning_params partial = load_tuning("TestTuning.txt");
+			std::remove("TestTuning.txt");
+
+			// Tuned parameters are drawn from the candidates
+			tuning_params tuned = autotune(32);
+			set_tuning(original);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < C.rows(); i++)
+				for (unsigned int j = 0; j < C.cols(); j++)
+					Assert::AreEqual(C[i][j], C2[i][j], 1e-12);
+			Assert::IsTrue(loaded.gemm_mc == 5 && loaded.gemm_kc == 3 && loaded.gemm_nc == 7);
+			Assert::IsTrue(loaded.inv_iterative_threshold == 20);
+			Assert::IsTrue(partial.cholesky_tile == 96);
+			Assert::IsTrue(partial.gemm_mc == default_tuning().gemm_mc);
+			Assert::IsTrue(tuned.gemm_mc == 32 || tuned.gemm_mc == 64 || tuned.gemm_mc == 128);
+			Assert::IsTrue(tuned.gemm_kc == 128 || tuned.gemm_kc == 256 || tuned.gemm_kc == 512);
+			Assert::IsTrue(tuned.strassen_cutoff > 0);
+			Assert::IsTrue(tuning().gemm_mc == original.gemm_mc);
+		}
+
+		TEST_METHOD(TestMixedPrecisionSolve)
+		{
+			std::mt19937 engine(8);
+			mat<double> A = mat<double>::make_randn(60, 60, engine);
+			mat<double> b = mat<double>::make_randn(60, 2, engine);
+			mat<double> x;
+			mat<long double> Al{ {4,1,0}, {1,3,1}, {0,1,2} };
+			mat<long double> bl{ {1}, {2}, {3} };
+			mat<long double> xl;
+			mat<double> S{ {1,1}, {1,1 + 1e-12} };
+			mat<double> bs{ {2}, {2 + 1e-12} };
+			mat<double> xs;
+
+			solver_result r = mixed_precision_solve(A, b, x);
+			solver_result rl = mixed_precision_solve(Al, bl, xl);
+
+			// Residuals below the range of float are scaled before conversion
+			mat<double> bt = b * 1e-36;
+			mat<double> xt;
+			solver_result rt = mixed_precision_solve(A, bt, xt);
+
+			// Singular in single precision, so solved in double
+			solver_result rs = mixed_precision_solve(S, bs, xs);
+
+			// Evaluate result
+			mat<double> e = b - A.mult(x);
+			Assert::IsTrue(r.converged);
+			Assert::IsTrue(r.iterations > 0);
+			Assert::IsTrue(e.frobenius_norm() / b.frobenius_norm() <= 1e-14);
+			Assert::IsTrue(rt.converged);
+			Assert::IsTrue(rt.iterations > 0);
+			Assert::IsTrue(rt.residual <= 1e-14);
+			Assert::IsTrue(rl.converged);
+			Assert::IsTrue(std::fabs(static_cast<double>(xl[0][0]) - 2.0 / 9) < 1e-12);
+			Assert::IsTrue(rs.iterations == 0);
+			Assert::AreEqual(1.0, xs[0][0], 1e-3);
+		}
+
+		TEST_METHOD(TestHalfPrecision)
+		{
+			std::mt19937 engine(9);
+			mat<float> A = mat<float>::make_randn(70, 300, engine);
+			mat<float> B = mat<float>::make_randn(300, 50, engine);
+			mat<float16> Ah = to_float16(A), Bh = to_float16(B);
+			mat<bfloat16> Ab = to_bfloat16(A), Bb = to_bfloat16(B);
+
+			// Products of the rounded inputs, accumulated in float
+			mat<float> C = to_float(Ah).mult(to_float(Bh));
+			mat<float> Cb = to_float(Ab).mult(to_float(Bb));
+			mat<float16> Hd = Ah.mult(Bh);
+			mat<float> Ch = to_float(Hd);
+			mat<float> Cbb = to_float(Ab.mult(Bb));
+			mat<float16> D = Ah + Ah;
+			mat<bfloat16> E = Ab * bfloat16(2.0f);
+
+			// Ragged panels accumulate in the same order
+			tuning_params original = tuning();
+			tuning_params params = original;
+			params.gemm_mc = 16;
+			params.gemm_kc = 64;
+			params.gemm_nc = 16;
+			set_tuning(params);
+			mat<float16> Hp = Ah.mult(Bh);
+			set_tuning(original);
+
+			// Evaluate result
+			Assert::IsTrue(float(float16(1.0f)) == 1.0f);
+			Assert::IsTrue(float16(65504.0f).bits() == 0x7bff);
+			Assert::IsTrue(float16(65520.0f).bits() == 0x7c00);
+			Assert::IsTrue(float16(-2.0f).bits() == 0xc000);
+			Assert::IsTrue(float(float16::from_bits(0x0001)) == std::ldexp(1.0f, -24));
+			Assert::IsTrue(float16(std::ldexp(1.0f, -25)).bits() == 0);
+			Assert::IsTrue(float16(1.0f + std::ldexp(1.0f, -11)).bits() == 0x3c00);
+			Assert::IsTrue(float16(1.0f + 3 * std::ldexp(1.0f, -11)).bits() == 0x3c02);
+			Assert::IsTrue(std::isnan(float(float16(std::nanf("")))));
+			Assert::IsTrue(bfloat16(1.0f).bits() == 0x3f80);
+			Assert::IsTrue(bfloat16(1.0f + std::ldexp(1.0f, -8)).bits() == 0x3f80);
+			Assert::IsTrue(bfloat16(1.0f + 3 * std::ldexp(1.0f, -8)).bits() == 0x3f82);
+			Assert::IsTrue(std::isnan(float(bfloat16(std::nanf("")))));
+			for (unsigned int i = 0; i < C.rows(); i++)
+				for (unsigned int j = 0; j < C.cols(); j++)
+				{
+					Assert::AreEqual(C[i][j], Ch[i][j], 1e-3f * std::fabs(C[i][j]) + 1e-2f);
+					Assert::AreEqual(Cb[i][j], Cbb[i][j], 1e-2f * std::fabs(Cb[i][j]) + 1e-1f);
+				}
+			Assert::IsTrue(float(D[3][4]) == 2 * float(Ah[3][4]));
+			Assert::IsTrue(float(E[5][6]) == 2 * float(Ab[5][6]));
+			Assert::IsTrue(Ah.transpose()[4][3].bits() == Ah[3][4].bits());
+			for (unsigned int i = 0; i < Hp.rows(); i++)
+				for (unsigned int j = 0; j < Hp.cols(); j++)
+					Assert::IsTrue(Hp[i][j].bits() == Hd[i][j].bits());
+		}
+
+		TEST_METHOD(TestSparseCholeskyOrdering)
+		{
+			// 2D Laplacian on a k x k grid, large enough for the cost of the
+			// ordering to show against the factorization
+			const unsigned int k = 150, n = k * k;
+			std::vector<unsigned int> rows, cols;
+			std::vector<double> values;
+			for (unsigned int i = 0; i < k; i++)
+				for (unsigned int j = 0; j < k; j++)
+				{
+					unsigned int p = i * k + j;
+					rows.push_back(p); cols.push_back(p); values.push_back(4.1);
+					if (i > 0) { rows.push_back(p); cols.push_back(p - k); values.push_back(-1); }
+					if (i + 1 < k) { rows.push_back(p); cols.push_back(p + k); values.push_back(-1); }
+					if (j > 0) { rows.push_back(p); cols.push_back(p - 1); values.push_back(-1); }
+					if (j + 1 < k) { rows.push_back(p); cols.push_back(p + 1); values.push_back(-1); }
+				}
+			sparse_mat<double> A = sparse_mat<double>::from_triplets(n, n, rows, cols, values);
+			mat<double> b = mat<double>::make_ones(n, 1);
+
+			std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+			std::shared_ptr<sparse_cholesky_analysis> analysis = std::make_shared<sparse_cholesky_analysis>(A);
+			std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+			sparse_cholesky_factorization<double> chol(A, analysis, 1);
+			std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+			mat<double> r = A.mult(chol.solve(b)) - b;
+
+			// Evaluate result, with fill near O(n log n) and an analysis no
+			// slower than a few factorizations
+			Assert::IsTrue(analysis->factor_nnz() < 3ull * n * 15);
+			Assert::IsTrue(t1 - t0 < 5 * (t2 - t1) + std::chrono::milliseconds(50));
+			Assert::IsTrue(r.frobenius_norm() < 1e-9);
+		}
+
+		TEST_METHOD(TestSparseCholeskyChain)
+		{
+			// Tridiagonal matrix, whose elimination tree is a chain with one
+			// supernode per level
+			const unsigned int n = 20000;
+			std::vector<unsigned int> rows, cols;
+			std::vector<double> values;
+			for (unsigned int p = 0; p < n; p++)
+			{
+				rows.push_back(p); cols.push_back(p); values.push_back(4);
+				if (p > 0) { rows.push_back(p); cols.push_back(p - 1); values.push_back(-1); }
+				if (p + 1 < n) { rows.push_back(p); cols.push_back(p + 1); values.push_back(-1); }
+			}
+			sparse_mat<double> A = sparse_mat<double>::from_triplets(n, n, rows, cols, values);
+			mat<double> b = mat<double>::make_ones(n, 1);
+
+			sparse_cholesky_factorization<double> chol(A, 4);
+			mat<double> r = A.mult(chol.solve(b)) - b;
+
+			// Evaluate result
+			Assert::IsTrue(chol.analysis()->factor_nnz() == 2 * n - 1);
+			Assert::IsTrue(r.frobenius_norm() < 1e-10);
+		}
+
+		TEST_METHOD(TestPackedTriangular)
+		{
+			mat<double> m1{ {9,7,2,3},
+							{2,4,7,7},
+							{4,3,8,5},
+							{5,5,2,3} };
+			mat<double> b{ {1,2}, {0,1}, {3,-1}, {2,2} };
+
+			// Packed factors match the dense factors
+			mat<double> L1(4, 4), U1(4, 4);
+			tri_mat<double> L2(4), U2(4, false);
+			m1.lu_decomposition(L1, U1);
+			m1.lu_decomposition(L2, U2);
+			mat<double> m2 = L2.dense();
+			mat<double> m3 = U2.dense();
+			mat<double> m4 = L2.mult(U2.dense());
+
+			// Triangular solves
+			mat<double> x = U2.solve(L2.solve(b));
+			mat<double> m5 = m1.mult(x);
+
+			// Zero times infinity is NaN, as in the dense kernels
+			mat<double> I = mat<double>::make_eye(2, 2);
+			mat<double> y{ {std::numeric_limits<double>::infinity()}, {1} };
+			mat<double> m6 = tri_mat<double>(I).mult(y);
+			mat<double> m7 = tri_mat<double>(I).solve(y);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				for (unsigned int j = 0; j < 4; j++)
+				{
+					Assert::AreEqual(L1[i][j], m2[i][j], 1e-12);
+					Assert::AreEqual(U1[i][j], m3[i][j], 1e-12);
+					Assert::AreEqual(m1[i][j], m4[i][j], 1e-12);
+				}
+				for (unsigned int j = 0; j < 2; j++)
+					Assert::AreEqual(b[i][j], m5[i][j], 1e-12);
+			}
+			Assert::AreEqual(m1.det(), L2.det() * U2.det(), 1e-9);
+			Assert::AreEqual(U1.norm_1(), U2.norm_1(), 1e-12);
+			Assert::AreEqual(U1.norm_inf(), U2.norm_inf(), 1e-12);
+			Assert::AreEqual(U1.frobenius_norm(), U2.frobenius_norm(), 1e-12);
+			Assert::IsTrue(std::isnan(m6[1][0]) && std::isnan(I.mult(y)[1][0]));
+			Assert::IsTrue(std::isnan(m7[1][0]));
+		}
+
+		TEST_METHOD(TestPackedSymmetric)
+		{
+			mat<double> m1{ {9,7,2,3},
+							{2,4,7,7},
+							{4,3,8,5},
+							{5,5,2,3} };
+			mat<double> A = m1.outer_gram();
+			mat<double> b{ {1,2}, {0,1}, {3,-1}, {2,2} };
+
+			sym_mat<double> S(A);
+			tri_mat<double> L(4);
+			mat<double> L1(4, 4);
+			S.cholesky_decomposition(L);
+			A.cholesky_decomposition(L1);
+			mat<double> m2 = S.mult(b);
+			mat<double> m3 = A.mult(b);
+			mat<double> m4 = A.mult(S.solve(b));
+			mat<double> m5 = L.dense();
+
+			// Zero times infinity is NaN, as in the dense product
+			mat<double> y{ {std::numeric_limits<double>::infinity()}, {1}, {1}, {1} };
+			mat<double> m6 = sym_mat<double>(mat<double>::make_eye(4, 4)).mult(y);
+
+			// Evaluate result
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				for (unsigned int j = 0; j < 2; j++)
+				{
+					Assert::AreEqual(m3[i][j], m2[i][j], 1e-12);
+					Assert::AreEqual(b[i][j], m4[i][j], 1e-6);
+				}
+				for (unsigned int j = 0; j < 4; j++)
+					Assert::AreEqual(L1[i][j], m5[i][j], 1e-12);
+			}
+			Assert::AreEqual(A.trace(), S.trace());
+			Assert::AreEqual(A.norm_1(), S.norm_1());
+			Assert::AreEqual(A.frobenius_norm(), S.frobenius_norm(), 1e-12);
+			Assert::IsTrue(std::isinf(m6[0][0]) && std::isnan(m6[1][0]));
+
+			// A nonsymmetric matrix is rejected
+			bool thrown = false;
+			try
+			{
+				sym_mat<double> N(m1);
+			}
+			catch (const std::runtime_error&)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+		}
+
+		TEST_METHOD(TestBandedSolvers)
+		{
+			const unsigned int n = 8;
+
+			// Nonsymmetric band with kl = 2 and ku = 1, needing pivoting
+			band_mat<double> A(n, 2, 1);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = (i > 2 ? i - 2 : 0); j <= i + 1 && j < n; j++)
+					A(i, j) = (i == j) ? 0.5 : 1.0 + i - j * 0.5;
+			mat<double> b(n, 2);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				b[i][0] = 1.0 + i;
+				b[i][1] = (i % 2) ? 1.0 : -1.0;
+			}
+
+			band_lu_factorization<double> lu(A);
+			mat<double> m1 = A.dense().mult(lu.solve(b));
+			mat<double> m2 = A.mult(b);
+			mat<double> m3 = A.dense().mult(b);
+
+			// Symmetric positive-definite band with bandwidth 2
+			band_mat<double> S(n, 2, 2);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = (i > 2 ? i - 2 : 0); j <= i + 2 && j < n; j++)
+					S(i, j) = (i == j) ? 6.0 : -1.0;
+			band_cholesky_factorization<double> chol(S);
+			mat<double> m4 = S.mult(chol.solve(b));
+
+			// Zero times infinity is NaN, as in the dense kernels
+			band_mat<double> I(mat<double>::make_eye(3, 3), 1, 1);
+			mat<double> y{ {std::numeric_limits<double>::infinity()}, {1}, {1} };
+			mat<double> m5 = I.mult(y);
+			mat<double> m6 = band_lu_factorization<double>(I).solve(y);
+
+			// Evaluate result
+			Assert::IsTrue(std::isnan(m5[1][0]) && std::isnan(m6[1][0]));
+			Assert::AreEqual(A.dense().det(), lu.det(), 1e-9);
+			Assert::AreEqual(S.dense().det(), chol.det(), 1e-6);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < 2; j++)
+				{
+					Assert::AreEqual(b[i][j], m1[i][j], 1e-10);
+					Assert::AreEqual(m3[i][j], m2[i][j], 1e-12);
+					Assert::AreEqual(b[i][j], m4[i][j], 1e-10);
+				}
+		}
+
+		TEST_METHOD(TestTridiagonalSolve)
+		{
+			const unsigned int n = 1000000;
+
+			// Second difference matrix with a shift, from a 1D discretization
+			std::vector<double> sub(n - 1, -1.0), diag(n, 2.01), super(n - 1, -1.0), rhs(n);
+			for (unsigned int i = 0; i < n; i++)
+				rhs[i] = std::sin(0.001 * i);
+
+			std::vector<double> x = tridiagonal_solve(sub, diag, super, rhs);
+
+			// Evaluate the residual with the banded product
+			band_mat<double> A(n, 1, 1);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				A(i, i) = diag[i];
+				if (i > 0)
+					A(i, i - 1) = sub[i - 1];
+				if (i + 1 < n)
+					A(i, i + 1) = super[i];
+			}
+			std::vector<double> r = A.mult(x);
+			for (unsigned int i = 0; i < n; i++)
+				Assert::AreEqual(rhs[i], r[i], 1e-9);
+		}
+
+		TEST_METHOD(TestFFT)
+		{
+			const double pi = 3.14159265358979323846;
+
+			// Radix-2 and Bluestein lengths
+			for (unsigned int n : { 8u, 12u, 7u })
+			{
+				std::vector<std::complex<double>> x(n), y;
+				for (unsigned int k = 0; k < n; k++)
+					x[k] = std::complex<double>(std::cos(1.0 + k * k), std::sin(0.5 * k));
+				y = x;
+				fft(y);
+
+				// Compare with the direct transform
+				for (unsigned int k = 0; k < n; k++)
+				{
+					std::complex<double> s = 0;
+					for (unsigned int j = 0; j < n; j++)
+						s += x[j] * std::polar(1.0, -2 * pi * j * k / n);
+					Assert::AreEqual(s.real(), y[k].real(), 1e-12);
+					Assert::AreEqual(s.imag(), y[k].imag(), 1e-12);
+				}
+
+				// Round trip
+				fft(y, true);
+				for (unsigned int k = 0; k < n; k++)
+					Assert::AreEqual(x[k].real(), y[k].real(), 1e-12);
+			}
+		}
+
+		TEST_METHOD(TestToeplitzCirculant)
+		{
+			mat<double> b{ {1,2}, {0,1}, {3,-1}, {2,2}, {-1,0} };
+
+			// Circulant products and solves
+			circulant_mat<double> C({ 4, 1, 0, -1, 2 });
+			mat<double> m1 = C.mult(b);
+			mat<double> m2 = C.dense().mult(b);
+			mat<double> m3 = C.dense().mult(C.solve(b));
+
+			// Rectangular Toeplitz product
+			toeplitz_mat<double> R({ 1, 2, 3, 4, 5, 6 }, { 1, -1, 0.5, 2, 0 });
+			mat<double> m4 = R.mult(b);
+			mat<double> m5 = R.dense().mult(b);
+
+			// Nonsymmetric Toeplitz solve with the Levinson recursion
+			toeplitz_mat<double> S({ 5, 1, 0.5, -1, 0.25 }, { 5, 2, -1, 0.5, 1 });
+			mat<double> m6 = S.dense().mult(S.solve(b));
+
+			// Evaluate result
+			for (unsigned int i = 0; i < 5; i++)
+				for (unsigned int j = 0; j < 2; j++)
+				{
+					Assert::AreEqual(m2[i][j], m1[i][j], 1e-12);
+					Assert::AreEqual(b[i][j], m3[i][j], 1e-12);
+					Assert::AreEqual(b[i][j], m6[i][j], 1e-12);
+				}
+			for (unsigned int i = 0; i < 6; i++)
+				for (unsigned int j = 0; j < 2; j++)
+					Assert::AreEqual(m5[i][j], m4[i][j], 1e-12);
+		}
+
+		TEST_METHOD(TestSparseMatrix)
+		{
+			mat<double> m1{ {4,0,1,0},
+							{0,0,2,3},
+							{1,0,0,0} };
+			mat<double> b{ {1,2}, {0,1}, {3,-1}, {2,2} };
+
+			// Duplicate triplets are summed
+			sparse_mat<double> A = sparse_mat<double>::from_triplets(3, 4,
+				{ 2, 0, 1, 0, 1, 0 }, { 0, 2, 3, 0, 2, 2 }, { 1, 0.5, 3, 4, 2, 0.5 });
+			mat<double> m2 = A.mult(b);
+			mat<double> m3 = m1.mult(b);
+			mat<double> m4 = A.transpose().dense();
+
+			// Evaluate result
+			Assert::AreEqual(5u, A.nnz());
+			Assert::AreEqual(1.0, A(0, 2));
+			Assert::AreEqual(0.0, A(2, 3));
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				for (unsigned int j = 0; j < 2; j++)
+					Assert::AreEqual(m3[i][j], m2[i][j]);
+				for (unsigned int j = 0; j < 4; j++)
+					Assert::AreEqual(m1[i][j], m4[j][i]);
+			}
+		}
+
+		TEST_METHOD(TestSparseCholesky)
+		{
+			// 2D Laplacian on a k x k grid, with a shift
+			const unsigned int k = 12, n = k * k;
+			std::vector<unsigned int> rows, cols;
+			std::vector<double> values;
+			for (unsigned int i = 0; i < k; i++)
+				for (unsigned int j = 0; j < k; j++)
+				{
+					unsigned int p = i * k + j;
+					rows.push_back(p); cols.push_back(p); values.push_back(4.1);
+					if (i > 0) { rows.push_back(p); cols.push_back(p - k); values.push_back(-1); }
+					if (i + 1 < k) { rows.push_back(p); cols.push_back(p + k); values.push_back(-1); }
+					if (j > 0) { rows.push_back(p); cols.push_back(p - 1); values.push_back(-1); }
+					if (j + 1 < k) { rows.push_back(p); cols.push_back(p + 1); values.push_back(-1); }
+				}
+			sparse_mat<double> A = sparse_mat<double>::from_triplets(n, n, rows, cols, values);
+			mat<double> b(n, 2);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				b[i][0] = 1.0;
+				b[i][1] = std::sin(0.1 * i);
+			}
+
+			sparse_cholesky_factorization<double> chol(A, 4);
+			mat<double> m1 = A.mult(chol.solve(b));
+
+			// Reuse the analysis for a matrix with the same pattern
+			std::vector<double> scaled(values);
+			for (double& v : scaled)
+				v *= 2;
+			sparse_mat<double> B = sparse_mat<double>::from_triplets(n, n, rows, cols, scaled);
+			sparse_cholesky_factorization<double> chol2(B, chol.analysis(), 1);
+			mat<double> m2 = B.mult(chol2.solve(b));
+
+			// Evaluate result, with less fill than the banded profile
+			Assert::IsTrue(chol.analysis()->factor_nnz() < static_cast<unsigned long long>(n) * (k + 1));
+			Assert::IsTrue(chol.analysis()->supernodes() < n);
+			Assert::AreEqual(std::log(chol.det()) + n * std::log(2.0), std::log(chol2.det()), 1e-9);
+			for (unsigned int i = 0; i < n; i++)
+				for (unsigned int j = 0; j < 2; j++)
+				{
+					Assert::AreEqual(b[i][j], m1[i][j], 1e-10);
+					Assert::AreEqual(b[i][j], m2[i][j], 1e-10);
+				}
+		}
 	};
 }
@@ -0,0 +1,389 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../inc/linmat.hpp"
+
+using namespace linmat;
+
+/// <summary>
+///   Benchmark settings from the command line.
+/// </summary>
+struct settings
+{
+	std::vector<std::string> kernels;
+	std::vector<std::string> types{ "float", "double", "long_double" };
+	std::vector<unsigned int> sizes{ 64, 128, 256, 512 };
+	bool sizes_given = false;
+	unsigned int min_reps = 5;
+	unsigned int max_reps = 1000;
+	double min_time = 0.2;
+	std::string json;
+};
+
+/// <summary>
+///   Timing of one kernel at one size.
+/// </summary>
+struct result
+{
+	std::string kernel;
+	std::string type;
+	unsigned int n;
+	unsigned int reps;
+	double min, mean, p50, p90, p99, max;
+	double gflops;
+	double gbytes;
+};
+
+/// <summary>
+///   Inputs shared by the kernels at one size.
+/// </summary>
+/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+template <typename T>
+struct inputs
+{
+	mat<T> A;	// Random matrix
+	mat<T> B;	// Random matrix
+	mat<T> S;	// Symmetric positive-definite, well conditioned
+};
+
+/// <summary>
+///   Kernel to benchmark, with models of its floating-point operations 
+///   and of the least memory traffic in elements, as functions of the 
+///   order n. A zero model is not reported. A kernel limited to small 
+///   orders has its own default sizes, used unless sizes are given.
+/// </summary>
+/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+template <typename T>
+struct kernel
+{
+	std::string name;
+	unsigned int max_size;
+	std::function<double(double)> flops;
+	std::function<double(double)> elements;
+	std::function<T(const inputs<T>&)> run;
+	std::vector<unsigned int> sizes = {};
+};
+
+/// <summary>
+///   Creates the kernels. Each returns an element of its result, so that
+///   the work cannot be optimized away.
+/// </summary>
+/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+/// <returns>The kernels.</returns>
+template <typename T>
+std::vector<kernel<T>> make_kernels(void)
+{
+	auto none = [](double) { return 0.0; };
+	auto square = [](double n) { return n * n; };
+	auto three_squares = [](double n) { return 3 * n * n; };
+
+	return {
+		{ "mult", 4096, [](double n) { return 2 * n * n * n; }, three_squares,
+			[](const inputs<T>& in) { return in.A.mult(in.B)[0][0]; } },
+		{ "mult_strassen", 4096, [](double n) { return 2 * n * n * n; }, three_squares,
+			[](const inputs<T>& in) { return in.A.mult(in.B, mult_algorithm::strassen)[0][0]; } },
+		{ "transpose", 8192, none, [](double n) { return 2 * n * n; },
+			[](const inputs<T>& in) { return in.A.transpose()[0][0]; } },
+		{ "add", 8192, square, three_squares,
+			[](const inputs<T>& in) { return (in.A + in.B)[0][0]; } },
+		{ "sub", 8192, square, three_squares,
+			[](const inputs<T>& in) { return (in.A - in.B)[0][0]; } },
+		{ "mul", 8192, square, three_squares,
+			[](const inputs<T>& in) { return (in.A * in.B)[0][0]; } },
+		{ "div", 8192, square, three_squares,
+			[](const inputs<T>& in) { return (in.A / in.S)[0][0]; } },
+		{ "inv", 2048, [](double n) { return 2 * n * n * n; }, [](double n) { return 2 * n * n; },
+			[](const inputs<T>& in) { return in.S.inv()[0][0]; } },
+		{ "inv_shulz", 1024, none, [](double n) { return 2 * n * n; },
+			[](const inputs<T>& in) { return in.S.inv_shulz()[0][0]; } },
+		// Leibniz expansion for n > 3, which takes n! terms
+		{ "det", 8, none, square,
+			[](const inputs<T>& in) { return in.S.det(); }, { 4, 5, 6, 7, 8 } },
+		{ "lu_decomposition", 2048, [](double n) { return 2 * n * n * n / 3; }, three_squares,
+			[](const inputs<T>& in) { mat<T> L, U; in.S.lu_decomposition(L, U); return U[0][0]; } },
+		{ "cholesky_decomposition", 4096, [](double n) { return n * n * n / 3; }, [](double n) { return 2 * n * n; },
+			[](const inputs<T>& in) { mat<T> L; in.S.cholesky_decomposition(L); return L[0][0]; } },
+		{ "spectral_norm", 4096, none, square,
+			[](const inputs<T>& in) { return in.A.spectral_norm(); } }
+	};
+}
+
+/// <summary>
+///   Gets a percentile of sorted samples by the nearest-rank method.
+/// </summary>
+/// <param name="sorted">The samples in ascending order.</param>
+/// <param name="p">The percentile, from 0 to 100.</param>
+/// <returns>The sample at the percentile.</returns>
+double percentile(const std::vector<double>& sorted, double p)
+{
+	std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100 * sorted.size()));
+
+	return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+/// <summary>
+///   Tests whether a list of sizes contains an order.
+/// </summary>
+/// <param name="sizes">The sizes.</param>
+/// <param name="n">The order.</param>
+/// <returns>True if the order is in the list.</returns>
+bool contains(const std::vector<unsigned int>& sizes, unsigned int n)
+{
+	return std::find(sizes.begin(), sizes.end(), n) != sizes.end();
+}
+
+/// <summary>
+///   Times the kernels of one element type over the size sweep, and over
+///   their own default sizes unless sizes are given. A kernel is reported
+///   as skipped at a given size beyond its limit.
+/// </summary>
+/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+/// <param name="type">Name of the element type.</param>
+/// <param name="config">The benchmark settings.</param>
+/// <param name="results">The results, which are appended to.</param>
+template <typename T>
+void run_type(const std::string& type, const settings& config, std::vector<result>& results)
+{
+	std::vector<kernel<T>> kernels = make_kernels<T>();
+	std::mt19937 engine(constants::RNG_SEED);
+	volatile T sink = 0;
+
+	// Sweep the given sizes, or the default sizes with those of the kernels
+	std::vector<unsigned int> sizes = config.sizes;
+	if (!config.sizes_given)
+		for (const kernel<T>& k : kernels)
+			sizes.insert(sizes.end(), k.sizes.begin(), k.sizes.end());
+	std::sort(sizes.begin(), sizes.end());
+	sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+	for (unsigned int n : sizes)
+	{
+		inputs<T> in;
+		in.A = mat<T>::make_randn(n, n, engine);
+		in.B = mat<T>::make_randn(n, n, engine);
+		in.S = in.A.outer_gram();
+		for (unsigned int i = 0; i < n; i++)
+			in.S[i][i] += static_cast<T>(n);
+
+		for (const kernel<T>& k : kernels)
+		{
+			if (!config.kernels.empty() && std::find(config.kernels.begin(), config.kernels.end(), k.name) == config.kernels.end())
+				continue;
+			if (!config.sizes_given && !contains(k.sizes.empty() ? config.sizes : k.sizes, n))
+				continue;
+			if (n > k.max_size)
+			{
+				std::cout << std::left << std::setw(24) << k.name << std::setw(13) << type
+					<< std::right << std::setw(6) << n << "  skipped (n > " << k.max_size << ")\n";
+				continue;
+			}
+
+			// Warm up, then repeat until both minimums are reached
+			std::vector<double> samples;
+			double total = 0;
+			sink = k.run(in);
+			while (samples.size() < config.max_reps && (samples.size() < config.min_reps || total < config.min_time))
+			{
+				auto start = std::chrono::steady_clock::now();
+				sink = k.run(in);
+				double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				samples.push_back(seconds);
+				total += seconds;
+			}
+			std::sort(samples.begin(), samples.end());
+
+			result r;
+			r.kernel = k.name;
+			r.type = type;
+			r.n = n;
+			r.reps = static_cast<unsigned int>(samples.size());
+			r.min = samples.front();
+			r.mean = total / samples.size();
+			r.p50 = percentile(samples, 50);
+			r.p90 = percentile(samples, 90);
+			r.p99 = percentile(samples, 99);
+			r.max = samples.back();
+			r.gflops = k.flops(n) / r.p50 * 1e-9;
+			r.gbytes = k.elements(n) * sizeof(T) / r.p50 * 1e-9;
+			results.push_back(r);
+
+			std::cout << std::left << std::setw(24) << r.kernel << std::setw(13) << r.type
+				<< std::right << std::setw(6) << r.n << std::setw(7) << r.reps << std::fixed << std::setprecision(4)
+				<< std::setw(12) << r.p50 * 1e3 << std::setw(12) << r.p90 * 1e3 << std::setw(12) << r.p99 * 1e3
+				<< std::setprecision(3) << std::setw(10);
+			if (r.gflops > 0)
+				std::cout << r.gflops;
+			else
+				std::cout << "-";
+			std::cout << std::setw(10) << r.gbytes << "\n";
+		}
+	}
+	static_cast<void>(sink);
+}
+
+/// <summary>
+///   Writes the results as JSON.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="results">The results.</param>
+void write_json(const std::string& path, const std::vector<result>& results)
+{
+	std::ofstream file(path);
+
+	file << std::setprecision(9);
+	file << "{\n  \"threads\": " << std::thread::hardware_concurrency() << ",\n  \"results\": [\n";
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		const result& r = results[i];
+		file << "    { \"kernel\": \"" << r.kernel << "\", \"type\": \"" << r.type << "\", \"n\": " << r.n
+			<< ", \"reps\": " << r.reps << ", \"seconds\": { \"min\": " << r.min << ", \"mean\": " << r.mean
+			<< ", \"p50\": " << r.p50 << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99 << ", \"max\": " << r.max
+			<< " }, \"gflops\": " << r.gflops << ", \"gbytes_per_second\": " << r.gbytes << " }"
+			<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	file << "  ]\n}\n";
+
+	if (!file)
+		throw std::runtime_error("Unable to write JSON file.");
+}
+
+/// <summary>
+///   Splits a comma-separated list.
+/// </summary>
+/// <param name="list">The list.</param>
+/// <returns>The items of the list.</returns>
+std::vector<std::string> split(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::stringstream stream(list);
+	std::string item;
+
+	while (std::getline(stream, item, ','))
+		if (!item.empty())
+			items.push_back(item);
+
+	return items;
+}
+
+/// <summary>
+///   Prints the command line options.
+/// </summary>
+void usage(void)
+{
+	std::cout
+		<< "Usage: linmat_bench [options]\n"
+		<< "  --kernel LIST     Kernels to run, comma-separated (default all)\n"
+		<< "  --type LIST       Element types: float,double,long_double (default all)\n"
+		<< "  --sizes LIST      Matrix orders (default 64,128,256,512, and 4-8 for det)\n"
+		<< "  --min-reps N      Minimum repetitions (default 5)\n"
+		<< "  --max-reps N      Maximum repetitions (default 1000)\n"
+		<< "  --min-time S      Minimum total seconds per kernel and size (default 0.2)\n"
+		<< "  --json PATH       Write the results as JSON\n"
+		<< "  --list            List the kernels\n";
+}
+
+int main(int argc, char* argv[])
+{
+	settings config;
+
+	// Parse the command line
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (arg == "--help" || arg == "-h")
+		{
+			usage();
+			return 0;
+		}
+		else if (arg == "--list")
+		{
+			for (const kernel<double>& k : make_kernels<double>())
+				std::cout << k.name << " (n <= " << k.max_size << ")\n";
+			return 0;
+		}
+		else if (arg == "--kernel" && has_value)
+			config.kernels = split(argv[++i]);
+		else if (arg == "--type" && has_value)
+			config.types = split(argv[++i]);
+		else if (arg == "--sizes" && has_value)
+		{
+			config.sizes.clear();
+			config.sizes_given = true;
+			for (const std::string& size : split(argv[++i]))
+				config.sizes.push_back(static_cast<unsigned int>(std::stoul(size)));
+		}
+		else if (arg == "--min-reps" && has_value)
+			config.min_reps = static_cast<unsigned int>(std::stoul(argv[++i]));
+		else if (arg == "--max-reps" && has_value)
+			config.max_reps = static_cast<unsigned int>(std::stoul(argv[++i]));
+		else if (arg == "--min-time" && has_value)
+			config.min_time = std::stod(argv[++i]);
+		else if (arg == "--json" && has_value)
+			config.json = argv[++i];
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+	config.max_reps = std::max(config.max_reps, std::max(config.min_reps, 1u));
+
+	// Run the benchmarks
+	std::vector<result> results;
+	std::cout << std::left << std::setw(24) << "kernel" << std::setw(13) << "type" << std::right << std::setw(6) << "n"
+		<< std::setw(7) << "reps" << std::setw(12) << "p50 ms" << std::setw(12) << "p90 ms" << std::setw(12) << "p99 ms"
+		<< std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s" << "\n";
+	for (const std::string& type : config.types)
+	{
+		if (type == "float")
+			run_type<float>(type, config, results);
+		else if (type == "double")
+			run_type<double>(type, config, results);
+		else if (type == "long_double")
+			run_type<long double>(type, config, results);
+		else
+		{
+			std::cerr << "Unknown type " << type << "\n";
+			return 1;
+		}
+	}
+
+	if (!config.json.empty())
+		write_json(config.json, results);
+
+	return 0;
+}
@@ -96,9 +96,9 @@ int main()
 	std::cout << L.mult(U) << std::endl;
 
 	// Cholesky Decomposition
-	m3.mult(m3.transpose()).cholesky_decomposition(L);
+	m3.outer_gram().cholesky_decomposition(L);
 	std::cout << "The matrix m3.m3 is:" << std::endl;
-	std::cout << m3.mult(m3.transpose()) << std::endl;
+	std::cout << m3.outer_gram() << std::endl;
 	std::cout << "The Cholesky decomposition of m3.m3 is:" << std::endl;
 	std::cout << "L:" << std::endl;
 	std::cout << L << std::endl;
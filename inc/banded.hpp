@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_BANDED_HPP_
+#define LINMAT_BANDED_HPP_
+
+#include <cstddef>
+#include <vector>
+#include "factorization.hpp"
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Square banded matrix with kl diagonals below and ku diagonals above
+	///   the main diagonal, storing only the n(kl+ku+1) entries of the band
+	///   row by row.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class band_mat
+	{
+	public:
+		band_mat(unsigned int n, unsigned int kl, unsigned int ku);
+		band_mat(const mat<T>& m, unsigned int kl, unsigned int ku);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		std::vector<T> mult(const std::vector<T>& x) const;
+		mat<T> solve(const mat<T>& b) const;
+		band_mat<T> transpose(void) const;
+		mat<T> dense(void) const;
+
+		// Accessor methods
+		unsigned int rows() const { return m_n; }
+		unsigned int cols() const { return m_n; }
+		unsigned int lower_bandwidth() const { return m_kl; }
+		unsigned int upper_bandwidth() const { return m_ku; }
+		bool in_band(unsigned int i, unsigned int j) const { return j + m_kl >= i && j <= i + m_ku; }
+		T& operator() (unsigned int i, unsigned int j);
+		T operator() (unsigned int i, unsigned int j) const;
+
+	protected:
+		std::size_t index(unsigned int i, unsigned int j) const
+		{
+			return static_cast<std::size_t>(i) * (m_kl + m_ku + 1) + (j + m_kl - i);
+		}
+
+		unsigned int m_n;
+		unsigned int m_kl;
+		unsigned int m_ku;
+		std::vector<T> m_elements;
+	};
+
+	/// <summary>
+	///   Banded LU factorization with partial pivoting. Pivoting widens the
+	///   upper bandwidth of U to kl+ku, so the work is O(n.kl.(kl+ku)).
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class band_lu_factorization : public factorization<T>
+	{
+	public:
+		band_lu_factorization(const band_mat<T>& A);
+		unsigned int size() const { return m_LU.rows(); }
+
+	protected:
+		mat<T> solve_factor(const mat<T>& b) const;
+		T det_factor() const;
+
+		// Multipliers below the diagonal, and U with upper bandwidth kl+ku
+		band_mat<T> m_LU;
+		std::vector<unsigned int> m_pivots;
+		T m_sign;
+	};
+
+	/// <summary>
+	///   Banded Cholesky factorization of a symmetric positive-definite band
+	///   matrix, A = L.L^T, where L keeps the lower bandwidth of A.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class band_cholesky_factorization : public factorization<T>
+	{
+	public:
+		band_cholesky_factorization(const band_mat<T>& A);
+		unsigned int size() const { return m_L.rows(); }
+
+		// Lower triangular band factor
+		const band_mat<T>& factor() const { return m_L; }
+
+	protected:
+		mat<T> solve_factor(const mat<T>& b) const;
+		T det_factor() const;
+
+		band_mat<T> m_L;
+	};
+
+	// Thomas algorithm for tridiagonal systems
+	template <typename T>
+	std::vector<T> tridiagonal_solve(
+		const std::vector<T>& sub,
+		const std::vector<T>& diag,
+		const std::vector<T>& super,
+		const std::vector<T>& rhs);
+}
+
+#endif
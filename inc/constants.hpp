@@ -24,6 +24,8 @@
 #ifndef LINMAT_CONSTANTS_HPP
 #define LINMAT_CONSTANTS_HPP
 
+#include <cstddef>
+
 namespace linmat
 {
 	namespace constants
@@ -35,6 +37,49 @@ namespace linmat
 		// as tolerance for percentage change in value below which
 		// the algorithm is assumed to have converged.
 		const double CONV_TOL = 1e-12;
+
+		// Default seed for the random number generators used by randomized
+		// methods, so that results are reproducible between runs.
+		const unsigned int RNG_SEED = 5489u;
+
+		// Matrix order above which inv() uses Newton-Schulz iteration in
+		// place of LU factorization. This and the following block sizes and
+		// cutoffs are defaults, which may be replaced by set_tuning().
+		const unsigned int INV_ITERATIVE_THRESHOLD = 1024;
+
+		// Block sizes of the cache-blocked matrix multiplication, as the
+		// number of rows of the left matrix, the inner dimension, and the
+		// number of columns of the right matrix in each block.
+		const unsigned int GEMM_MC = 64;
+		const unsigned int GEMM_KC = 256;
+		const unsigned int GEMM_NC = 1024;
+
+		// Dimension below which Strassen-Winograd multiplication uses the
+		// blocked multiplication, and the recursion depth to which its
+		// seven products are run as parallel tasks.
+		const unsigned int STRASSEN_CUTOFF = 256;
+		const unsigned int STRASSEN_PARALLEL_DEPTH = 2;
+
+		// Order of the tiles of the parallel Cholesky decomposition.
+		const unsigned int CHOLESKY_TILE = 128;
+
+		// Matrix order from which the Cholesky decomposition and Strassen-
+		// Winograd multiplication are split into parallel tasks.
+		const unsigned int PARALLEL_THRESHOLD = 512;
+
+		// Fraction of the matrix order which the total rank of the low-rank
+		// updates of a factorization may reach before it is refactorized.
+		const double REFACTOR_RANK_FRACTION = 0.25;
+
+		// Memory in bytes used for tiles by the out-of-core methods, 
+		// including the tiles being prefetched.
+		const std::size_t OUT_OF_CORE_BUDGET = static_cast<std::size_t>(256) << 20;
+
+		// Number of events kept per thread by the trace ring buffers.
+		const std::size_t TRACE_BUFFER_EVENTS = 65536;
+
+		// Pi to long double precision, for the Fourier transform.
+		const long double PI = 3.14159265358979323846264338327950288L;
 	}
 }
 
@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_FACTORIZATION_HPP_
+#define LINMAT_FACTORIZATION_HPP_
+
+#include <deque>
+#include <vector>
+#include "linear_operator.hpp"
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Factorization interface for solving linear systems A.X = B. Low-rank
+	///   updates of the factorized matrix are applied with the Woodbury
+	///   identity, without refactorizing. Each stored update adds O(n.k) to
+	///   later solves, so factorizations which support it refactorize the 
+	///   updated matrix once the total rank of the updates exceeds a 
+	///   fraction of n.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class factorization
+	{
+	public:
+		factorization();
+		virtual ~factorization() {}
+
+		// Order of the factorized square matrix
+		virtual unsigned int size() const = 0;
+
+		// Solution X of A.X = B for a block of right-hand sides
+		mat<T> solve(const mat<T>& b) const;
+
+		// Determinant of the factorized matrix
+		T det() const;
+
+		// Inverse of the factorized matrix
+		mat<T> inverse() const;
+
+		// Low-rank updates, A = A + U.C.V^T and A = A + u.v^T
+		void woodbury_update(const mat<T>& U, const mat<T>& C, const mat<T>& V);
+		void sherman_morrison_update(const mat<T>& u, const mat<T>& v);
+		unsigned int updates() const { return static_cast<unsigned int>(m_updates.size()); }
+		unsigned int update_rank() const { return m_update_rank; }
+
+		// Factorizes the updated matrix afresh, discarding the stored updates
+		void refactorize();
+
+	protected:
+
+		// Solve and determinant using the factors alone
+		virtual mat<T> solve_factor(const mat<T>& b) const = 0;
+		virtual T det_factor() const = 0;
+
+		// Dense matrix of the factors, and factorization of a new matrix in
+		// place, where refactorization is supported
+		virtual mat<T> dense_factor() const;
+		virtual void factor(const mat<T>& A);
+
+		// Whether updates refactorize automatically past the rank limit
+		virtual bool auto_refactor() const { return false; }
+
+		// Each update stores W = A^-1.U, S^-1 = (C^-1 + V^T.A^-1.U)^-1 and V^T,
+		// and U.C for refactorization
+		struct low_rank_update
+		{
+			mat<T> W;
+			mat<T> S_inv;
+			mat<T> Vt;
+			mat<T> UC;
+		};
+		std::vector<low_rank_update> m_updates;
+		unsigned int m_update_rank;
+
+		// Product of the determinant lemma factors det(S).det(C)
+		T m_det_scale;
+	};
+
+	/// <summary>
+	///   LU factorization with partial pivoting, P.A = L.U.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class lu_factorization : public factorization<T>
+	{
+	public:
+		lu_factorization(const mat<T>& A);
+		unsigned int size() const { return m_LU.rows(); }
+
+		// Unit lower and upper factors stored together, and row permutation
+		const mat<T>& lu() const { return m_LU; }
+		const std::vector<unsigned int>& permutation() const { return m_perm; }
+
+	protected:
+		mat<T> solve_factor(const mat<T>& b) const;
+		T det_factor() const;
+		mat<T> dense_factor() const;
+		void factor(const mat<T>& A);
+		bool auto_refactor() const { return true; }
+
+		mat<T> m_LU;
+		std::vector<unsigned int> m_perm;
+		T m_sign;
+	};
+
+	/// <summary>
+	///   Cholesky factorization of a symmetric positive-definite matrix, 
+	///   A = L.L^T, with O(n^2) rank-1 updates and downdates of the factor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class cholesky_factorization : public factorization<T>
+	{
+	public:
+		cholesky_factorization(const mat<T>& A);
+		unsigned int size() const { return m_L.rows(); }
+
+		// Rank-1 modifications, A = A + x.x^T and A = A - x.x^T
+		void update(const mat<T>& x);
+		void downdate(const mat<T>& x);
+
+		// Lower triangular factor
+		const mat<T>& factor() const { return m_L; }
+
+	protected:
+		mat<T> solve_factor(const mat<T>& b) const;
+		T det_factor() const;
+		mat<T> dense_factor() const;
+		void factor(const mat<T>& A);
+		void rank_one(std::vector<T> x, T sign);
+
+		mat<T> m_L;
+	};
+
+	/// <summary>
+	///   Cholesky factor of the regularized Gram matrix of a sliding window
+	///   of observations, lambda.I + X^T.X, where the rows of X are the most
+	///   recent observations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class cholesky_window
+	{
+	public:
+		cholesky_window(unsigned int n, unsigned int window, T lambda);
+
+		// Adds a 1xn observation, removing the oldest once the window is full
+		void push(const mat<T>& row);
+
+		unsigned int count() const { return static_cast<unsigned int>(m_rows.size()); }
+		const cholesky_factorization<T>& cholesky() const { return m_chol; }
+
+	protected:
+		unsigned int m_window;
+		std::deque<mat<T>> m_rows;
+		cholesky_factorization<T> m_chol;
+	};
+
+	// Low-rank updates of an inverse and its determinant
+	template <typename T>
+	void woodbury_update(mat<T>& A_inv, const mat<T>& U, const mat<T>& C, const mat<T>& V);
+	template <typename T>
+	void woodbury_update(mat<T>& A_inv, T& det, const mat<T>& U, const mat<T>& C, const mat<T>& V);
+	template <typename T>
+	void sherman_morrison_update(mat<T>& A_inv, const mat<T>& u, const mat<T>& v);
+	template <typename T>
+	void sherman_morrison_update(mat<T>& A_inv, T& det, const mat<T>& u, const mat<T>& v);
+
+	// Warm-started inverse tracking
+	template <typename T>
+	solver_result inv_update(
+		const mat<T>& A,
+		mat<T>& X,
+		const solver_options& options = solver_options());
+
+	// Solve factorized in single precision, refined in the precision of T
+	template <typename T>
+	solver_result mixed_precision_solve(
+		const mat<T>& A,
+		const mat<T>& b,
+		mat<T>& x,
+		const solver_options& options = solver_options());
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_HALF_HPP_
+#define LINMAT_HALF_HPP_
+
+#include <cstdint>
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   IEEE 754 half-precision storage type, with 1 sign, 5 exponent and 
+	///   10 mantissa bits. Arithmetic is performed in float, and results are
+	///   rounded to nearest even when stored.
+	/// </summary>
+	class float16
+	{
+	public:
+		float16() : m_bits(0) {}
+		float16(float value);
+		operator float() const;
+
+		// Compound assignment, computed in float
+		float16& operator+=(float value) { return *this = float16(float(*this) + value); }
+		float16& operator-=(float value) { return *this = float16(float(*this) - value); }
+		float16& operator*=(float value) { return *this = float16(float(*this) * value); }
+		float16& operator/=(float value) { return *this = float16(float(*this) / value); }
+
+		// Raw encoding
+		std::uint16_t bits() const { return m_bits; }
+		static float16 from_bits(std::uint16_t bits);
+
+	protected:
+		std::uint16_t m_bits;
+	};
+
+	/// <summary>
+	///   Brain floating-point storage type, with the 8 exponent bits of 
+	///   float and 7 mantissa bits, so that it has the range of float at 
+	///   reduced precision. Arithmetic is performed in float, and results 
+	///   are rounded to nearest even when stored.
+	/// </summary>
+	class bfloat16
+	{
+	public:
+		bfloat16() : m_bits(0) {}
+		bfloat16(float value);
+		operator float() const;
+
+		// Compound assignment, computed in float
+		bfloat16& operator+=(float value) { return *this = bfloat16(float(*this) + value); }
+		bfloat16& operator-=(float value) { return *this = bfloat16(float(*this) - value); }
+		bfloat16& operator*=(float value) { return *this = bfloat16(float(*this) * value); }
+		bfloat16& operator/=(float value) { return *this = bfloat16(float(*this) / value); }
+
+		// Raw encoding
+		std::uint16_t bits() const { return m_bits; }
+		static bfloat16 from_bits(std::uint16_t bits);
+
+	protected:
+		std::uint16_t m_bits;
+	};
+
+	// Multiplication of 16-bit matrices, accumulated in float
+	template <>
+	mat<float16> mat<float16>::mult(const mat<float16>& other) const;
+	template <>
+	mat<bfloat16> mat<bfloat16>::mult(const mat<bfloat16>& other) const;
+
+	// Conversion between 16-bit and float matrices
+	mat<float16> to_float16(const mat<float>& A);
+	mat<bfloat16> to_bfloat16(const mat<float>& A);
+	mat<float> to_float(const mat<float16>& A);
+	mat<float> to_float(const mat<bfloat16>& A);
+}
+
+#endif
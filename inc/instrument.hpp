@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_INSTRUMENT_HPP_
+#define LINMAT_INSTRUMENT_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include "trace.hpp"
+
+namespace linmat
+{
+	namespace instrument
+	{
+		/// <summary>
+		///   Totals for one operation. Time includes nested operations, so 
+		///   for example the time of inv() includes the products it forms.
+		/// </summary>
+		struct op_stats
+		{
+			unsigned long long calls;	// Number of calls
+			unsigned long long flops;	// Floating-point operations, by model
+			unsigned long long bytes;	// Bytes allocated for results
+			double seconds;				// Wall time
+		};
+
+		/// <summary>
+		///   Counters for one operation, updated from any thread.
+		/// </summary>
+		struct counter
+		{
+			std::atomic<unsigned long long> calls;
+			std::atomic<unsigned long long> flops;
+			std::atomic<unsigned long long> bytes;
+			std::atomic<unsigned long long> nanoseconds;
+		};
+
+		/// <summary>
+		///   Counts one call of an operation and times it until the end of
+		///   the enclosing scope.
+		/// </summary>
+		class scope
+		{
+		public:
+			scope(counter& c, unsigned long long flops, unsigned long long bytes)
+				: m_counter(c)
+				, m_start(std::chrono::steady_clock::now())
+			{
+				m_counter.calls.fetch_add(1, std::memory_order_relaxed);
+				m_counter.flops.fetch_add(flops, std::memory_order_relaxed);
+				m_counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+			}
+			scope(const scope&) = delete;
+			scope& operator=(const scope&) = delete;
+			~scope()
+			{
+				std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - m_start;
+				m_counter.nanoseconds.fetch_add(static_cast<unsigned long long>(elapsed.count()), std::memory_order_relaxed);
+			}
+
+		private:
+			counter& m_counter;
+			std::chrono::steady_clock::time_point m_start;
+		};
+
+		// Functions
+		bool enabled(void);
+		counter& counter_for(const char* name);
+		std::map<std::string, op_stats> snapshot(void);
+		void reset(void);
+	}
+}
+
+// Counts a call of the enclosing operation with its modeled flops and the
+// bytes it allocates, and records it as a trace event. Counting is compiled
+// out unless LINMAT_INSTRUMENT is defined, in which case the arguments are
+// not evaluated, and tracing unless LINMAT_TRACE is defined.
+#ifdef LINMAT_INSTRUMENT
+#define LINMAT_COUNT_CALL(name, flops, bytes) \
+	static ::linmat::instrument::counter& linmat_counter_ = ::linmat::instrument::counter_for(name); \
+	::linmat::instrument::scope linmat_scope_(linmat_counter_, \
+		static_cast<unsigned long long>(flops), static_cast<unsigned long long>(bytes))
+#else
+#define LINMAT_COUNT_CALL(name, flops, bytes) static_cast<void>(0)
+#endif
+#define LINMAT_COUNT(name, flops, bytes) LINMAT_COUNT_CALL(name, flops, bytes); LINMAT_TRACE_SCOPE(name)
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_KRYLOV_HPP_
+#define LINMAT_KRYLOV_HPP_
+
+#include <functional>
+#include <vector>
+#include "constants.hpp"
+#include "linear_operator.hpp"
+#include "mat.hpp"
+
+namespace linmat
+{
+	// Matrix-free operator returning the product y = A.x for a column vector x
+	template <typename T>
+	using matvec_fn = std::function<mat<T>(const mat<T>&)>;
+
+	/// <summary>
+	///   Preconditioner interface, applying z = M^-1.r to a column vector.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class preconditioner
+	{
+	public:
+		virtual ~preconditioner() {}
+		virtual mat<T> apply(const mat<T>& r) const = 0;
+	};
+
+	/// <summary>
+	///   Jacobi (diagonal) preconditioner.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class jacobi_preconditioner : public preconditioner<T>
+	{
+	public:
+		jacobi_preconditioner(const mat<T>& A);
+		mat<T> apply(const mat<T>& r) const;
+
+	protected:
+		std::vector<T> m_inv_diag;
+	};
+
+	/// <summary>
+	///   Incomplete Cholesky preconditioner with zero fill-in, IC(0), for 
+	///   symmetric positive-definite matrices.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class ichol_preconditioner : public preconditioner<T>
+	{
+	public:
+		ichol_preconditioner(const mat<T>& A);
+		mat<T> apply(const mat<T>& r) const;
+
+	protected:
+		// Lower triangular factor and the column indices of its non-zeros
+		mat<T> m_L;
+		std::vector<std::vector<unsigned int>> m_pattern;
+	};
+
+	/// <summary>
+	///   Incomplete LU preconditioner with zero fill-in, ILU(0).
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class ilu_preconditioner : public preconditioner<T>
+	{
+	public:
+		ilu_preconditioner(const mat<T>& A);
+		mat<T> apply(const mat<T>& r) const;
+
+	protected:
+		// Unit lower and upper factors stored together, and the column
+		// indices of the non-zeros in each row
+		mat<T> m_LU;
+		std::vector<std::vector<unsigned int>> m_pattern;
+	};
+
+	// Conjugate gradient, for symmetric positive-definite systems
+	template <typename T>
+	solver_result cg(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result cg(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result cg(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+
+	// Minimum residual, for symmetric (possibly indefinite) systems
+	template <typename T>
+	solver_result minres(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result minres(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result minres(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+
+	// Restarted generalized minimum residual, for general systems
+	template <typename T>
+	solver_result gmres(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result gmres(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result gmres(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+
+	// Stabilized bi-conjugate gradient, for general systems
+	template <typename T>
+	solver_result bicgstab(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result bicgstab(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+	template <typename T>
+	solver_result bicgstab(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options = solver_options(), const preconditioner<T>* M = nullptr);
+}
+
+#endif
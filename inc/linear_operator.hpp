@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_LINEAR_OPERATOR_HPP_
+#define LINMAT_LINEAR_OPERATOR_HPP_
+
+#include <functional>
+#include <random>
+#include "constants.hpp"
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Options controlling convergence of the iterative solvers.
+	/// </summary>
+	struct solver_options
+	{
+		// Maximum number of iterations
+		unsigned int max_iter = constants::MAX_ITER;
+
+		// Tolerance on the relative residual ||b - A.x|| / ||b||, or on
+		// the residual ||I - A.X|| for iterative inverses
+		double tol = 1e-10;
+
+		// Krylov subspace dimension between GMRES restarts
+		unsigned int restart = 30;
+	};
+
+	/// <summary>
+	///   Outcome of an iterative solve.
+	/// </summary>
+	struct solver_result
+	{
+		unsigned int iterations = 0;
+		double residual = 0;
+		bool converged = false;
+	};
+
+	/// <summary>
+	///   Linear operator interface, applying a matrix to a block of column
+	///   vectors without requiring the matrix to be stored.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class linear_operator
+	{
+	public:
+		virtual ~linear_operator() {}
+
+		// Dimensions of the operator
+		virtual unsigned int rows() const = 0;
+		virtual unsigned int cols() const = 0;
+
+		// Products A.X and A^T.X for a block of column vectors X
+		virtual mat<T> apply(const mat<T>& x) const = 0;
+		virtual mat<T> apply_transpose(const mat<T>& x) const = 0;
+	};
+
+	/// <summary>
+	///   Operator for a dense matrix. The matrix must outlive the operator.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class dense_operator : public linear_operator<T>
+	{
+	public:
+		dense_operator(const mat<T>& A);
+		unsigned int rows() const { return m_A.rows(); }
+		unsigned int cols() const { return m_A.cols(); }
+		mat<T> apply(const mat<T>& x) const;
+		mat<T> apply_transpose(const mat<T>& x) const;
+
+	protected:
+		const mat<T>& m_A;
+	};
+
+	/// <summary>
+	///   Operator defined by functions returning the products with a column
+	///   vector. Blocks are applied one column at a time.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class function_operator : public linear_operator<T>
+	{
+	public:
+		typedef std::function<mat<T>(const mat<T>&)> function_type;
+
+		function_operator(
+			unsigned int rows,
+			unsigned int cols,
+			const function_type& apply,
+			const function_type& apply_transpose = function_type());
+		unsigned int rows() const { return m_rows; }
+		unsigned int cols() const { return m_cols; }
+		mat<T> apply(const mat<T>& x) const;
+		mat<T> apply_transpose(const mat<T>& x) const;
+
+	protected:
+		unsigned int m_rows, m_cols;
+		function_type m_apply, m_apply_transpose;
+	};
+
+	/// <summary>
+	///   Operator for the symmetric product A^T.A, applied as two products
+	///   with A. The operator A must outlive this operator.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class gram_operator : public linear_operator<T>
+	{
+	public:
+		gram_operator(const linear_operator<T>& A);
+		unsigned int rows() const { return m_A.cols(); }
+		unsigned int cols() const { return m_A.cols(); }
+		mat<T> apply(const mat<T>& x) const;
+		mat<T> apply_transpose(const mat<T>& x) const;
+
+	protected:
+		const linear_operator<T>& m_A;
+	};
+
+	/// <summary>
+	///   Operator for the Kronecker product A (x) B, applied using the 
+	///   identity (A (x) B).vec(X) = vec(A.X.B^T) for row-major vec. The 
+	///   operators A and B must outlive this operator.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class kronecker_operator : public linear_operator<T>
+	{
+	public:
+		kronecker_operator(const linear_operator<T>& A, const linear_operator<T>& B);
+		unsigned int rows() const { return m_A.rows() * m_B.rows(); }
+		unsigned int cols() const { return m_A.cols() * m_B.cols(); }
+		mat<T> apply(const mat<T>& x) const;
+		mat<T> apply_transpose(const mat<T>& x) const;
+
+	protected:
+		const linear_operator<T>& m_A;
+		const linear_operator<T>& m_B;
+	};
+
+	// Iterative routines on operators
+	template <typename T>
+	T power_iteration(
+		const linear_operator<T>& A,
+		mat<T>& v,
+		unsigned int max_iter = constants::MAX_ITER,
+		double tol = constants::CONV_TOL);
+	template <typename T>
+	T spectral_norm(const linear_operator<T>& A, std::mt19937& engine);
+	template <typename T>
+	mat<T> inv_shulz(const linear_operator<T>& A);
+	template <typename T>
+	solver_result inv_hyperpower(
+		const linear_operator<T>& A,
+		mat<T>& X,
+		unsigned int order = 2,
+		const solver_options& options = solver_options());
+}
+
+#endif
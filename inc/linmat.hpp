@@ -28,6 +28,25 @@
 #include "mat.hpp"
 #include "vec.hpp"
 #include "operators.hpp"
+#include "linear_operator.hpp"
+#include "randomized.hpp"
+#include "krylov.hpp"
+#include "factorization.hpp"
+#include "statistics.hpp"
+#include "structured.hpp"
+#include "packed.hpp"
+#include "banded.hpp"
+#include "fft.hpp"
+#include "toeplitz.hpp"
+#include "sparse.hpp"
+#include "scheduler.hpp"
+#include "mapped.hpp"
+#include "out_of_core.hpp"
+#include "text_io.hpp"
+#include "instrument.hpp"
+#include "trace.hpp"
+#include "tuning.hpp"
+#include "half.hpp"
 
 #endif
 
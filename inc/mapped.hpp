@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_MAPPED_HPP_
+#define LINMAT_MAPPED_HPP_
+
+#include <cstdint>
+#include <string>
+#include "mat.hpp"
+
+namespace linmat
+{
+	// Order of the elements in a matrix file
+	enum class storage_layout : std::uint32_t
+	{
+		row_major = 0,
+		col_major = 1
+	};
+
+	// Access to a memory-mapped matrix file
+	enum class map_mode
+	{
+		read_only,		// Mapped pages are read-only
+		copy_on_write,	// Writes go to private copies of the pages
+		read_write		// Writes go to the file
+	};
+
+	/// <summary>
+	///   Header of the binary matrix format. The header is followed by the
+	///   elements, with no padding between rows or columns, starting at an
+	///   offset which is a multiple of the alignment. All fields are in the
+	///   byte order of the writing machine, which is checked with the 
+	///   byte order mark.
+	/// </summary>
+	struct mat_file_header
+	{
+		char magic[8];					// "LINMAT" followed by two nulls
+		std::uint32_t version;			// Format version, currently 1
+		std::uint32_t byte_order;		// 0x01020304 as written
+		std::uint32_t dtype;			// 1 float, 2 double, 3 long double
+		std::uint32_t element_size;		// sizeof of the element type
+		std::uint64_t rows;				// Number of rows
+		std::uint64_t cols;				// Number of columns
+		std::uint32_t layout;			// storage_layout of the elements
+		std::uint32_t alignment;		// Alignment of the element offset
+		std::uint64_t data_offset;		// Offset of the first element
+		std::uint8_t reserved[8];		// Zero
+	};
+
+	/// <summary>
+	///   Matrix stored in a binary matrix file and mapped into memory. The
+	///   elements are accessed in place, without reading or parsing the 
+	///   file, and pages are loaded by the operating system as they are
+	///   first touched.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class mapped_mat
+	{
+	public:
+		// Factory methods
+		static mapped_mat<T> create(
+			const std::string& path,
+			unsigned int rows,
+			unsigned int cols,
+			storage_layout layout = storage_layout::row_major);
+
+		// Constructors
+		explicit mapped_mat(const std::string& path, map_mode mode = map_mode::read_only);
+		mapped_mat(mapped_mat<T>&& other);
+		mapped_mat(const mapped_mat<T>&) = delete;
+		mapped_mat<T>& operator=(const mapped_mat<T>&) = delete;
+		~mapped_mat();
+
+		// Methods
+		T* data(void);
+		const T* data(void) const;
+		mat<T> to_mat(void) const;
+		void flush(void);
+		unsigned int rows(void) const;
+		unsigned int cols(void) const;
+		storage_layout layout(void) const;
+		map_mode mode(void) const;
+
+		// Operators
+		T& operator()(unsigned int row, unsigned int col);
+		const T& operator()(unsigned int row, unsigned int col) const;
+
+	private:
+		// Methods
+		void map(const std::string& path, map_mode mode);
+		void unmap(void);
+
+		void* m_view;
+		std::size_t m_size;
+		T* m_data;
+		unsigned int m_rows;
+		unsigned int m_cols;
+		storage_layout m_layout;
+		map_mode m_mode;
+	};
+
+	// Functions
+	template <typename T>
+	void save_binary(const mat<T>& m, const std::string& path, storage_layout layout = storage_layout::row_major);
+	template <typename T>
+	mat<T> load_binary(const std::string& path);
+}
+
+#endif
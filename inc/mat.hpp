@@ -25,10 +25,26 @@
 #define LINMAT_MAT_HPP_
 #include <iostream>
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
 
 namespace linmat
 {
+	// Structured matrix types
+	template <typename T> class diag_mat;
+	template <typename T> class identity;
+	template <typename T> class perm_mat;
+	template <typename T> class const_mat;
+	template <typename T> class tri_mat;
+
+	// Matrix multiplication algorithms
+	enum class mult_algorithm
+	{
+		blocked,	// Cache-blocked multiplication, O(n^3)
+		strassen	// Strassen-Winograd recursion, O(n^2.81)
+	};
+
 	/// <summary>
 	///		Real-valued matrix.
 	/// </summary>
@@ -44,35 +60,55 @@ namespace linmat
 		static mat<T> make_ones(unsigned int rows, unsigned int cols);
 		static mat<T> make_zeros(unsigned int rows, unsigned int cols);
 		static mat<T> make_eye(unsigned int rows, unsigned int cols);
+		static mat<T> make_randn(unsigned int rows, unsigned int cols, std::mt19937& engine);
 
 		// Constructors
 		mat();
 		mat(unsigned int rows, unsigned int cols);
 		mat(std::initializer_list<std::initializer_list<T>> args);
+		explicit mat(const std::string& path);
 
 		// Methods
-		T det_2(void);
-		T det_3(void);
-		mat<T> inv(void);
-		mat<T> inv_2(void);
-		mat<T> inv_3(void);
-		mat<T> inv_shulz(void);
-		mat<T> mult(const mat<T>& other);
-		mat<T> pow(unsigned int n);
-		mat<T> transpose(void);
-		T frobenius_norm(void);
-		T spectral_norm(void);
-		T trace(void);
+		T det_2(void) const;
+		T det_3(void) const;
+		mat<T> inv(void) const;
+		mat<T> inv_2(void) const;
+		mat<T> inv_3(void) const;
+		mat<T> inv_shulz(void) const;
+		mat<T> inv_hyperpower(unsigned int order) const;
+		mat<T> inv_update(const mat<T>& prev_inverse) const;
+		mat<T> mult(const mat<T>& other) const;
+		mat<T> mult(const mat<T>& other, mult_algorithm algorithm) const;
+		mat<T> mult_strassen(const mat<T>& other, unsigned int cutoff) const;
+		mat<T> mult(const diag_mat<T>& other) const;
+		mat<T> mult(const identity<T>& other) const;
+		mat<T> mult(const perm_mat<T>& other) const;
+		mat<T> mult(const const_mat<T>& other) const;
+		mat<T> pow(unsigned int n) const;
+		mat<T> transpose(void) const;
+		mat<T> gram(void) const;
+		mat<T> outer_gram(void) const;
+		T frobenius_norm(void) const;
+		T norm_1(void) const;
+		T norm_inf(void) const;
+		T spectral_norm(void) const;
+		T spectral_norm(std::mt19937& engine) const;
+		T trace(void) const;
 		void permutations(
 			unsigned int k,
 			std::vector<unsigned int>& p,
 			std::vector<std::vector<unsigned int>>& ps,
 			std::vector<T>& ss,
-			T& s);
-		T det_leibniz(void);
-		T det(void);
-		void lu_decomposition(mat<T>& L, mat<T>& U);
-		void cholesky_decomposition(mat<T>& L);
+			T& s) const;
+		T det_leibniz(void) const;
+		T det(void) const;
+		void lu_decomposition(mat<T>& L, mat<T>& U) const;
+		void lu_decomposition(tri_mat<T>& L, tri_mat<T>& U) const;
+		void cholesky_decomposition(mat<T>& L) const;
+		void cholesky_decomposition(tri_mat<T>& L) const;
+		void cholesky_decomposition_tiled(mat<T>& L, unsigned int tile) const;
+		void qr_decomposition(mat<T>& Q, mat<T>& R) const;
+		void svd(mat<T>& U, mat<T>& S, mat<T>& V) const;
 
 		// Accessor methods
 		unsigned int rows() const { return m_rows; }
@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_OUT_OF_CORE_HPP_
+#define LINMAT_OUT_OF_CORE_HPP_
+
+#include <cstddef>
+#include "constants.hpp"
+#include "mapped.hpp"
+
+namespace linmat
+{
+	// Functions
+	template <typename T>
+	void mult_out_of_core(
+		const mapped_mat<T>& A,
+		const mapped_mat<T>& B,
+		mapped_mat<T>& C,
+		std::size_t memory_budget = constants::OUT_OF_CORE_BUDGET);
+	template <typename T>
+	void lu_decomposition_out_of_core(
+		const mapped_mat<T>& A,
+		mapped_mat<T>& L,
+		mapped_mat<T>& U,
+		std::size_t memory_budget = constants::OUT_OF_CORE_BUDGET);
+	template <typename T>
+	void cholesky_decomposition_out_of_core(
+		const mapped_mat<T>& A,
+		mapped_mat<T>& L,
+		std::size_t memory_budget = constants::OUT_OF_CORE_BUDGET);
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_PACKED_HPP_
+#define LINMAT_PACKED_HPP_
+
+#include <cstddef>
+#include <vector>
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Triangular matrix in packed storage, holding the n(n+1)/2 entries of
+	///   the triangle row by row.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class tri_mat
+	{
+	public:
+		tri_mat(unsigned int n, bool lower = true);
+		tri_mat(const mat<T>& m, bool lower = true);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		mat<T> solve(const mat<T>& b) const;
+		tri_mat<T> transpose(void) const;
+		T det(void) const;
+		T frobenius_norm(void) const;
+		T norm_1(void) const;
+		T norm_inf(void) const;
+		mat<T> dense(void) const;
+
+		// Accessor methods
+		unsigned int rows() const { return m_n; }
+		unsigned int cols() const { return m_n; }
+		bool lower() const { return m_lower; }
+		T& operator() (unsigned int i, unsigned int j);
+		T operator() (unsigned int i, unsigned int j) const;
+
+	protected:
+		bool in_triangle(unsigned int i, unsigned int j) const { return m_lower ? j <= i : j >= i; }
+		std::size_t index(unsigned int i, unsigned int j) const;
+
+		unsigned int m_n;
+		bool m_lower;
+		std::vector<T> m_elements;
+	};
+
+	/// <summary>
+	///   Symmetric matrix in packed storage, holding the n(n+1)/2 entries of
+	///   the lower triangle row by row.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class sym_mat
+	{
+	public:
+		sym_mat(unsigned int n);
+		sym_mat(const mat<T>& m);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		mat<T> solve(const mat<T>& b) const;
+		void cholesky_decomposition(tri_mat<T>& L) const;
+		T trace(void) const;
+		T frobenius_norm(void) const;
+		T norm_1(void) const;
+		T norm_inf(void) const;
+		mat<T> dense(void) const;
+
+		// Accessor methods
+		unsigned int rows() const { return m_n; }
+		unsigned int cols() const { return m_n; }
+		T& operator() (unsigned int i, unsigned int j);
+		const T& operator() (unsigned int i, unsigned int j) const;
+
+	protected:
+		static std::size_t index(unsigned int i, unsigned int j);
+
+		unsigned int m_n;
+		std::vector<T> m_elements;
+	};
+}
+
+#endif
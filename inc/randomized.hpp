@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_RANDOMIZED_HPP_
+#define LINMAT_RANDOMIZED_HPP_
+
+#include "constants.hpp"
+#include "linear_operator.hpp"
+#include "mat.hpp"
+
+namespace linmat
+{
+	// Randomized range finder and low-rank approximation
+	template <typename T>
+	mat<T> randomized_range_finder(
+		const mat<T>& A,
+		unsigned int l,
+		unsigned int power_iters = 2,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	mat<T> randomized_range_finder(
+		const linear_operator<T>& A,
+		unsigned int l,
+		unsigned int power_iters = 2,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	void randomized_svd(
+		const mat<T>& A,
+		unsigned int k,
+		mat<T>& U,
+		mat<T>& S,
+		mat<T>& V,
+		unsigned int oversampling = 10,
+		unsigned int power_iters = 2,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	void randomized_svd(
+		const linear_operator<T>& A,
+		unsigned int k,
+		mat<T>& U,
+		mat<T>& S,
+		mat<T>& V,
+		unsigned int oversampling = 10,
+		unsigned int power_iters = 2,
+		unsigned int seed = constants::RNG_SEED);
+
+	// Randomized estimators
+	template <typename T>
+	T estimate_spectral_norm(
+		const mat<T>& A,
+		unsigned int max_iter = 50,
+		double tol = 1e-6,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	T estimate_spectral_norm(
+		const linear_operator<T>& A,
+		unsigned int max_iter = 50,
+		double tol = 1e-6,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	T estimate_trace(
+		const mat<T>& A,
+		unsigned int samples = 32,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	T estimate_trace(
+		const linear_operator<T>& A,
+		unsigned int samples = 32,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	T estimate_condition_number(
+		const mat<T>& A,
+		unsigned int max_iter = 200,
+		double tol = 1e-6,
+		unsigned int seed = constants::RNG_SEED);
+	template <typename T>
+	T estimate_condition_number(
+		const linear_operator<T>& A,
+		unsigned int max_iter = 200,
+		double tol = 1e-6,
+		unsigned int seed = constants::RNG_SEED);
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_SCHEDULER_HPP_
+#define LINMAT_SCHEDULER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace linmat
+{
+	/// <summary>
+	///   Work-stealing task scheduler. Each worker thread owns a deque of 
+	///   tasks, taking the most recently spawned task from the back of its
+	///   own deque, and stealing the oldest task from the front of another 
+	///   worker's deque when its own is empty. Recursive algorithms then run
+	///   depth-first on each thread while idle threads take the largest
+	///   remaining subproblems.
+	/// </summary>
+	class task_scheduler
+	{
+	public:
+		// Constructors
+		explicit task_scheduler(unsigned int threads = 0);
+		task_scheduler(const task_scheduler&) = delete;
+		task_scheduler& operator=(const task_scheduler&) = delete;
+		~task_scheduler();
+
+		// Methods
+		static task_scheduler& instance(void);
+		void submit(std::function<void()> task);
+		bool run_one(void);
+		unsigned int threads(void) const;
+
+	private:
+		// Deque of tasks owned by one worker thread
+		struct worker
+		{
+			std::deque<std::function<void()>> tasks;
+			std::mutex lock;
+		};
+
+		// Methods
+		bool pop(unsigned int index, std::function<void()>& task);
+		bool steal(unsigned int thief, std::function<void()>& task);
+		void work(unsigned int index);
+
+		std::vector<std::unique_ptr<worker>> m_workers;
+		std::vector<std::thread> m_threads;
+		std::atomic<unsigned int> m_queued;
+		std::atomic<unsigned int> m_next;
+		std::mutex m_sleep_lock;
+		std::condition_variable m_wake;
+		bool m_stop;
+	};
+
+	/// <summary>
+	///   Group of tasks forked onto a scheduler and joined with wait(). The
+	///   waiting thread runs queued tasks until the group completes, so 
+	///   groups may be nested within tasks. The first exception thrown by a
+	///   task is rethrown from wait().
+	/// </summary>
+	class task_group
+	{
+	public:
+		// Constructors
+		explicit task_group(task_scheduler& scheduler = task_scheduler::instance());
+		task_group(const task_group&) = delete;
+		task_group& operator=(const task_group&) = delete;
+		~task_group();
+
+		// Methods
+		void run(std::function<void()> task);
+		void wait(void);
+
+	private:
+		task_scheduler& m_scheduler;
+		std::atomic<unsigned int> m_pending;
+		std::exception_ptr m_error;
+		std::mutex m_error_lock;
+	};
+
+	/// <summary>
+	///   Directed acyclic graph of tasks. Each task is started on the 
+	///   scheduler as soon as all the tasks it depends on have completed.
+	/// </summary>
+	class task_graph
+	{
+	public:
+		// Constructors
+		explicit task_graph(task_scheduler& scheduler = task_scheduler::instance());
+
+		// Methods
+		unsigned int add(std::function<void()> task, const std::vector<unsigned int>& dependencies = {});
+		void run(void);
+		unsigned int size(void) const;
+
+	private:
+		// Task and the tasks waiting on it
+		struct node
+		{
+			std::function<void()> task;
+			std::vector<unsigned int> successors;
+			unsigned int dependencies;
+			std::atomic<unsigned int> remaining;
+		};
+
+		// Methods
+		void start(task_group& group, unsigned int index);
+
+		task_scheduler& m_scheduler;
+		std::vector<std::unique_ptr<node>> m_nodes;
+	};
+}
+
+#endif
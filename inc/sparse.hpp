@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_SPARSE_HPP_
+#define LINMAT_SPARSE_HPP_
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "factorization.hpp"
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Sparse matrix in compressed sparse row (CSR) storage, with the
+	///   column indices of each row sorted.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class sparse_mat
+	{
+	public:
+		// Factory methods
+		static sparse_mat<T> from_triplets(
+			unsigned int rows,
+			unsigned int cols,
+			const std::vector<unsigned int>& row_indices,
+			const std::vector<unsigned int>& col_indices,
+			const std::vector<T>& values);
+
+		// Constructors
+		sparse_mat(unsigned int rows, unsigned int cols);
+		sparse_mat(const mat<T>& m);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		std::vector<T> mult(const std::vector<T>& x) const;
+		sparse_mat<T> transpose(void) const;
+		mat<T> dense(void) const;
+
+		// Accessor methods
+		unsigned int rows() const { return m_rows; }
+		unsigned int cols() const { return m_cols; }
+		unsigned int nnz() const { return static_cast<unsigned int>(m_values.size()); }
+		const std::vector<unsigned int>& row_ptr() const { return m_row_ptr; }
+		const std::vector<unsigned int>& col_idx() const { return m_col_idx; }
+		const std::vector<T>& values() const { return m_values; }
+		T operator() (unsigned int i, unsigned int j) const;
+
+	protected:
+		unsigned int m_rows;
+		unsigned int m_cols;
+		std::vector<unsigned int> m_row_ptr;
+		std::vector<unsigned int> m_col_idx;
+		std::vector<T> m_values;
+	};
+
+	/// <summary>
+	///   Ordering and symbolic analysis for the sparse Cholesky factorization
+	///   of a symmetric matrix. It depends only on the sparsity pattern, so 
+	///   it can be reused for every matrix with the same pattern.
+	/// </summary>
+	class sparse_cholesky_analysis
+	{
+	public:
+		sparse_cholesky_analysis(
+			unsigned int n,
+			const std::vector<unsigned int>& row_ptr,
+			const std::vector<unsigned int>& col_idx);
+		template <typename T>
+		sparse_cholesky_analysis(const sparse_mat<T>& A)
+			: sparse_cholesky_analysis(A.rows(), A.row_ptr(), A.col_idx())
+		{
+			if (A.rows() != A.cols())
+				throw std::runtime_error("Cholesky decomposition is undefined for a rectangular matrix.");
+		}
+
+		// Fill-reducing ordering, where pivot k is row perm[k] of A
+		unsigned int size() const { return m_n; }
+		const std::vector<unsigned int>& permutation() const { return m_perm; }
+		const std::vector<unsigned int>& inverse_permutation() const { return m_inv_perm; }
+
+		// Elimination tree of the permuted matrix, with n marking a root
+		const std::vector<unsigned int>& etree() const { return m_parent; }
+
+		// Number of entries in the factor, including the diagonal
+		unsigned long long factor_nnz() const { return m_factor_nnz; }
+
+		// Supernodes, each a range of columns sharing one row structure
+		unsigned int supernodes() const { return static_cast<unsigned int>(m_first.size()) - 1; }
+		unsigned int first_column(unsigned int s) const { return m_first[s]; }
+		unsigned int columns(unsigned int s) const { return m_first[s + 1] - m_first[s]; }
+		const std::vector<unsigned int>& row_structure(unsigned int s) const { return m_rows[s]; }
+
+		// Supernodes which update supernode s, and the independent levels
+		const std::vector<unsigned int>& updaters(unsigned int s) const { return m_updaters[s]; }
+		const std::vector<std::vector<unsigned int>>& levels() const { return m_levels; }
+
+	protected:
+		unsigned int m_n;
+		std::vector<unsigned int> m_perm;
+		std::vector<unsigned int> m_inv_perm;
+		std::vector<unsigned int> m_parent;
+		unsigned long long m_factor_nnz;
+		std::vector<unsigned int> m_first;
+		std::vector<std::vector<unsigned int>> m_rows;
+		std::vector<std::vector<unsigned int>> m_updaters;
+		std::vector<std::vector<unsigned int>> m_levels;
+	};
+
+	/// <summary>
+	///   Supernodal sparse Cholesky factorization, P.A.P^T = L.L^T, of a
+	///   symmetric positive-definite sparse matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class sparse_cholesky_factorization : public factorization<T>
+	{
+	public:
+		sparse_cholesky_factorization(const sparse_mat<T>& A, unsigned int threads = 0);
+		sparse_cholesky_factorization(
+			const sparse_mat<T>& A,
+			std::shared_ptr<const sparse_cholesky_analysis> analysis,
+			unsigned int threads = 0);
+		unsigned int size() const { return m_analysis->size(); }
+
+		// Symbolic analysis, which may be reused for the same pattern
+		std::shared_ptr<const sparse_cholesky_analysis> analysis() const { return m_analysis; }
+
+	protected:
+		mat<T> solve_factor(const mat<T>& b) const;
+		T det_factor() const;
+		void factorize(const sparse_mat<T>& A, unsigned int threads);
+		void factorize_supernode(
+			unsigned int s,
+			const std::vector<std::vector<std::pair<unsigned int, T>>>& columns,
+			std::vector<unsigned int>& map);
+
+		std::shared_ptr<const sparse_cholesky_analysis> m_analysis;
+
+		// Dense column-major block of each supernode, over its row structure
+		std::vector<std::vector<T>> m_blocks;
+	};
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_STATISTICS_HPP_
+#define LINMAT_STATISTICS_HPP_
+
+#include <vector>
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Streaming accumulator for the Gram and covariance matrices of a data
+	///   matrix which is presented as blocks of rows, so the full data matrix
+	///   is never held in memory.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class gram_accumulator
+	{
+	public:
+		gram_accumulator(unsigned int cols);
+
+		// Accumulate a block of rows, or the state of another accumulator
+		void add(const mat<T>& block);
+		void merge(const gram_accumulator<T>& other);
+
+		// Statistics of the rows accumulated so far
+		unsigned long long count() const { return m_count; }
+		mat<T> mean() const;
+		mat<T> gram() const;
+		mat<T> covariance() const;
+
+	protected:
+		unsigned int m_cols;
+		unsigned long long m_count;
+		std::vector<T> m_mean;
+
+		// Sum of the outer products of the centered rows
+		mat<T> m_comoment;
+	};
+}
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_STRUCTURED_HPP_
+#define LINMAT_STRUCTURED_HPP_
+
+#include <initializer_list>
+#include <vector>
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Square diagonal matrix, storing only the n diagonal entries.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class diag_mat
+	{
+	public:
+		diag_mat(unsigned int n);
+		diag_mat(const std::vector<T>& diagonal);
+		diag_mat(const std::initializer_list<T>& args);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		diag_mat<T> mult(const diag_mat<T>& other) const;
+		diag_mat<T> inv(void) const;
+		T det(void) const;
+		T trace(void) const;
+		mat<T> dense(void) const;
+		void add_to(mat<T>& m, T alpha) const;
+
+		// Accessor methods
+		unsigned int rows() const { return static_cast<unsigned int>(m_diag.size()); }
+		unsigned int cols() const { return static_cast<unsigned int>(m_diag.size()); }
+		T& operator[] (unsigned int i) { return m_diag[i]; }
+		const T& operator[] (unsigned int i) const { return m_diag[i]; }
+
+	protected:
+		std::vector<T> m_diag;
+	};
+
+	/// <summary>
+	///   Scaled nxn identity matrix alpha.I, storing only the scale.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class identity
+	{
+	public:
+		identity(unsigned int n, T alpha = 1);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		identity<T> inv(void) const;
+		T det(void) const;
+		T trace(void) const;
+		mat<T> dense(void) const;
+		void add_to(mat<T>& m, T alpha) const;
+
+		// Accessor methods
+		unsigned int rows() const { return m_n; }
+		unsigned int cols() const { return m_n; }
+		T scale() const { return m_alpha; }
+
+	protected:
+		unsigned int m_n;
+		T m_alpha;
+	};
+
+	/// <summary>
+	///   Permutation matrix, storing the column of the unit entry in each row,
+	///   so that row i of P.A is row p[i] of A.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class perm_mat
+	{
+	public:
+		perm_mat(unsigned int n);
+		perm_mat(const std::vector<unsigned int>& perm);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		perm_mat<T> mult(const perm_mat<T>& other) const;
+		perm_mat<T> inv(void) const;
+		perm_mat<T> transpose(void) const;
+		T det(void) const;
+		mat<T> dense(void) const;
+		void add_to(mat<T>& m, T alpha) const;
+
+		// Accessor methods
+		unsigned int rows() const { return static_cast<unsigned int>(m_perm.size()); }
+		unsigned int cols() const { return static_cast<unsigned int>(m_perm.size()); }
+		const std::vector<unsigned int>& permutation() const { return m_perm; }
+
+	protected:
+		std::vector<unsigned int> m_perm;
+	};
+
+	/// <summary>
+	///   Matrix with every entry equal to a single value, such as the matrix
+	///   of ones, storing only the dimensions and the value.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class const_mat
+	{
+	public:
+		const_mat(unsigned int rows, unsigned int cols, T value = 1);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		const_mat<T> transpose(void) const;
+		mat<T> dense(void) const;
+		void add_to(mat<T>& m, T alpha) const;
+
+		// Accessor methods
+		unsigned int rows() const { return m_rows; }
+		unsigned int cols() const { return m_cols; }
+		T value() const { return m_value; }
+
+	protected:
+		unsigned int m_rows;
+		unsigned int m_cols;
+		T m_value;
+	};
+
+	// Scaling by a scalar
+	template <typename T>
+	diag_mat<T> operator*(const diag_mat<T>& lhs, const T& rhs);
+	template <typename T>
+	diag_mat<T> operator*(const T& lhs, const diag_mat<T>& rhs);
+	template <typename T>
+	identity<T> operator*(const identity<T>& lhs, const T& rhs);
+	template <typename T>
+	identity<T> operator*(const T& lhs, const identity<T>& rhs);
+	template <typename T>
+	const_mat<T> operator*(const const_mat<T>& lhs, const T& rhs);
+	template <typename T>
+	const_mat<T> operator*(const T& lhs, const const_mat<T>& rhs);
+
+	// Addition and subtraction with dense matrices
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const diag_mat<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const diag_mat<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const diag_mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const diag_mat<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const identity<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const identity<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const identity<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const identity<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const perm_mat<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const perm_mat<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const perm_mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const perm_mat<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const const_mat<T>& rhs);
+	template <typename T>
+	mat<T> operator+(const const_mat<T>& lhs, const mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const const_mat<T>& rhs);
+	template <typename T>
+	mat<T> operator-(const const_mat<T>& lhs, const mat<T>& rhs);
+}
+
+#endif
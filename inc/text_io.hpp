@@ -0,0 +1,46 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_TEXT_IO_HPP_
+#define LINMAT_TEXT_IO_HPP_
+
+#include <string>
+#include "mat.hpp"
+#include "sparse.hpp"
+
+namespace linmat
+{
+	// Functions
+	template <typename T>
+	mat<T> read_csv(const std::string& path, char delimiter = ',');
+	template <typename T>
+	void write_csv(const mat<T>& m, const std::string& path, char delimiter = ',');
+	template <typename T>
+	sparse_mat<T> read_matrix_market(const std::string& path);
+	template <typename T>
+	void write_matrix_market(const sparse_mat<T>& m, const std::string& path);
+	template <typename T>
+	void write_matrix_market(const mat<T>& m, const std::string& path);
+}
+
+#endif
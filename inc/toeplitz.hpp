@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_TOEPLITZ_HPP_
+#define LINMAT_TOEPLITZ_HPP_
+
+#include <complex>
+#include <vector>
+#include "mat.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Circulant matrix defined by its first column c, with entries 
+	///   C[i][j] = c[(i - j) mod n]. Products and solves use the Fourier 
+	///   transform, which diagonalizes every circulant matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class circulant_mat
+	{
+	public:
+		circulant_mat(const std::vector<T>& first_col);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		std::vector<T> mult(const std::vector<T>& x) const;
+		mat<T> solve(const mat<T>& b) const;
+		std::vector<T> solve(const std::vector<T>& b) const;
+		mat<T> dense(void) const;
+
+		// Accessor methods
+		unsigned int rows() const { return static_cast<unsigned int>(m_col.size()); }
+		unsigned int cols() const { return static_cast<unsigned int>(m_col.size()); }
+		const std::vector<std::complex<T>>& eigenvalues() const { return m_eigenvalues; }
+		T operator() (unsigned int i, unsigned int j) const;
+
+	protected:
+		std::vector<T> m_col;
+		std::vector<std::complex<T>> m_eigenvalues;
+	};
+
+	/// <summary>
+	///   Toeplitz matrix defined by its first column c and first row r, with
+	///   entries T[i][j] = c[i - j] for i >= j and r[j - i] otherwise. 
+	///   Products embed the matrix in a circulant matrix of at least m+n-1
+	///   rows and use the Fourier transform.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	class toeplitz_mat
+	{
+	public:
+		toeplitz_mat(const std::vector<T>& first_col, const std::vector<T>& first_row);
+
+		// Methods
+		mat<T> mult(const mat<T>& other) const;
+		std::vector<T> mult(const std::vector<T>& x) const;
+		mat<T> solve(const mat<T>& b) const;
+		std::vector<T> solve(const std::vector<T>& b) const;
+		mat<T> dense(void) const;
+
+		// Accessor methods
+		unsigned int rows() const { return static_cast<unsigned int>(m_col.size()); }
+		unsigned int cols() const { return static_cast<unsigned int>(m_row.size()); }
+		T operator() (unsigned int i, unsigned int j) const;
+
+	protected:
+		std::vector<T> m_col;
+		std::vector<T> m_row;
+
+		// Transform of the first column of the circulant embedding
+		std::vector<std::complex<T>> m_embedding;
+	};
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_TRACE_HPP_
+#define LINMAT_TRACE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace linmat
+{
+	namespace trace
+	{
+		/// <summary>
+		///   Timed event, with an optional argument such as the iteration.
+		/// </summary>
+		struct event
+		{
+			const char* name;			// Name, which must be a string literal
+			std::uint64_t start;		// Start in nanoseconds since the trace epoch
+			std::uint64_t duration;		// Duration in nanoseconds
+			long long arg;				// Argument, or negative for none
+		};
+
+		// Functions
+		bool enabled(void);
+		std::uint64_t now(void);
+		void record(const char* name, std::uint64_t start, std::uint64_t end, long long arg);
+		void dump(const std::string& path);
+		void clear(void);
+
+		/// <summary>
+		///   Records an event spanning the enclosing scope.
+		/// </summary>
+		class span
+		{
+		public:
+			explicit span(const char* name, long long arg = -1)
+				: m_name(name)
+				, m_arg(arg)
+				, m_start(now())
+			{
+			}
+			span(const span&) = delete;
+			span& operator=(const span&) = delete;
+			~span()
+			{
+				record(m_name, m_start, now(), m_arg);
+			}
+
+		private:
+			const char* m_name;
+			long long m_arg;
+			std::uint64_t m_start;
+		};
+	}
+}
+
+// Records the enclosing scope, or one iteration of a loop, as a trace 
+// event. Compiled out unless LINMAT_TRACE is defined.
+#ifdef LINMAT_TRACE
+#define LINMAT_TRACE_SCOPE(name) ::linmat::trace::span linmat_trace_span_(name)
+#define LINMAT_TRACE_ITERATION(name, i) ::linmat::trace::span linmat_trace_iteration_(name, static_cast<long long>(i))
+#else
+#define LINMAT_TRACE_SCOPE(name) static_cast<void>(0)
+#define LINMAT_TRACE_ITERATION(name, i) static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#ifndef LINMAT_TUNING_HPP_
+#define LINMAT_TUNING_HPP_
+
+#include <string>
+
+namespace linmat
+{
+	/// <summary>
+	///   Block sizes and algorithm cutoffs which depend on the host. The 
+	///   defaults are given in constants.hpp.
+	/// </summary>
+	struct tuning_params
+	{
+		unsigned int gemm_mc;					// Rows of the left matrix per block
+		unsigned int gemm_kc;					// Inner dimension per block
+		unsigned int gemm_nc;					// Columns of the right matrix per block
+		unsigned int strassen_cutoff;			// Order below which Strassen uses blocked products
+		unsigned int cholesky_tile;				// Order of the tiles of the parallel Cholesky
+		unsigned int parallel_threshold;		// Order from which work is split into parallel tasks
+		unsigned int inv_iterative_threshold;	// Order above which inv() iterates
+	};
+
+	// Functions
+	tuning_params default_tuning(void);
+	tuning_params tuning(void);
+	void set_tuning(const tuning_params& params);
+	tuning_params autotune(unsigned int order = 256);
+	tuning_params load_tuning(const std::string& path);
+	void save_tuning(const tuning_params& params, const std::string& path);
+	tuning_params load_or_autotune(const std::string& path, unsigned int order = 256);
+}
+
+#endif
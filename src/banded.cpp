@@ -0,0 +1,470 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "../inc/banded.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Banded matrix class constructor, with all entries zeroed.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of rows and columns.</param>
+	/// <param name="kl">Number of diagonals below the main diagonal.</param>
+	/// <param name="ku">Number of diagonals above the main diagonal.</param>
+	template <typename T>
+	band_mat<T>::band_mat(unsigned int n, unsigned int kl, unsigned int ku)
+		: m_n(n)
+		, m_kl(kl)
+		, m_ku(ku)
+		, m_elements(static_cast<std::size_t>(n) * (kl + ku + 1))
+	{
+	}
+
+	/// <summary>
+	///   Banded matrix class constructor from the band of a dense matrix. 
+	///   Entries outside the band are ignored.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The square dense matrix.</param>
+	/// <param name="kl">Number of diagonals below the main diagonal.</param>
+	/// <param name="ku">Number of diagonals above the main diagonal.</param>
+	template <typename T>
+	band_mat<T>::band_mat(const mat<T>& m, unsigned int kl, unsigned int ku)
+		: band_mat(m.rows(), kl, ku)
+	{
+		if (m.rows() != m.cols())
+			throw std::runtime_error("Banded matrix must be square.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = (i > kl ? i - kl : 0); j <= i + ku && j < m_n; j++)
+				m_elements[index(i, j)] = m[i][j];
+	}
+
+	/// <summary>
+	///   Subscript operator for an entry of the band.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A reference to the entry.</returns>
+	template <typename T>
+	T& band_mat<T>::operator() (unsigned int i, unsigned int j)
+	{
+		if (!in_band(i, j))
+			throw std::runtime_error("Entry is outside the band.");
+
+		return m_elements[index(i, j)];
+	}
+
+	/// <summary>
+	///   Subscript operator for constant operand, returning zero outside the
+	///   band.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A scalar value.</returns>
+	template <typename T>
+	T band_mat<T>::operator() (unsigned int i, unsigned int j) const
+	{
+		return in_band(i, j) ? m_elements[index(i, j)] : 0;
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the banded matrix in 
+	///   O(n.(kl+ku+1).k) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> band_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(m_n, other.cols());
+
+		// Validate arguments
+		if (m_n != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int k = (i > m_kl ? i - m_kl : 0); k <= i + m_ku && k < m_n; k++)
+			{
+				T a = m_elements[index(i, k)];
+				for (unsigned int j = 0; j < other.cols(); j++)
+					result[i][j] += a * other[k][j];
+			}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies a vector by the banded matrix in O(n.(kl+ku+1)) 
+	///   operations, without the per-row storage of a column vector.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The vector operand.</param>
+	/// <returns>A new vector which is the product.</returns>
+	template <typename T>
+	std::vector<T> band_mat<T>::mult(const std::vector<T>& x) const
+	{
+		std::vector<T> result(m_n);
+
+		// Validate arguments
+		if (x.size() != m_n)
+			throw std::runtime_error("Vector length must match columns in matrix.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+		{
+			T s = 0;
+			for (unsigned int k = (i > m_kl ? i - m_kl : 0); k <= i + m_ku && k < m_n; k++)
+				s += m_elements[index(i, k)] * x[k];
+			result[i] = s;
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves A.X = B using banded LU factorization with partial pivoting.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> band_mat<T>::solve(const mat<T>& b) const
+	{
+		return band_lu_factorization<T>(*this).solve(b);
+	}
+
+	/// <summary>
+	///   Calculates the transpose, exchanging the lower and upper bandwidths.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new banded matrix which is the transpose.</returns>
+	template <typename T>
+	band_mat<T> band_mat<T>::transpose(void) const
+	{
+		band_mat<T> result(m_n, m_ku, m_kl);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = (i > m_kl ? i - m_kl : 0); j <= i + m_ku && j < m_n; j++)
+				result.m_elements[result.index(j, i)] = m_elements[index(i, j)];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> band_mat<T>::dense(void) const
+	{
+		mat<T> result(m_n, m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = (i > m_kl ? i - m_kl : 0); j <= i + m_ku && j < m_n; j++)
+				result[i][j] = m_elements[index(i, j)];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Performs banded LU factorization with partial pivoting. Row swaps 
+	///   are recorded as a sequence of pivots, and the multipliers of each 
+	///   step are stored below the diagonal in the rows they were applied to.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The banded matrix to factorize.</param>
+	template <typename T>
+	band_lu_factorization<T>::band_lu_factorization(const band_mat<T>& A)
+		: m_LU(A.rows(), A.lower_bandwidth(), A.lower_bandwidth() + A.upper_bandwidth())
+		, m_pivots(A.rows())
+		, m_sign(1)
+	{
+		unsigned int n = A.rows();
+		unsigned int kl = A.lower_bandwidth();
+		unsigned int ku = m_LU.upper_bandwidth();
+
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = (i > kl ? i - kl : 0); j <= i + A.upper_bandwidth() && j < n; j++)
+				m_LU(i, j) = A(i, j);
+
+		for (unsigned int k = 0; k < n; k++)
+		{
+			unsigned int last_row = std::min(n - 1, k + kl);
+			unsigned int last_col = std::min(n - 1, k + ku);
+
+			// Find the pivot row within the band
+			unsigned int p = k;
+			for (unsigned int i = k + 1; i <= last_row; i++)
+				if (std::fabs(m_LU(i, k)) > std::fabs(m_LU(p, k)))
+					p = i;
+			if (m_LU(p, k) == 0)
+				throw std::runtime_error("Matrix is singular.");
+
+			// Swap the remainder of the rows
+			m_pivots[k] = p;
+			if (p != k)
+			{
+				for (unsigned int j = k; j <= last_col; j++)
+					std::swap(m_LU(k, j), m_LU(p, j));
+				m_sign = -m_sign;
+			}
+
+			// Eliminate below the pivot
+			for (unsigned int i = k + 1; i <= last_row; i++)
+			{
+				T l = m_LU(i, k) / m_LU(k, k);
+				m_LU(i, k) = l;
+				for (unsigned int j = k + 1; j <= last_col; j++)
+					m_LU(i, j) -= l * m_LU(k, j);
+			}
+		}
+	}
+
+	/// <summary>
+	///   Solves A.X = B by applying the pivots and multipliers in order, 
+	///   then back substitution with the banded U.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> band_lu_factorization<T>::solve_factor(const mat<T>& b) const
+	{
+		unsigned int n = size();
+		unsigned int kl = m_LU.lower_bandwidth();
+		unsigned int ku = m_LU.upper_bandwidth();
+		mat<T> x(b);
+
+		// Validate arguments
+		if (b.rows() != n)
+			throw std::runtime_error("Rows in right-hand side must match the factorized matrix.");
+
+		// Apply the row swaps and elimination steps
+		for (unsigned int k = 0; k < n; k++)
+		{
+			if (m_pivots[k] != k)
+				std::swap(x[k], x[m_pivots[k]]);
+			for (unsigned int i = k + 1; i <= k + kl && i < n; i++)
+			{
+				T l = m_LU(i, k);
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= l * x[k][j];
+			}
+		}
+
+		// Solve U.X = Y
+		for (unsigned int i = n; i-- > 0;)
+		{
+			for (unsigned int k = i + 1; k <= i + ku && k < n; k++)
+			{
+				T u = m_LU(i, k);
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= u * x[k][j];
+			}
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= m_LU(i, i);
+		}
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the signed product of the pivots.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T band_lu_factorization<T>::det_factor() const
+	{
+		T result = m_sign;
+
+		for (unsigned int i = 0; i < size(); i++)
+			result *= m_LU(i, i);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Performs the banded Cholesky factorization of a symmetric 
+	///   positive-definite band matrix, using its lower band.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The banded matrix to factorize.</param>
+	template <typename T>
+	band_cholesky_factorization<T>::band_cholesky_factorization(const band_mat<T>& A)
+		: m_L(A.rows(), A.lower_bandwidth(), 0)
+	{
+		unsigned int n = A.rows();
+		unsigned int p = A.lower_bandwidth();
+
+		if (A.upper_bandwidth() != p)
+			throw std::runtime_error("Matrix must be symmetric.");
+
+		for (unsigned int i = 0; i < n; i++)
+		{
+			unsigned int first = i > p ? i - p : 0;
+			for (unsigned int j = first; j <= i; j++)
+			{
+				T s = A(i, j);
+				for (unsigned int k = std::max(first, j > p ? j - p : 0); k < j; k++)
+					s -= m_L(i, k) * m_L(j, k);
+				if (i == j)
+				{
+					if (!(s > 0))
+						throw std::runtime_error("Matrix must be positive-definite.");
+					m_L(i, i) = std::sqrt(s);
+				}
+				else
+					m_L(i, j) = s / m_L(j, j);
+			}
+		}
+	}
+
+	/// <summary>
+	///   Solves A.X = B by forward and back substitution with the band 
+	///   factors L and L^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> band_cholesky_factorization<T>::solve_factor(const mat<T>& b) const
+	{
+		unsigned int n = size();
+		unsigned int p = m_L.lower_bandwidth();
+		mat<T> x(b);
+
+		// Validate arguments
+		if (b.rows() != n)
+			throw std::runtime_error("Rows in right-hand side must match the factorized matrix.");
+
+		// Solve L.Y = B
+		for (unsigned int i = 0; i < n; i++)
+		{
+			for (unsigned int k = (i > p ? i - p : 0); k < i; k++)
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= m_L(i, k) * x[k][j];
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= m_L(i, i);
+		}
+
+		// Solve L^T.X = Y
+		for (unsigned int i = n; i-- > 0;)
+		{
+			for (unsigned int k = i + 1; k <= i + p && k < n; k++)
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= m_L(k, i) * x[k][j];
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= m_L(i, i);
+		}
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the squared product of the diagonal
+	///   of the factor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T band_cholesky_factorization<T>::det_factor() const
+	{
+		T result = 1;
+
+		for (unsigned int i = 0; i < size(); i++)
+			result *= m_L(i, i) * m_L(i, i);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves a tridiagonal system in O(n) operations with the Thomas 
+	///   algorithm. No pivoting is performed, so the matrix should be 
+	///   diagonally dominant or symmetric positive-definite; otherwise use
+	///   band_lu_factorization.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="sub">The n-1 entries below the diagonal.</param>
+	/// <param name="diag">The n entries of the diagonal.</param>
+	/// <param name="super">The n-1 entries above the diagonal.</param>
+	/// <param name="rhs">The n entries of the right-hand side.</param>
+	/// <returns>A new vector which is the solution.</returns>
+	template <typename T>
+	std::vector<T> tridiagonal_solve(
+		const std::vector<T>& sub,
+		const std::vector<T>& diag,
+		const std::vector<T>& super,
+		const std::vector<T>& rhs)
+	{
+		std::size_t n = diag.size();
+		std::vector<T> c(n), x(n);
+
+		// Validate arguments
+		if (n == 0 || sub.size() != n - 1 || super.size() != n - 1 || rhs.size() != n)
+			throw std::runtime_error("Tridiagonal system must have n-1, n, n-1 and n entries.");
+
+		// Forward sweep
+		T d = diag[0];
+		if (d == 0)
+			throw std::runtime_error("Zero pivot in tridiagonal system.");
+		c[0] = n > 1 ? super[0] / d : 0;
+		x[0] = rhs[0] / d;
+		for (std::size_t i = 1; i < n; i++)
+		{
+			d = diag[i] - sub[i - 1] * c[i - 1];
+			if (d == 0)
+				throw std::runtime_error("Zero pivot in tridiagonal system.");
+			c[i] = i + 1 < n ? super[i] / d : 0;
+			x[i] = (rhs[i] - sub[i - 1] * x[i - 1]) / d;
+		}
+
+		// Back substitution
+		for (std::size_t i = n - 1; i-- > 0;)
+			x[i] -= c[i] * x[i + 1];
+
+		return x;
+	}
+
+	// Explicit template instantiations
+	template class band_mat<float>;
+	template class band_mat<double>;
+	template class band_mat<long double>;
+	template class band_lu_factorization<float>;
+	template class band_lu_factorization<double>;
+	template class band_lu_factorization<long double>;
+	template class band_cholesky_factorization<float>;
+	template class band_cholesky_factorization<double>;
+	template class band_cholesky_factorization<long double>;
+	template std::vector<float> tridiagonal_solve(const std::vector<float>& sub, const std::vector<float>& diag, const std::vector<float>& super, const std::vector<float>& rhs);
+	template std::vector<double> tridiagonal_solve(const std::vector<double>& sub, const std::vector<double>& diag, const std::vector<double>& super, const std::vector<double>& rhs);
+	template std::vector<long double> tridiagonal_solve(const std::vector<long double>& sub, const std::vector<long double>& diag, const std::vector<long double>& super, const std::vector<long double>& rhs);
+}
@@ -0,0 +1,928 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "../inc/factorization.hpp"
+#include "../inc/operators.hpp"
+#include "../inc/structured.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Factorization base class constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	factorization<T>::factorization()
+		: m_update_rank(0)
+		, m_det_scale(1)
+	{
+	}
+
+	/// <summary>
+	///   Solves A.X = B, applying the stored low-rank updates to the solution
+	///   from the factors in order.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> factorization<T>::solve(const mat<T>& b) const
+	{
+		mat<T> x = solve_factor(b);
+
+		// Each update gives (A + U.C.V^T)^-1 = A^-1 - W.S^-1.V^T.A^-1
+		for (const low_rank_update& update : m_updates)
+			x = x - update.W.mult(update.S_inv.mult(update.Vt.mult(x)));
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the determinant of the factorized matrix, including the
+	///   stored low-rank updates.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T factorization<T>::det() const
+	{
+		return det_factor() * m_det_scale;
+	}
+
+	/// <summary>
+	///   Calculates the inverse of the factorized matrix by solving for the
+	///   columns of the identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new matrix which is the inverse.</returns>
+	template <typename T>
+	mat<T> factorization<T>::inverse() const
+	{
+		return solve(mat<T>::make_eye(size(), size()));
+	}
+
+	/// <summary>
+	///   Updates the factorized matrix to A + U.C.V^T with the Woodbury 
+	///   identity in O(n^2.k) operations, where k is the rank of the update.
+	///   The determinant is updated with the matrix determinant lemma, 
+	///   det(A + U.C.V^T) = det(C^-1 + V^T.A^-1.U).det(C).det(A). Stored 
+	///   updates cost O(n.k) each in later solves, so a factorization which
+	///   supports it is refactorized in O(n^3) once the total rank exceeds
+	///   REFACTOR_RANK_FRACTION of n, keeping the amortized cost O(n^2.k).
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="U">An nxk matrix.</param>
+	/// <param name="C">A non-singular kxk matrix.</param>
+	/// <param name="V">An nxk matrix.</param>
+	template <typename T>
+	void factorization<T>::woodbury_update(const mat<T>& U, const mat<T>& C, const mat<T>& V)
+	{
+		low_rank_update update;
+
+		// Validate arguments
+		if (U.rows() != size() || V.rows() != size() || U.cols() != V.cols()
+			|| C.rows() != U.cols() || C.cols() != U.cols())
+			throw std::runtime_error("Update dimensions must be nxk, kxk and nxk.");
+
+		// Capacitance matrix S = C^-1 + V^T.A^-1.U
+		lu_factorization<T> C_lu(C);
+		update.W = solve(U);
+		update.Vt = V.transpose();
+		mat<T> S = C_lu.inverse() + update.Vt.mult(update.W);
+
+		// A singular capacitance matrix means the update is singular
+		lu_factorization<T> S_lu(S);
+		update.S_inv = S_lu.inverse();
+		update.UC = U.mult(C);
+		m_det_scale *= S_lu.det() * C_lu.det();
+		m_updates.push_back(update);
+		m_update_rank += U.cols();
+
+		// Replay of the updates in solves now costs as much as the factors
+		if (auto_refactor() && m_update_rank > constants::REFACTOR_RANK_FRACTION * size())
+			refactorize();
+	}
+
+	/// <summary>
+	///   Factorizes the updated matrix A + sum(U.C.V^T) afresh in O(n^3) 
+	///   operations, and discards the stored updates, so that later solves
+	///   cost only the solve with the factors. The factorization is left 
+	///   unchanged if this fails, as when a Cholesky factorization has been
+	///   updated to a matrix which is not positive-definite.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	void factorization<T>::refactorize()
+	{
+		if (m_updates.empty())
+			return;
+
+		mat<T> A = dense_factor();
+		for (const low_rank_update& update : m_updates)
+			A = A + update.UC.mult(update.Vt);
+
+		factor(A);
+		m_updates.clear();
+		m_update_rank = 0;
+		m_det_scale = 1;
+	}
+
+	/// <summary>
+	///   Reconstructs the factorized matrix from its factors. Factorizations
+	///   which do not support refactorization throw.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new matrix which is the product of the factors.</returns>
+	template <typename T>
+	mat<T> factorization<T>::dense_factor() const
+	{
+		throw std::runtime_error("Refactorization is not supported by this factorization.");
+	}
+
+	/// <summary>
+	///   Replaces the factors with those of a new matrix. Factorizations 
+	///   which do not support refactorization throw.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix to factorize.</param>
+	template <typename T>
+	void factorization<T>::factor(const mat<T>& A)
+	{
+		static_cast<void>(A);
+		throw std::runtime_error("Refactorization is not supported by this factorization.");
+	}
+
+	/// <summary>
+	///   Updates the factorized matrix to A + u.v^T with the Sherman-Morrison
+	///   formula in O(n^2) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="u">An nx1 column vector.</param>
+	/// <param name="v">An nx1 column vector.</param>
+	template <typename T>
+	void factorization<T>::sherman_morrison_update(const mat<T>& u, const mat<T>& v)
+	{
+		woodbury_update(u, mat<T>::make_eye(1, 1), v);
+	}
+
+	/// <summary>
+	///   Performs LU factorization with partial pivoting using Gaussian
+	///   elimination, choosing the largest pivot in each column.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix to factorize.</param>
+	template <typename T>
+	lu_factorization<T>::lu_factorization(const mat<T>& A)
+		: m_LU(A)
+		, m_perm(A.rows())
+		, m_sign(1)
+	{
+		unsigned int n = A.rows();
+
+		// Enforce square matrix
+		if (A.rows() != A.cols())
+			throw std::runtime_error("LU decomposition is undefined for a rectangular matrix.");
+
+		for (unsigned int i = 0; i < n; i++)
+			m_perm[i] = i;
+
+		for (unsigned int k = 0; k < n; k++)
+		{
+			// Find the pivot row
+			unsigned int p = k;
+			for (unsigned int i = k + 1; i < n; i++)
+				if (std::fabs(m_LU[i][k]) > std::fabs(m_LU[p][k]))
+					p = i;
+			if (m_LU[p][k] == 0)
+				throw std::runtime_error("Matrix is singular.");
+
+			// Swap rows
+			if (p != k)
+			{
+				std::swap(m_LU[p], m_LU[k]);
+				std::swap(m_perm[p], m_perm[k]);
+				m_sign = -m_sign;
+			}
+
+			// Eliminate below the pivot
+			for (unsigned int i = k + 1; i < n; i++)
+			{
+				T l = m_LU[i][k] / m_LU[k][k];
+				m_LU[i][k] = l;
+				for (unsigned int j = k + 1; j < n; j++)
+					m_LU[i][j] -= l * m_LU[k][j];
+			}
+		}
+	}
+
+	/// <summary>
+	///   Solves A.X = B by forward and back substitution.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> lu_factorization<T>::solve_factor(const mat<T>& b) const
+	{
+		unsigned int n = size();
+		mat<T> x(n, b.cols());
+
+		// Validate arguments
+		if (b.rows() != n)
+			throw std::runtime_error("Rows in right-hand side must match the factorized matrix.");
+
+		// Apply the row permutation
+		for (unsigned int i = 0; i < n; i++)
+			x[i] = b[m_perm[i]];
+
+		// Solve L.Y = P.B with unit diagonal L
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int k = 0; k < i; k++)
+			{
+				T l = m_LU[i][k];
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= l * x[k][j];
+			}
+
+		// Solve U.X = Y
+		for (unsigned int i = n; i-- > 0;)
+		{
+			for (unsigned int k = i + 1; k < n; k++)
+			{
+				T u = m_LU[i][k];
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= u * x[k][j];
+			}
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= m_LU[i][i];
+		}
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the signed product of the pivots.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T lu_factorization<T>::det_factor() const
+	{
+		T result = m_sign;
+
+		for (unsigned int i = 0; i < size(); i++)
+			result *= m_LU[i][i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Reconstructs the factorized matrix as P^T.L.U.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new matrix which is the product of the factors.</returns>
+	template <typename T>
+	mat<T> lu_factorization<T>::dense_factor() const
+	{
+		unsigned int n = size();
+		mat<T> L = mat<T>::make_eye(n, n), U(n, n), result(n, n);
+
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j < n; j++)
+				(j < i ? L[i][j] : U[i][j]) = m_LU[i][j];
+
+		mat<T> LU = L.mult(U);
+		for (unsigned int i = 0; i < n; i++)
+			result[m_perm[i]] = LU[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Replaces the factors with those of a new matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix to factorize.</param>
+	template <typename T>
+	void lu_factorization<T>::factor(const mat<T>& A)
+	{
+		lu_factorization<T> lu(A);
+
+		std::swap(m_LU, lu.m_LU);
+		std::swap(m_perm, lu.m_perm);
+		m_sign = lu.m_sign;
+	}
+
+	/// <summary>
+	///   Performs the Cholesky factorization of a symmetric positive-definite
+	///   matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The symmetric positive-definite matrix to factorize.</param>
+	template <typename T>
+	cholesky_factorization<T>::cholesky_factorization(const mat<T>& A)
+		: m_L(mat<T>::make_zeros(A.rows(), A.cols()))
+	{
+		unsigned int n = A.rows();
+
+		// Enforce square matrix
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Cholesky decomposition is undefined for a rectangular matrix.");
+
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				T s = A[i][j];
+				for (unsigned int k = 0; k < j; k++)
+					s -= m_L[i][k] * m_L[j][k];
+				if (i == j)
+				{
+					if (!(s > 0))
+						throw std::runtime_error("Matrix must be positive-definite.");
+					m_L[i][i] = std::sqrt(s);
+				}
+				else
+					m_L[i][j] = s / m_L[j][j];
+			}
+	}
+
+	/// <summary>
+	///   Updates the factor to that of A + x.x^T in O(n^2) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">An nx1 column vector.</param>
+	template <typename T>
+	void cholesky_factorization<T>::update(const mat<T>& x)
+	{
+		std::vector<T> v(size());
+
+		if (x.rows() != size() || x.cols() != 1)
+			throw std::runtime_error("Update vector must be an nx1 column vector.");
+
+		for (unsigned int i = 0; i < size(); i++)
+			v[i] = x[i][0];
+		rank_one(v, 1);
+	}
+
+	/// <summary>
+	///   Downdates the factor to that of A - x.x^T in O(n^2) operations. The
+	///   downdated matrix must remain positive-definite.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">An nx1 column vector.</param>
+	template <typename T>
+	void cholesky_factorization<T>::downdate(const mat<T>& x)
+	{
+		std::vector<T> v(size());
+
+		if (x.rows() != size() || x.cols() != 1)
+			throw std::runtime_error("Downdate vector must be an nx1 column vector.");
+
+		for (unsigned int i = 0; i < size(); i++)
+			v[i] = x[i][0];
+		rank_one(v, -1);
+	}
+
+	/// <summary>
+	///   Applies the rank-1 modification A + sign.x.x^T to the factor one 
+	///   column at a time, using a hyperbolic rotation for the downdate. The
+	///   rotations are applied to a copy of the factor, which replaces it 
+	///   only on success, so the factor is unchanged if the modified matrix
+	///   is not positive-definite.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The modification vector, used as workspace.</param>
+	/// <param name="sign">Either 1 for an update or -1 for a downdate.</param>
+	template <typename T>
+	void cholesky_factorization<T>::rank_one(std::vector<T> x, T sign)
+	{
+		unsigned int n = size();
+
+		// The stored Woodbury updates would no longer match the factor
+		if (this->updates() > 0)
+			throw std::runtime_error("Factor cannot be modified after a low-rank update.");
+
+		mat<T> L(m_L);
+		for (unsigned int k = 0; k < n; k++)
+		{
+			T d = L[k][k];
+			T r2 = d * d + sign * x[k] * x[k];
+			if (!(r2 > 0))
+				throw std::runtime_error("Matrix must be positive-definite.");
+
+			T r = std::sqrt(r2);
+			T c = r / d;
+			T s = x[k] / d;
+			L[k][k] = r;
+			for (unsigned int i = k + 1; i < n; i++)
+			{
+				L[i][k] = (L[i][k] + sign * s * x[i]) / c;
+				x[i] = c * x[i] - s * L[i][k];
+			}
+		}
+		std::swap(m_L, L);
+	}
+
+	/// <summary>
+	///   Solves A.X = B by forward and back substitution with L and L^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> cholesky_factorization<T>::solve_factor(const mat<T>& b) const
+	{
+		unsigned int n = size();
+		mat<T> x(b);
+
+		// Validate arguments
+		if (b.rows() != n)
+			throw std::runtime_error("Rows in right-hand side must match the factorized matrix.");
+
+		// Solve L.Y = B
+		for (unsigned int i = 0; i < n; i++)
+		{
+			for (unsigned int k = 0; k < i; k++)
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= m_L[i][k] * x[k][j];
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= m_L[i][i];
+		}
+
+		// Solve L^T.X = Y
+		for (unsigned int i = n; i-- > 0;)
+		{
+			for (unsigned int k = i + 1; k < n; k++)
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= m_L[k][i] * x[k][j];
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= m_L[i][i];
+		}
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the squared product of the diagonal
+	///   of the factor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T cholesky_factorization<T>::det_factor() const
+	{
+		T result = 1;
+
+		for (unsigned int i = 0; i < size(); i++)
+			result *= m_L[i][i] * m_L[i][i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Reconstructs the factorized matrix as L.L^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new matrix which is the product of the factors.</returns>
+	template <typename T>
+	mat<T> cholesky_factorization<T>::dense_factor() const
+	{
+		return m_L.outer_gram();
+	}
+
+	/// <summary>
+	///   Replaces the factor with that of a new symmetric positive-definite
+	///   matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix to factorize.</param>
+	template <typename T>
+	void cholesky_factorization<T>::factor(const mat<T>& A)
+	{
+		cholesky_factorization<T> chol(A);
+
+		std::swap(m_L, chol.m_L);
+	}
+
+	/// <summary>
+	///   Sliding window Cholesky factor constructor. The regularization 
+	///   keeps the Gram matrix positive-definite while the window fills.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of columns in each observation.</param>
+	/// <param name="window">Maximum number of observations in the window.</param>
+	/// <param name="lambda">Positive regularization added to the diagonal.</param>
+	template <typename T>
+	cholesky_window<T>::cholesky_window(unsigned int n, unsigned int window, T lambda)
+		: m_window(window)
+		, m_chol(mat<T>::make_eye(n, n) * lambda)
+	{
+		if (window < 1)
+			throw std::runtime_error("Window must contain at least one observation.");
+	}
+
+	/// <summary>
+	///   Adds an observation to the window with a rank-1 update, then removes
+	///   the oldest observation with a rank-1 downdate once the window is full.
+	///   If the downdate fails, the window and its factor are left as they 
+	///   were before the call.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="row">A 1xn observation.</param>
+	template <typename T>
+	void cholesky_window<T>::push(const mat<T>& row)
+	{
+		if (row.rows() != 1 || row.cols() != m_chol.size())
+			throw std::runtime_error("Observation must be a 1xn row vector.");
+
+		// Update before downdating, so the factor remains positive-definite
+		if (m_rows.size() < m_window)
+			m_chol.update(row.transpose());
+		else
+		{
+			cholesky_factorization<T> chol(m_chol);
+			chol.update(row.transpose());
+			chol.downdate(m_rows.front().transpose());
+			m_chol = chol;
+			m_rows.pop_front();
+		}
+		m_rows.push_back(row);
+	}
+
+	/// <summary>
+	///   Updates the inverse of A to the inverse of A + U.C.V^T with the 
+	///   Woodbury identity in O(n^2.k) operations, where k is the rank of
+	///   the update.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A_inv">The inverse of A, overwritten with the updated inverse.</param>
+	/// <param name="U">An nxk matrix.</param>
+	/// <param name="C">A non-singular kxk matrix.</param>
+	/// <param name="V">An nxk matrix.</param>
+	template <typename T>
+	void woodbury_update(mat<T>& A_inv, const mat<T>& U, const mat<T>& C, const mat<T>& V)
+	{
+		T det = 1;
+		woodbury_update(A_inv, det, U, C, V);
+	}
+
+	/// <summary>
+	///   Updates the inverse and determinant of A to those of A + U.C.V^T,
+	///   using the Woodbury identity and the matrix determinant lemma.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A_inv">The inverse of A, overwritten with the updated inverse.</param>
+	/// <param name="det">The determinant of A, overwritten with the updated determinant.</param>
+	/// <param name="U">An nxk matrix.</param>
+	/// <param name="C">A non-singular kxk matrix.</param>
+	/// <param name="V">An nxk matrix.</param>
+	template <typename T>
+	void woodbury_update(mat<T>& A_inv, T& det, const mat<T>& U, const mat<T>& C, const mat<T>& V)
+	{
+		unsigned int n = A_inv.rows();
+
+		// Validate arguments
+		if (A_inv.cols() != n || U.rows() != n || V.rows() != n || U.cols() != V.cols()
+			|| C.rows() != U.cols() || C.cols() != U.cols())
+			throw std::runtime_error("Update dimensions must be nxk, kxk and nxk.");
+
+		// Capacitance matrix S = C^-1 + V^T.A^-1.U
+		lu_factorization<T> C_lu(C);
+		mat<T> W = A_inv.mult(U);
+		mat<T> Z = V.transpose().mult(A_inv);
+		mat<T> S = C_lu.inverse() + Z.mult(U);
+		lu_factorization<T> S_lu(S);
+
+		// (A + U.C.V^T)^-1 = A^-1 - A^-1.U.S^-1.V^T.A^-1
+		A_inv = A_inv - W.mult(S_lu.solve(Z));
+		det *= S_lu.det() * C_lu.det();
+	}
+
+	/// <summary>
+	///   Updates the inverse of A to the inverse of A + u.v^T with the 
+	///   Sherman-Morrison formula in O(n^2) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A_inv">The inverse of A, overwritten with the updated inverse.</param>
+	/// <param name="u">An nx1 column vector.</param>
+	/// <param name="v">An nx1 column vector.</param>
+	template <typename T>
+	void sherman_morrison_update(mat<T>& A_inv, const mat<T>& u, const mat<T>& v)
+	{
+		T det = 1;
+		sherman_morrison_update(A_inv, det, u, v);
+	}
+
+	/// <summary>
+	///   Updates the inverse and determinant of A to those of A + u.v^T, 
+	///   using det(A + u.v^T) = (1 + v^T.A^-1.u).det(A).
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A_inv">The inverse of A, overwritten with the updated inverse.</param>
+	/// <param name="det">The determinant of A, overwritten with the updated determinant.</param>
+	/// <param name="u">An nx1 column vector.</param>
+	/// <param name="v">An nx1 column vector.</param>
+	template <typename T>
+	void sherman_morrison_update(mat<T>& A_inv, T& det, const mat<T>& u, const mat<T>& v)
+	{
+		unsigned int n = A_inv.rows();
+
+		// Validate arguments
+		if (A_inv.cols() != n || u.rows() != n || v.rows() != n || u.cols() != 1 || v.cols() != 1)
+			throw std::runtime_error("Update vectors must be nx1 column vectors.");
+
+		// w = A^-1.u and z^T = v^T.A^-1
+		std::vector<T> w(n), z(n);
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j < n; j++)
+			{
+				w[i] += A_inv[i][j] * u[j][0];
+				z[j] += v[i][0] * A_inv[i][j];
+			}
+
+		T s = 1;
+		for (unsigned int i = 0; i < n; i++)
+			s += v[i][0] * w[i];
+		if (s == 0)
+			throw std::runtime_error("Matrix is singular.");
+
+		// (A + u.v^T)^-1 = A^-1 - w.z^T / (1 + v^T.w)
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j < n; j++)
+				A_inv[i][j] -= w[i] * z[j] / s;
+		det *= s;
+	}
+
+	/// <summary>
+	///   Updates the inverse X of a slowly varying matrix A in place, warm 
+	///   starting Newton-Schulz iteration from the previous inverse. If the
+	///   previous inverse is too far from the new one for the iteration to
+	///   converge, or the iteration fails, the inverse is recomputed with
+	///   LU factorization. The direct inverse is reported as converged when 
+	///   ||I - A.X|| is within the tolerance or n.eps.||A||.||X||, the error
+	///   attainable in the element type.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix.</param>
+	/// <param name="X">The previous inverse, overwritten with the new inverse.</param>
+	/// <param name="options">Iteration limit and tolerance on ||I - A.X||.</param>
+	/// <returns>The iteration count, residual norm and convergence flag. The
+	///   iteration count is zero if the direct method was used.</returns>
+	template <typename T>
+	solver_result inv_update(
+		const mat<T>& A,
+		mat<T>& X,
+		const solver_options& options)
+	{
+		unsigned int n = A.rows();
+		solver_result result;
+
+		// Enforce square matrix
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Inverse is undefined for a rectangular matrix.");
+
+		// Newton-Schulz converges from X when ||I - A.X|| < 1, and otherwise
+		// stops on the first step that does not reduce the residual
+		if (X.rows() == n && X.cols() == n)
+		{
+			mat<T> X_1 = X;
+			result = inv_hyperpower<T>(dense_operator<T>(A), X_1, 2, options);
+			if (result.converged)
+			{
+				X = X_1;
+				return result;
+			}
+		}
+
+		// Fall back to the direct method
+		X = lu_factorization<T>(A).inverse();
+		result.iterations = 0;
+		result.residual = static_cast<double>((identity<T>(n) - A.mult(X)).frobenius_norm());
+		double attainable = n * static_cast<double>(std::numeric_limits<T>::epsilon())
+			* static_cast<double>(A.frobenius_norm()) * static_cast<double>(X.frobenius_norm());
+		result.converged = result.residual <= std::max(options.tol, attainable);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Copies a matrix with its elements converted to another type.
+	/// </summary>
+	/// <typeparam name="U">Element type of the copy.</typeparam>
+	/// <typeparam name="T">Element type of the matrix.</typeparam>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A new matrix which is the copy.</returns>
+	template <typename U, typename T>
+	static mat<U> convert(const mat<T>& A)
+	{
+		mat<U> result(A.rows(), A.cols());
+
+		for (unsigned int i = 0; i < A.rows(); i++)
+			for (unsigned int j = 0; j < A.cols(); j++)
+			{
+				result[i][j] = static_cast<U>(A[i][j]);
+				if (!std::isfinite(result[i][j]) && std::isfinite(A[i][j]))
+					throw std::runtime_error("Matrix elements are out of range of float.");
+			}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Finds the largest magnitude element in each column of a matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A row vector of the column maxima.</returns>
+	template <typename T>
+	static mat<T> column_max_abs(const mat<T>& A)
+	{
+		mat<T> result(1, A.cols());
+
+		for (unsigned int i = 0; i < A.rows(); i++)
+			for (unsigned int j = 0; j < A.cols(); j++)
+				result[0][j] = std::max(result[0][j], std::fabs(A[i][j]));
+
+		return result;
+	}
+
+	/// <summary>
+	///   Tests whether every column of the residual r = b - A.x is within 
+	///   bound.||x|| in the infinity norm, where bound is scaled by ||A||.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="r">The residual.</param>
+	/// <param name="x">The solution.</param>
+	/// <param name="bound">The relative bound, including ||A||.</param>
+	/// <returns>True if every column is within the bound.</returns>
+	template <typename T>
+	static bool residual_within(const mat<T>& r, const mat<T>& x, T bound)
+	{
+		mat<T> r_max = column_max_abs(r), x_max = column_max_abs(x);
+
+		for (unsigned int j = 0; j < r.cols(); j++)
+			if (!(r_max[0][j] <= bound * x_max[0][j]))
+				return false;
+
+		return true;
+	}
+
+	/// <summary>
+	///   Solves A.x = b by LU factorization in single precision, which takes
+	///   half the memory traffic of the working precision, then refines the 
+	///   solution with residuals b - A.x computed in the precision of T. Each
+	///   refinement step solves for the correction with the single-precision
+	///   factors, with each column of the residual scaled to unit maximum so
+	///   that small residuals do not underflow in single precision. As in 
+	///   LAPACK dsgesv, refinement stops when every column satisfies 
+	///   ||r|| <= sqrt(n).eps.||A||.||x|| in the infinity norm, with eps of T.
+	///   This converges when the condition number of A is well below 1/eps
+	///   of float (around 10^7). If the residual stops decreasing, or A is 
+	///   singular or out of range in single precision, the system is solved
+	///   by LU factorization in the precision of T instead.
+	/// </summary>
+	/// <typeparam name="T">Working floating-point type (double or long double).</typeparam>
+	/// <param name="A">The square matrix.</param>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <param name="x">Overwritten with the solution.</param>
+	/// <param name="options">Limit on refinement steps. The tolerance is not used.</param>
+	/// <returns>The number of refinement steps, relative residual 
+	///   ||b - A.x|| / ||b|| and convergence flag. The step count is zero if the direct method was
+	///   used in the precision of T.</returns>
+	template <typename T>
+	solver_result mixed_precision_solve(
+		const mat<T>& A,
+		const mat<T>& b,
+		mat<T>& x,
+		const solver_options& options)
+	{
+		solver_result result;
+
+		// Validate arguments
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Matrix must be square.");
+		if (b.rows() != A.rows())
+			throw std::runtime_error("Rows in right-hand side must match rows in matrix.");
+
+		// Handle edge case
+		T b_norm = b.frobenius_norm();
+		if (b_norm == 0)
+		{
+			x = mat<T>(A.cols(), b.cols());
+			result.converged = true;
+			return result;
+		}
+
+		// Stopping bound of LAPACK dsgesv
+		T a_norm = A.norm_inf();
+		T bound = std::sqrt(static_cast<T>(A.rows())) * std::numeric_limits<T>::epsilon() * a_norm;
+
+		try
+		{
+			// Factorize and solve in single precision
+			lu_factorization<float> lu(convert<float>(A));
+			x = convert<T>(lu.solve(convert<float>(b)));
+
+			// Refine with residuals in the working precision
+			double previous = std::numeric_limits<double>::max();
+			while (true)
+			{
+				mat<T> r = b - A.mult(x);
+				result.residual = static_cast<double>(r.frobenius_norm() / b_norm);
+
+				if (residual_within(r, x, bound))
+				{
+					result.converged = true;
+					return result;
+				}
+				if (result.iterations >= options.max_iter || !(result.residual < previous / 2))
+					break;
+
+				// Scale each column of r to unit maximum for single precision
+				mat<T> scale = column_max_abs(r);
+				for (unsigned int i = 0; i < r.rows(); i++)
+					for (unsigned int j = 0; j < r.cols(); j++)
+						if (scale[0][j] > 0)
+							r[i][j] /= scale[0][j];
+
+				LINMAT_TRACE_ITERATION("mixed_precision_solve", result.iterations);
+				previous = result.residual;
+				mat<T> d = convert<T>(lu.solve(convert<float>(r)));
+				for (unsigned int i = 0; i < d.rows(); i++)
+					for (unsigned int j = 0; j < d.cols(); j++)
+						x[i][j] += d[i][j] * scale[0][j];
+				result.iterations++;
+			}
+		}
+		catch (const std::runtime_error&)
+		{
+			// The matrix is singular or out of range in single precision
+		}
+
+		// Refinement has failed, so solve in the working precision
+		x = lu_factorization<T>(A).solve(b);
+		// Backward-stable LU is within n.eps.||A||.||x||
+		mat<T> r = b - A.mult(x);
+		result.iterations = 0;
+		result.residual = static_cast<double>(r.frobenius_norm() / b_norm);
+		result.converged = residual_within(r, x, bound * static_cast<T>(std::sqrt(static_cast<double>(A.rows()))));
+
+		return result;
+	}
+
+	// Explicit template instantiations
+	template class factorization<float>;
+	template class factorization<double>;
+	template class factorization<long double>;
+	template class lu_factorization<float>;
+	template class lu_factorization<double>;
+	template class lu_factorization<long double>;
+	template class cholesky_factorization<float>;
+	template class cholesky_factorization<double>;
+	template class cholesky_factorization<long double>;
+	template class cholesky_window<float>;
+	template class cholesky_window<double>;
+	template class cholesky_window<long double>;
+	template void woodbury_update(mat<float>& A_inv, const mat<float>& U, const mat<float>& C, const mat<float>& V);
+	template void woodbury_update(mat<double>& A_inv, const mat<double>& U, const mat<double>& C, const mat<double>& V);
+	template void woodbury_update(mat<long double>& A_inv, const mat<long double>& U, const mat<long double>& C, const mat<long double>& V);
+	template void woodbury_update(mat<float>& A_inv, float& det, const mat<float>& U, const mat<float>& C, const mat<float>& V);
+	template void woodbury_update(mat<double>& A_inv, double& det, const mat<double>& U, const mat<double>& C, const mat<double>& V);
+	template void woodbury_update(mat<long double>& A_inv, long double& det, const mat<long double>& U, const mat<long double>& C, const mat<long double>& V);
+	template void sherman_morrison_update(mat<float>& A_inv, const mat<float>& u, const mat<float>& v);
+	template void sherman_morrison_update(mat<double>& A_inv, const mat<double>& u, const mat<double>& v);
+	template void sherman_morrison_update(mat<long double>& A_inv, const mat<long double>& u, const mat<long double>& v);
+	template void sherman_morrison_update(mat<float>& A_inv, float& det, const mat<float>& u, const mat<float>& v);
+	template void sherman_morrison_update(mat<double>& A_inv, double& det, const mat<double>& u, const mat<double>& v);
+	template void sherman_morrison_update(mat<long double>& A_inv, long double& det, const mat<long double>& u, const mat<long double>& v);
+	template solver_result inv_update(const mat<float>& A, mat<float>& X, const solver_options& options);
+	template solver_result inv_update(const mat<double>& A, mat<double>& X, const solver_options& options);
+	template solver_result inv_update(const mat<long double>& A, mat<long double>& X, const solver_options& options);
+	template solver_result mixed_precision_solve(const mat<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options);
+	template solver_result mixed_precision_solve(const mat<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options);
+}
@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include "../inc/fft.hpp"
+#include "../inc/constants.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Performs the forward transform of a power of two length in place, 
+	///   using the iterative radix-2 Cooley-Tukey algorithm.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The sequence to transform, of a power of two length.</param>
+	template <typename T>
+	static void fft_radix2(std::vector<std::complex<T>>& x)
+	{
+		const T pi = static_cast<T>(constants::PI);
+		std::size_t n = x.size();
+
+		// Bit reversal permutation
+		for (std::size_t i = 1, j = 0; i < n; i++)
+		{
+			std::size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			if (i < j)
+				std::swap(x[i], x[j]);
+		}
+
+		// Butterflies, with twiddle factors computed directly for accuracy
+		for (std::size_t len = 2; len <= n; len <<= 1)
+		{
+			std::size_t half = len / 2;
+			std::vector<std::complex<T>> w(half);
+			for (std::size_t k = 0; k < half; k++)
+				w[k] = std::polar(static_cast<T>(1), -2 * pi * k / len);
+
+			for (std::size_t i = 0; i < n; i += len)
+				for (std::size_t k = 0; k < half; k++)
+				{
+					std::complex<T> u = x[i + k];
+					std::complex<T> v = x[i + k + half] * w[k];
+					x[i + k] = u + v;
+					x[i + k + half] = u - v;
+				}
+		}
+	}
+
+	/// <summary>
+	///   Performs the forward transform of any length in place, using 
+	///   Bluestein's algorithm to express it as a convolution of a power of
+	///   two length.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The sequence to transform.</param>
+	template <typename T>
+	static void fft_bluestein(std::vector<std::complex<T>>& x)
+	{
+		const T pi = static_cast<T>(constants::PI);
+		std::size_t n = x.size();
+		std::size_t m = 1;
+		while (m < 2 * n - 1)
+			m <<= 1;
+
+		// Chirp w[k] = exp(-i.pi.k^2/n), with k^2 reduced modulo 2n
+		std::vector<std::complex<T>> w(n);
+		for (std::size_t k = 0; k < n; k++)
+		{
+			std::size_t k2 = (k * k) % (2 * n);
+			w[k] = std::polar(static_cast<T>(1), -pi * k2 / n);
+		}
+
+		std::vector<std::complex<T>> a(m), b(m);
+		for (std::size_t k = 0; k < n; k++)
+			a[k] = x[k] * w[k];
+		b[0] = std::conj(w[0]);
+		for (std::size_t k = 1; k < n; k++)
+			b[k] = b[m - k] = std::conj(w[k]);
+
+		// Circular convolution of a and b
+		fft_radix2(a);
+		fft_radix2(b);
+		for (std::size_t k = 0; k < m; k++)
+			a[k] = std::conj(a[k] * b[k]);
+		fft_radix2(a);
+
+		for (std::size_t k = 0; k < n; k++)
+			x[k] = std::conj(a[k]) * w[k] / static_cast<T>(m);
+	}
+
+	/// <summary>
+	///   Calculates the discrete Fourier transform in place, 
+	///   X[k] = sum x[j].exp(-2.pi.i.j.k/n), in O(n log n) operations for any
+	///   length n. The inverse transform includes the 1/n scaling.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The sequence to transform.</param>
+	/// <param name="inverse">True for the inverse transform.</param>
+	template <typename T>
+	void fft(std::vector<std::complex<T>>& x, bool inverse)
+	{
+		std::size_t n = x.size();
+		if (n < 2)
+			return;
+
+		// The inverse is the conjugate of the forward transform of the conjugate
+		if (inverse)
+			for (std::complex<T>& v : x)
+				v = std::conj(v);
+
+		if ((n & (n - 1)) == 0)
+			fft_radix2(x);
+		else
+			fft_bluestein(x);
+
+		if (inverse)
+			for (std::complex<T>& v : x)
+				v = std::conj(v) / static_cast<T>(n);
+	}
+
+	// Explicit template instantiations
+	template void fft(std::vector<std::complex<float>>& x, bool inverse);
+	template void fft(std::vector<std::complex<double>>& x, bool inverse);
+	template void fft(std::vector<std::complex<long double>>& x, bool inverse);
+}
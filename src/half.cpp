@@ -0,0 +1,314 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "../inc/half.hpp"
+#include "../inc/instrument.hpp"
+#include "../inc/tuning.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Half-precision constructor, rounding a float to nearest even. 
+	///   Values beyond the largest half, 65504, round to infinity, and values
+	///   below 2^-14 are stored as subnormals.
+	/// </summary>
+	/// <param name="value">The value.</param>
+	float16::float16(float value)
+	{
+		std::uint32_t x;
+		std::memcpy(&x, &value, sizeof(x));
+		std::uint32_t sign = (x >> 16) & 0x8000;
+		std::uint32_t magnitude = x & 0x7fffffff;
+		std::uint32_t h;
+
+		// Infinity and NaN, keeping NaN quiet
+		if (magnitude >= 0x7f800000)
+			h = 0x7c00 | (magnitude > 0x7f800000 ? 0x200 | ((magnitude >> 13) & 0x3ff) : 0);
+		// Rounds to at least 65520, which overflows
+		else if (magnitude >= 0x477ff000)
+			h = 0x7c00;
+		// Below 2^-25, which rounds to zero
+		else if (magnitude < 0x33000000)
+			h = 0;
+		// Subnormal, in units of 2^-24
+		else if (magnitude < 0x38800000)
+		{
+			std::uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+			std::uint32_t shift = 126 - (magnitude >> 23);
+			std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+			std::uint32_t half = 1u << (shift - 1);
+			h = mantissa >> shift;
+			if (remainder > half || (remainder == half && (h & 1)))
+				h++;
+		}
+		// Normal, with the exponent rebiased from 127 to 15
+		else
+		{
+			std::uint32_t remainder = magnitude & 0x1fff;
+			h = (magnitude - 0x38000000) >> 13;
+			if (remainder > 0x1000 || (remainder == 0x1000 && (h & 1)))
+				h++;
+		}
+
+		m_bits = static_cast<std::uint16_t>(sign | h);
+	}
+
+	/// <summary>
+	///   Converts to float, which represents every half exactly.
+	/// </summary>
+	/// <returns>The value.</returns>
+	float16::operator float() const
+	{
+		std::uint32_t sign = static_cast<std::uint32_t>(m_bits & 0x8000) << 16;
+		std::uint32_t exponent = (m_bits >> 10) & 0x1f;
+		std::uint32_t mantissa = m_bits & 0x3ff;
+		std::uint32_t x;
+		float value;
+
+		if (exponent == 0x1f)
+			x = sign | 0x7f800000 | (mantissa << 13);
+		else if (exponent == 0)
+		{
+			// Zero or subnormal
+			value = std::ldexp(static_cast<float>(mantissa), -24);
+			return sign ? -value : value;
+		}
+		else
+			x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+		std::memcpy(&value, &x, sizeof(value));
+		return value;
+	}
+
+	/// <summary>
+	///   Makes a half from its encoding.
+	/// </summary>
+	/// <param name="bits">The encoding.</param>
+	/// <returns>The half.</returns>
+	float16 float16::from_bits(std::uint16_t bits)
+	{
+		float16 h;
+		h.m_bits = bits;
+		return h;
+	}
+
+	/// <summary>
+	///   Brain floating-point constructor, rounding a float to nearest even
+	///   by truncating its mantissa.
+	/// </summary>
+	/// <param name="value">The value.</param>
+	bfloat16::bfloat16(float value)
+	{
+		std::uint32_t x;
+		std::memcpy(&x, &value, sizeof(x));
+
+		// Keep NaN quiet, as rounding could carry it into infinity
+		if ((x & 0x7fffffff) > 0x7f800000)
+			m_bits = static_cast<std::uint16_t>((x >> 16) | 0x40);
+		else
+			m_bits = static_cast<std::uint16_t>((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+	}
+
+	/// <summary>
+	///   Converts to float, which represents every bfloat16 exactly.
+	/// </summary>
+	/// <returns>The value.</returns>
+	bfloat16::operator float() const
+	{
+		std::uint32_t x = static_cast<std::uint32_t>(m_bits) << 16;
+		float value;
+
+		std::memcpy(&value, &x, sizeof(value));
+		return value;
+	}
+
+	/// <summary>
+	///   Makes a bfloat16 from its encoding.
+	/// </summary>
+	/// <param name="bits">The encoding.</param>
+	/// <returns>The bfloat16.</returns>
+	bfloat16 bfloat16::from_bits(std::uint16_t bits)
+	{
+		bfloat16 h;
+		h.m_bits = bits;
+		return h;
+	}
+
+	/// <summary>
+	///   Copies a matrix with its elements converted to another type.
+	/// </summary>
+	/// <typeparam name="U">Element type of the copy.</typeparam>
+	/// <typeparam name="T">Element type of the matrix.</typeparam>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A new matrix which is the copy.</returns>
+	template <typename U, typename T>
+	static mat<U> convert(const mat<T>& A)
+	{
+		mat<U> result(A.rows(), A.cols());
+
+		for (unsigned int i = 0; i < A.rows(); i++)
+			std::copy(A[i].begin(), A[i].end(), result[i].begin());
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies matrices of a 16-bit type with the blocked loop of 
+	///   mat::mult, accumulating in float. Each gemm_kc x gemm_nc block of 
+	///   the right matrix is widened to float into a reused panel, and each
+	///   gemm_nc column panel of the product is accumulated in float and
+	///   rounded once when complete. Elements of the left matrix are 
+	///   converted as they are used, so that it is read at 16 bits per 
+	///   element.
+	/// </summary>
+	/// <typeparam name="H">16-bit element type.</typeparam>
+	/// <param name="A">The left matrix.</param>
+	/// <param name="B">The right matrix.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename H>
+	static mat<H> mult_float(const mat<H>& A, const mat<H>& B)
+	{
+		unsigned int m = A.rows(), k = A.cols(), n = B.cols();
+		tuning_params params = tuning();
+		mat<H> result(m, n);
+
+		// Validate arguments
+		if (k != B.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		// Panels of the right matrix and the product in float
+		unsigned int nc = std::min(n, params.gemm_nc), kc = std::min(k, params.gemm_kc);
+		std::vector<float> Bp(static_cast<size_t>(kc) * nc);
+		std::vector<float> Cp(static_cast<size_t>(m) * nc);
+
+		// Perform blocked matrix multiplication
+		for (unsigned int jj = 0; jj < n; jj += params.gemm_nc)
+		{
+			unsigned int j_end = std::min(n, jj + params.gemm_nc);
+			unsigned int w = j_end - jj;
+			std::fill(Cp.begin(), Cp.end(), 0.0f);
+			for (unsigned int kk = 0; kk < k; kk += params.gemm_kc)
+			{
+				unsigned int k_end = std::min(k, kk + params.gemm_kc);
+
+				// Widen the block of the right matrix
+				for (unsigned int l = kk; l < k_end; l++)
+					std::copy(B[l].data() + jj, B[l].data() + j_end, Bp.begin() + static_cast<size_t>(l - kk) * nc);
+
+				for (unsigned int ii = 0; ii < m; ii += params.gemm_mc)
+				{
+					unsigned int i_end = std::min(m, ii + params.gemm_mc);
+					for (unsigned int i = ii; i < i_end; i++)
+					{
+						const H* a = A[i].data();
+						float* c = Cp.data() + static_cast<size_t>(i) * nc;
+						for (unsigned int l = kk; l < k_end; l++)
+						{
+							float a_il = a[l];
+							const float* b = Bp.data() + static_cast<size_t>(l - kk) * nc;
+							for (unsigned int j = 0; j < w; j++)
+								c[j] += a_il * b[j];
+						}
+					}
+				}
+			}
+
+			// Round the completed panel of the product
+			for (unsigned int i = 0; i < m; i++)
+				std::copy(Cp.data() + static_cast<size_t>(i) * nc, Cp.data() + static_cast<size_t>(i) * nc + w, result[i].data() + jj);
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates matrix multiplication of half-precision matrices, 
+	///   accumulating in float.
+	/// </summary>
+	/// <param name="other">The matrix on the right side of the multiplication.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <>
+	mat<float16> mat<float16>::mult(const mat<float16>& other) const
+	{
+		LINMAT_COUNT("mat::mult", 2.0 * m_rows * m_cols * other.cols(), sizeof(float16) * m_rows * other.cols());
+		return mult_float(*this, other);
+	}
+
+	/// <summary>
+	///   Calculates matrix multiplication of bfloat16 matrices, accumulating
+	///   in float.
+	/// </summary>
+	/// <param name="other">The matrix on the right side of the multiplication.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <>
+	mat<bfloat16> mat<bfloat16>::mult(const mat<bfloat16>& other) const
+	{
+		LINMAT_COUNT("mat::mult", 2.0 * m_rows * m_cols * other.cols(), sizeof(bfloat16) * m_rows * other.cols());
+		return mult_float(*this, other);
+	}
+
+	/// <summary>
+	///   Converts a float matrix to half precision.
+	/// </summary>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A new matrix which is the conversion.</returns>
+	mat<float16> to_float16(const mat<float>& A)
+	{
+		return convert<float16>(A);
+	}
+
+	/// <summary>
+	///   Converts a float matrix to bfloat16.
+	/// </summary>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A new matrix which is the conversion.</returns>
+	mat<bfloat16> to_bfloat16(const mat<float>& A)
+	{
+		return convert<bfloat16>(A);
+	}
+
+	/// <summary>
+	///   Converts a half-precision matrix to float.
+	/// </summary>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A new matrix which is the conversion.</returns>
+	mat<float> to_float(const mat<float16>& A)
+	{
+		return convert<float>(A);
+	}
+
+	/// <summary>
+	///   Converts a bfloat16 matrix to float.
+	/// </summary>
+	/// <param name="A">The matrix.</param>
+	/// <returns>A new matrix which is the conversion.</returns>
+	mat<float> to_float(const mat<bfloat16>& A)
+	{
+		return convert<float>(A);
+	}
+}
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <memory>
+#include <mutex>
+#include "../inc/instrument.hpp"
+
+namespace linmat
+{
+	namespace instrument
+	{
+		// Counters by operation name, which are never removed so that
+		// references to them remain valid
+		static std::mutex s_lock;
+		static std::map<std::string, std::unique_ptr<counter>> s_counters;
+
+		/// <summary>
+		///   Gets whether the library was built with LINMAT_INSTRUMENT, so
+		///   that operations are counted.
+		/// </summary>
+		/// <returns>True if operations are counted.</returns>
+		bool enabled(void)
+		{
+#ifdef LINMAT_INSTRUMENT
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/// <summary>
+		///   Gets the counters of an operation, creating them on first use.
+		/// </summary>
+		/// <param name="name">Name of the operation.</param>
+		/// <returns>Reference to the counters.</returns>
+		counter& counter_for(const char* name)
+		{
+			std::lock_guard<std::mutex> guard(s_lock);
+			std::unique_ptr<counter>& c = s_counters[name];
+
+			if (!c)
+			{
+				c.reset(new counter());
+				c->calls = 0;
+				c->flops = 0;
+				c->bytes = 0;
+				c->nanoseconds = 0;
+			}
+
+			return *c;
+		}
+
+		/// <summary>
+		///   Gets the totals of each operation called since the last reset.
+		/// </summary>
+		/// <returns>The totals by operation name.</returns>
+		std::map<std::string, op_stats> snapshot(void)
+		{
+			std::lock_guard<std::mutex> guard(s_lock);
+			std::map<std::string, op_stats> result;
+
+			for (const auto& entry : s_counters)
+			{
+				const counter& c = *entry.second;
+				op_stats stats;
+				stats.calls = c.calls.load(std::memory_order_relaxed);
+				if (stats.calls == 0)
+					continue;
+				stats.flops = c.flops.load(std::memory_order_relaxed);
+				stats.bytes = c.bytes.load(std::memory_order_relaxed);
+				stats.seconds = c.nanoseconds.load(std::memory_order_relaxed) * 1e-9;
+				result[entry.first] = stats;
+			}
+
+			return result;
+		}
+
+		/// <summary>
+		///   Sets the counters of every operation to zero.
+		/// </summary>
+		void reset(void)
+		{
+			std::lock_guard<std::mutex> guard(s_lock);
+
+			for (auto& entry : s_counters)
+			{
+				entry.second->calls = 0;
+				entry.second->flops = 0;
+				entry.second->bytes = 0;
+				entry.second->nanoseconds = 0;
+			}
+		}
+	}
+}
@@ -0,0 +1,730 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "../inc/krylov.hpp"
+#include "../inc/linear_operator.hpp"
+#include "../inc/operators.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Calculates the inner product of two column vectors.
+	/// </summary>
+	template <typename T>
+	static T dot(const mat<T>& a, const mat<T>& b)
+	{
+		T result = 0;
+		for (unsigned int i = 0; i < a.rows(); i++)
+			result += a[i][0] * b[i][0];
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates y = y + alpha.x in place for column vectors.
+	/// </summary>
+	template <typename T>
+	static void axpy(mat<T>& y, T alpha, const mat<T>& x)
+	{
+		for (unsigned int i = 0; i < y.rows(); i++)
+			y[i][0] += alpha * x[i][0];
+	}
+
+	/// <summary>
+	///   Applies the preconditioner if one is given.
+	/// </summary>
+	template <typename T>
+	static mat<T> precondition(const preconditioner<T>* M, const mat<T>& r)
+	{
+		return M ? M->apply(r) : r;
+	}
+
+	/// <summary>
+	///   Validates the right-hand side and prepares the initial guess, which
+	///   is zero unless x already holds a vector of matching size.
+	/// </summary>
+	template <typename T>
+	static void initialize(const linear_operator<T>& A, const mat<T>& b, mat<T>& x)
+	{
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Iterative solvers require a square operator.");
+		if (b.cols() != 1 || b.rows() != A.rows())
+			throw std::runtime_error("Right-hand side must be a column vector matching the operator.");
+		if (x.rows() != b.rows() || x.cols() != 1)
+			x = mat<T>::make_zeros(b.rows(), 1);
+	}
+
+	/// <summary>
+	///   Jacobi preconditioner constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square system matrix.</param>
+	template <typename T>
+	jacobi_preconditioner<T>::jacobi_preconditioner(const mat<T>& A)
+		: m_inv_diag(A.rows())
+	{
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Preconditioner requires a square matrix.");
+
+		for (unsigned int i = 0; i < A.rows(); i++)
+		{
+			if (A[i][i] == 0)
+				throw std::runtime_error("Jacobi preconditioner requires a non-zero diagonal.");
+			m_inv_diag[i] = 1 / A[i][i];
+		}
+	}
+
+	/// <summary>
+	///   Applies the Jacobi preconditioner.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="r">The column vector to precondition.</param>
+	/// <returns>The preconditioned vector.</returns>
+	template <typename T>
+	mat<T> jacobi_preconditioner<T>::apply(const mat<T>& r) const
+	{
+		mat<T> z(r.rows(), 1);
+		for (unsigned int i = 0; i < r.rows(); i++)
+			z[i][0] = m_inv_diag[i] * r[i][0];
+		return z;
+	}
+
+	/// <summary>
+	///   Incomplete Cholesky preconditioner constructor. The factor L keeps
+	///   the sparsity pattern of the lower triangle of A.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The symmetric positive-definite system matrix.</param>
+	template <typename T>
+	ichol_preconditioner<T>::ichol_preconditioner(const mat<T>& A)
+		: m_L(A.rows(), A.cols())
+		, m_pattern(A.rows())
+	{
+		unsigned int n = A.rows();
+
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Preconditioner requires a square matrix.");
+
+		// Pattern of the lower triangle, including the diagonal
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+				if (A[i][j] != 0 || i == j)
+					m_pattern[i].push_back(j);
+
+		// Cholesky-Banachiewicz restricted to the pattern
+		for (unsigned int i = 0; i < n; i++)
+		{
+			for (unsigned int j : m_pattern[i])
+			{
+				T s = 0;
+				for (unsigned int k : m_pattern[i])
+				{
+					if (k >= j)
+						break;
+					s += m_L[i][k] * m_L[j][k];
+				}
+				if (i == j)
+				{
+					if (A[i][i] - s <= 0)
+						throw std::runtime_error("Incomplete Cholesky factorization broke down.");
+					m_L[i][i] = std::sqrt(A[i][i] - s);
+				}
+				else
+					m_L[i][j] = (A[i][j] - s) / m_L[j][j];
+			}
+		}
+	}
+
+	/// <summary>
+	///   Applies the incomplete Cholesky preconditioner by forward and back
+	///   substitution with L and L^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="r">The column vector to precondition.</param>
+	/// <returns>The preconditioned vector.</returns>
+	template <typename T>
+	mat<T> ichol_preconditioner<T>::apply(const mat<T>& r) const
+	{
+		unsigned int n = r.rows();
+		mat<T> z = r;
+
+		// Solve L.y = r
+		for (unsigned int i = 0; i < n; i++)
+		{
+			for (unsigned int k : m_pattern[i])
+				if (k < i)
+					z[i][0] -= m_L[i][k] * z[k][0];
+			z[i][0] /= m_L[i][i];
+		}
+
+		// Solve L^T.z = y, scattering each solved entry up the columns
+		for (unsigned int i = n; i-- > 0;)
+		{
+			z[i][0] /= m_L[i][i];
+			for (unsigned int k : m_pattern[i])
+				if (k < i)
+					z[k][0] -= m_L[i][k] * z[i][0];
+		}
+
+		return z;
+	}
+
+	/// <summary>
+	///   Incomplete LU preconditioner constructor. The factors keep the
+	///   sparsity pattern of A.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square system matrix.</param>
+	template <typename T>
+	ilu_preconditioner<T>::ilu_preconditioner(const mat<T>& A)
+		: m_LU(A)
+		, m_pattern(A.rows())
+	{
+		unsigned int n = A.rows();
+
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Preconditioner requires a square matrix.");
+
+		// Pattern of A, including the diagonal
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j < n; j++)
+				if (A[i][j] != 0 || i == j)
+					m_pattern[i].push_back(j);
+
+		// IKJ variant of Gaussian elimination restricted to the pattern
+		for (unsigned int i = 1; i < n; i++)
+		{
+			for (unsigned int k : m_pattern[i])
+			{
+				if (k >= i)
+					break;
+				if (m_LU[k][k] == 0)
+					throw std::runtime_error("Incomplete LU factorization broke down.");
+				m_LU[i][k] /= m_LU[k][k];
+				for (unsigned int j : m_pattern[i])
+					if (j > k)
+						m_LU[i][j] -= m_LU[i][k] * m_LU[k][j];
+			}
+		}
+		if (m_LU[n - 1][n - 1] == 0)
+			throw std::runtime_error("Incomplete LU factorization broke down.");
+	}
+
+	/// <summary>
+	///   Applies the incomplete LU preconditioner by forward and back
+	///   substitution.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="r">The column vector to precondition.</param>
+	/// <returns>The preconditioned vector.</returns>
+	template <typename T>
+	mat<T> ilu_preconditioner<T>::apply(const mat<T>& r) const
+	{
+		unsigned int n = r.rows();
+		mat<T> z = r;
+
+		// Solve L.y = r with unit diagonal L
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int k : m_pattern[i])
+			{
+				if (k >= i)
+					break;
+				z[i][0] -= m_LU[i][k] * z[k][0];
+			}
+
+		// Solve U.z = y
+		for (unsigned int i = n; i-- > 0;)
+		{
+			for (unsigned int k : m_pattern[i])
+				if (k > i)
+					z[i][0] -= m_LU[i][k] * z[k][0];
+			z[i][0] /= m_LU[i][i];
+		}
+
+		return z;
+	}
+
+	/// <summary>
+	///   Solves A.x = b for symmetric positive-definite A using the 
+	///   preconditioned conjugate gradient method.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <param name="b">The right-hand side column vector.</param>
+	/// <param name="x">The initial guess, overwritten with the solution.</param>
+	/// <param name="options">Iteration limit and tolerance.</param>
+	/// <param name="M">Optional symmetric positive-definite preconditioner.</param>
+	/// <returns>The iteration count, relative residual and convergence flag.</returns>
+	template <typename T>
+	solver_result cg(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		solver_result result;
+		initialize(A, b, x);
+
+		T b_norm = b.frobenius_norm();
+		if (b_norm == 0)
+			b_norm = 1;
+
+		mat<T> r = b - A.apply(x);
+		mat<T> z = precondition(M, r);
+		mat<T> p = z;
+		T rz = dot(r, z);
+		result.residual = static_cast<double>(r.frobenius_norm() / b_norm);
+
+		while (result.residual > options.tol && result.iterations < options.max_iter)
+		{
+			LINMAT_TRACE_ITERATION("cg", result.iterations);
+			mat<T> Ap = A.apply(p);
+			T pAp = dot(p, Ap);
+			if (pAp == 0)
+				break;
+
+			// Step along the search direction
+			T alpha = rz / pAp;
+			axpy(x, alpha, p);
+			axpy(r, -alpha, Ap);
+			result.iterations++;
+			result.residual = static_cast<double>(r.frobenius_norm() / b_norm);
+			if (result.residual <= options.tol)
+				break;
+
+			// Next A-conjugate search direction
+			z = precondition(M, r);
+			T rz_1 = dot(r, z);
+			T beta = rz_1 / rz;
+			rz = rz_1;
+			for (unsigned int i = 0; i < p.rows(); i++)
+				p[i][0] = z[i][0] + beta * p[i][0];
+		}
+
+		result.converged = result.residual <= options.tol;
+		return result;
+	}
+
+	/// <summary>
+	///   Solves A.x = b for symmetric, possibly indefinite, A using the 
+	///   preconditioned minimum residual method of Paige and Saunders.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <param name="b">The right-hand side column vector.</param>
+	/// <param name="x">The initial guess, overwritten with the solution.</param>
+	/// <param name="options">Iteration limit and tolerance.</param>
+	/// <param name="M">Optional symmetric positive-definite preconditioner.</param>
+	/// <returns>The iteration count, relative residual and convergence flag.</returns>
+	template <typename T>
+	solver_result minres(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		solver_result result;
+		initialize(A, b, x);
+		unsigned int n = b.rows();
+
+		T b_norm = b.frobenius_norm();
+		if (b_norm == 0)
+			b_norm = 1;
+
+		// Lanczos vectors and preconditioned residual
+		mat<T> r1 = b - A.apply(x);
+		mat<T> y = precondition(M, r1);
+		mat<T> r2 = r1;
+		T ry = dot(r1, y);
+		if (ry < 0)
+			throw std::runtime_error("Preconditioner must be positive-definite.");
+		T beta1 = std::sqrt(ry);
+		result.residual = static_cast<double>(r1.frobenius_norm() / b_norm);
+
+		// Givens rotation and update state
+		T beta = beta1, old_beta = 0;
+		T epsilon = 0, delta_bar = 0, phi_bar = beta1;
+		T cs = -1, sn = 0;
+		mat<T> w(n, 1), w1(n, 1), w2(n, 1);
+
+		while (result.residual > options.tol && result.iterations < options.max_iter && beta != 0)
+		{
+			LINMAT_TRACE_ITERATION("minres", result.iterations);
+
+			// Lanczos step
+			mat<T> v = y / beta;
+			y = A.apply(v);
+			if (result.iterations > 0)
+				axpy(y, -beta / old_beta, r1);
+			T alpha = dot(v, y);
+			axpy(y, -alpha / beta, r2);
+			r1 = r2;
+			r2 = y;
+			y = precondition(M, r2);
+			old_beta = beta;
+			ry = dot(r2, y);
+			if (ry < 0)
+				throw std::runtime_error("Preconditioner must be positive-definite.");
+			beta = std::sqrt(ry);
+
+			// Apply the previous rotation and compute the next
+			T old_epsilon = epsilon;
+			T delta = cs * delta_bar + sn * alpha;
+			T gamma_bar = sn * delta_bar - cs * alpha;
+			epsilon = sn * beta;
+			delta_bar = -cs * beta;
+			T gamma = std::sqrt(gamma_bar * gamma_bar + beta * beta);
+			if (gamma == 0)
+				gamma = std::numeric_limits<T>::epsilon();
+			cs = gamma_bar / gamma;
+			sn = beta / gamma;
+			T phi = cs * phi_bar;
+			phi_bar = sn * phi_bar;
+
+			// Update the solution
+			w1 = w2;
+			w2 = w;
+			for (unsigned int i = 0; i < n; i++)
+				w[i][0] = (v[i][0] - old_epsilon * w1[i][0] - delta * w2[i][0]) / gamma;
+			axpy(x, phi, w);
+			result.iterations++;
+
+			// The residual in the preconditioner norm is tracked by phi_bar,
+			// and is confirmed against the true residual on convergence
+			if (phi_bar / beta1 <= options.tol)
+				result.residual = static_cast<double>((b - A.apply(x)).frobenius_norm() / b_norm);
+		}
+
+		result.residual = static_cast<double>((b - A.apply(x)).frobenius_norm() / b_norm);
+		result.converged = result.residual <= options.tol;
+		return result;
+	}
+
+	/// <summary>
+	///   Solves A.x = b for general A using the restarted generalized minimum
+	///   residual method, GMRES(m), with right preconditioning.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <param name="b">The right-hand side column vector.</param>
+	/// <param name="x">The initial guess, overwritten with the solution.</param>
+	/// <param name="options">Iteration limit, tolerance and restart length.</param>
+	/// <param name="M">Optional preconditioner.</param>
+	/// <returns>The iteration count, relative residual and convergence flag.</returns>
+	template <typename T>
+	solver_result gmres(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		solver_result result;
+		initialize(A, b, x);
+		unsigned int n = b.rows();
+		unsigned int m = options.restart ? options.restart : 1;
+
+		T b_norm = b.frobenius_norm();
+		if (b_norm == 0)
+			b_norm = 1;
+
+		mat<T> r = b - A.apply(x);
+		T beta = r.frobenius_norm();
+		result.residual = static_cast<double>(beta / b_norm);
+
+		while (result.residual > options.tol && result.iterations < options.max_iter)
+		{
+			LINMAT_TRACE_ITERATION("gmres", result.iterations);
+
+			// Krylov basis, Hessenberg matrix and rotated right-hand side
+			std::vector<mat<T>> V(1, r / beta);
+			mat<T> H(m + 1, m);
+			std::vector<T> cs(m), sn(m), g(m + 1);
+			g[0] = beta;
+			unsigned int k = 0;
+
+			// Arnoldi process with modified Gram-Schmidt
+			while (k < m && result.iterations < options.max_iter)
+			{
+				mat<T> w = A.apply(precondition(M, V[k]));
+				for (unsigned int i = 0; i <= k; i++)
+				{
+					H[i][k] = dot(w, V[i]);
+					axpy(w, -H[i][k], V[i]);
+				}
+				H[k + 1][k] = w.frobenius_norm();
+				if (H[k + 1][k] != 0)
+					V.push_back(w / H[k + 1][k]);
+
+				// Apply previous rotations to the new column
+				for (unsigned int i = 0; i < k; i++)
+				{
+					T h = cs[i] * H[i][k] + sn[i] * H[i + 1][k];
+					H[i + 1][k] = -sn[i] * H[i][k] + cs[i] * H[i + 1][k];
+					H[i][k] = h;
+				}
+
+				// Rotation eliminating the subdiagonal entry
+				T denom = std::sqrt(H[k][k] * H[k][k] + H[k + 1][k] * H[k + 1][k]);
+				cs[k] = (denom == 0) ? 1 : H[k][k] / denom;
+				sn[k] = (denom == 0) ? 0 : H[k + 1][k] / denom;
+				H[k][k] = denom;
+				H[k + 1][k] = 0;
+				g[k + 1] = -sn[k] * g[k];
+				g[k] = cs[k] * g[k];
+
+				k++;
+				result.iterations++;
+				result.residual = static_cast<double>(std::fabs(g[k]) / b_norm);
+				if (result.residual <= options.tol || V.size() <= k)
+					break;
+			}
+
+			// Solve the upper triangular system H.y = g
+			std::vector<T> y(k);
+			for (unsigned int i = k; i-- > 0;)
+			{
+				y[i] = g[i];
+				for (unsigned int j = i + 1; j < k; j++)
+					y[i] -= H[i][j] * y[j];
+				y[i] = (H[i][i] == 0) ? 0 : y[i] / H[i][i];
+			}
+
+			// Update the solution, x = x + M^-1.V.y
+			mat<T> u(n, 1);
+			for (unsigned int i = 0; i < k; i++)
+				axpy(u, y[i], V[i]);
+			axpy(x, static_cast<T>(1), precondition(M, u));
+
+			// True residual for the restart
+			r = b - A.apply(x);
+			beta = r.frobenius_norm();
+			result.residual = static_cast<double>(beta / b_norm);
+			if (beta == 0 || V.size() <= k)
+				break;
+		}
+
+		result.converged = result.residual <= options.tol;
+		return result;
+	}
+
+	/// <summary>
+	///   Solves A.x = b for general A using the stabilized bi-conjugate 
+	///   gradient method, BiCGStab, with right preconditioning.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <param name="b">The right-hand side column vector.</param>
+	/// <param name="x">The initial guess, overwritten with the solution.</param>
+	/// <param name="options">Iteration limit and tolerance.</param>
+	/// <param name="M">Optional preconditioner.</param>
+	/// <returns>The iteration count, relative residual and convergence flag.</returns>
+	template <typename T>
+	solver_result bicgstab(const linear_operator<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		solver_result result;
+		initialize(A, b, x);
+		unsigned int n = b.rows();
+
+		T b_norm = b.frobenius_norm();
+		if (b_norm == 0)
+			b_norm = 1;
+
+		mat<T> r = b - A.apply(x);
+		mat<T> r_hat = r;
+		mat<T> p(n, 1), v(n, 1);
+		T rho = 1, alpha = 1, omega = 1;
+		result.residual = static_cast<double>(r.frobenius_norm() / b_norm);
+
+		while (result.residual > options.tol && result.iterations < options.max_iter)
+		{
+			LINMAT_TRACE_ITERATION("bicgstab", result.iterations);
+
+			// Breakdown if the shadow residual becomes orthogonal
+			T rho_1 = dot(r_hat, r);
+			if (rho_1 == 0 || omega == 0)
+				break;
+
+			// Bi-conjugate gradient step
+			T beta = (rho_1 / rho) * (alpha / omega);
+			for (unsigned int i = 0; i < n; i++)
+				p[i][0] = r[i][0] + beta * (p[i][0] - omega * v[i][0]);
+			mat<T> p_hat = precondition(M, p);
+			v = A.apply(p_hat);
+
+			// Breakdown if the direction is orthogonal to the shadow residual
+			T r_hat_v = dot(r_hat, v);
+			if (r_hat_v == 0)
+				break;
+			alpha = rho_1 / r_hat_v;
+			mat<T> s = r;
+			axpy(s, -alpha, v);
+			axpy(x, alpha, p_hat);
+			result.iterations++;
+			result.residual = static_cast<double>(s.frobenius_norm() / b_norm);
+			if (result.residual <= options.tol)
+				break;
+
+			// Stabilizing minimum residual step
+			mat<T> s_hat = precondition(M, s);
+			mat<T> t = A.apply(s_hat);
+			T tt = dot(t, t);
+			omega = (tt == 0) ? 0 : dot(t, s) / tt;
+			axpy(x, omega, s_hat);
+			r = s;
+			axpy(r, -omega, t);
+			rho = rho_1;
+			result.residual = static_cast<double>(r.frobenius_norm() / b_norm);
+		}
+
+		result.converged = result.residual <= options.tol;
+		return result;
+	}
+
+	/// <summary>
+	///   Solves A.x = b for symmetric positive-definite dense A using the
+	///   preconditioned conjugate gradient method.
+	/// </summary>
+	template <typename T>
+	solver_result cg(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return cg<T>(dense_operator<T>(A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for symmetric dense A using the preconditioned
+	///   minimum residual method.
+	/// </summary>
+	template <typename T>
+	solver_result minres(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return minres<T>(dense_operator<T>(A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for general dense A using restarted GMRES.
+	/// </summary>
+	template <typename T>
+	solver_result gmres(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return gmres<T>(dense_operator<T>(A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for general dense A using BiCGStab.
+	/// </summary>
+	template <typename T>
+	solver_result bicgstab(const mat<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return bicgstab<T>(dense_operator<T>(A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for symmetric positive-definite A given as a
+	///   function, using the preconditioned conjugate gradient method.
+	/// </summary>
+	template <typename T>
+	solver_result cg(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return cg<T>(function_operator<T>(b.rows(), b.rows(), A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for symmetric A given as a function, using the
+	///   preconditioned minimum residual method.
+	/// </summary>
+	template <typename T>
+	solver_result minres(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return minres<T>(function_operator<T>(b.rows(), b.rows(), A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for general A given as a function, using
+	///   restarted GMRES.
+	/// </summary>
+	template <typename T>
+	solver_result gmres(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return gmres<T>(function_operator<T>(b.rows(), b.rows(), A), b, x, options, M);
+	}
+
+	/// <summary>
+	///   Solves A.x = b for general A given as a function, using
+	///   BiCGStab.
+	/// </summary>
+	template <typename T>
+	solver_result bicgstab(const matvec_fn<T>& A, const mat<T>& b, mat<T>& x,
+		const solver_options& options, const preconditioner<T>* M)
+	{
+		return bicgstab<T>(function_operator<T>(b.rows(), b.rows(), A), b, x, options, M);
+	}
+
+	// Explicit template instantiations
+	template class jacobi_preconditioner<float>;
+	template class jacobi_preconditioner<double>;
+	template class jacobi_preconditioner<long double>;
+	template class ichol_preconditioner<float>;
+	template class ichol_preconditioner<double>;
+	template class ichol_preconditioner<long double>;
+	template class ilu_preconditioner<float>;
+	template class ilu_preconditioner<double>;
+	template class ilu_preconditioner<long double>;
+	template solver_result cg(const mat<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result cg(const mat<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result cg(const mat<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result cg(const matvec_fn<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result cg(const linear_operator<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result cg(const matvec_fn<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result cg(const linear_operator<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result cg(const matvec_fn<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result cg(const linear_operator<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result minres(const mat<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result minres(const mat<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result minres(const mat<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result minres(const matvec_fn<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result minres(const linear_operator<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result minres(const matvec_fn<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result minres(const linear_operator<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result minres(const matvec_fn<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result minres(const linear_operator<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result gmres(const mat<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result gmres(const mat<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result gmres(const mat<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result gmres(const matvec_fn<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result gmres(const linear_operator<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result gmres(const matvec_fn<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result gmres(const linear_operator<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result gmres(const matvec_fn<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result gmres(const linear_operator<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result bicgstab(const mat<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result bicgstab(const mat<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result bicgstab(const mat<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result bicgstab(const matvec_fn<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result bicgstab(const linear_operator<float>& A, const mat<float>& b, mat<float>& x, const solver_options& options, const preconditioner<float>* M);
+	template solver_result bicgstab(const matvec_fn<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result bicgstab(const linear_operator<double>& A, const mat<double>& b, mat<double>& x, const solver_options& options, const preconditioner<double>* M);
+	template solver_result bicgstab(const matvec_fn<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+	template solver_result bicgstab(const linear_operator<long double>& A, const mat<long double>& b, mat<long double>& x, const solver_options& options, const preconditioner<long double>* M);
+}
@@ -0,0 +1,531 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "../inc/linear_operator.hpp"
+#include "../inc/operators.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Dense matrix operator constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The matrix, which must outlive the operator.</param>
+	template <typename T>
+	dense_operator<T>::dense_operator(const mat<T>& A)
+		: m_A(A)
+	{
+	}
+
+	/// <summary>
+	///   Calculates the product A.X.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> dense_operator<T>::apply(const mat<T>& x) const
+	{
+		return m_A.mult(x);
+	}
+
+	/// <summary>
+	///   Calculates the product A^T.X without forming the transpose.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> dense_operator<T>::apply_transpose(const mat<T>& x) const
+	{
+		mat<T> result(m_A.cols(), x.cols());
+
+		// Validate arguments
+		if (m_A.rows() != x.rows())
+			throw std::runtime_error("Rows in right matrix must match rows in operator.");
+
+		// Accumulate rows of A scaled by the entries of x
+		for (unsigned int i = 0; i < m_A.rows(); i++)
+			for (unsigned int j = 0; j < m_A.cols(); j++)
+				for (unsigned int k = 0; k < x.cols(); k++)
+					result[j][k] += m_A[i][j] * x[i][k];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Function operator constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="rows">Number of rows of the operator.</param>
+	/// <param name="cols">Number of columns of the operator.</param>
+	/// <param name="apply">Function returning A.x for a column vector x.</param>
+	/// <param name="apply_transpose">Optional function returning A^T.x.</param>
+	template <typename T>
+	function_operator<T>::function_operator(
+		unsigned int rows,
+		unsigned int cols,
+		const function_type& apply,
+		const function_type& apply_transpose)
+		: m_rows(rows)
+		, m_cols(cols)
+		, m_apply(apply)
+		, m_apply_transpose(apply_transpose)
+	{
+	}
+
+	/// <summary>
+	///   Applies a vector function to each column of a block.
+	/// </summary>
+	template <typename T>
+	static mat<T> apply_columns(
+		const std::function<mat<T>(const mat<T>&)>& f,
+		unsigned int rows,
+		const mat<T>& x)
+	{
+		// Column vectors are passed straight through
+		if (x.cols() == 1)
+			return f(x);
+
+		mat<T> result(rows, x.cols());
+		mat<T> column(x.rows(), 1);
+		for (unsigned int k = 0; k < x.cols(); k++)
+		{
+			for (unsigned int i = 0; i < x.rows(); i++)
+				column[i][0] = x[i][k];
+			mat<T> y = f(column);
+			for (unsigned int i = 0; i < rows; i++)
+				result[i][k] = y[i][0];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the product A.X.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> function_operator<T>::apply(const mat<T>& x) const
+	{
+		if (x.rows() != m_cols)
+			throw std::runtime_error("Rows in right matrix must match columns in operator.");
+
+		return apply_columns(m_apply, m_rows, x);
+	}
+
+	/// <summary>
+	///   Calculates the product A^T.X.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> function_operator<T>::apply_transpose(const mat<T>& x) const
+	{
+		if (!m_apply_transpose)
+			throw std::runtime_error("Operator does not define a transpose product.");
+		if (x.rows() != m_rows)
+			throw std::runtime_error("Rows in right matrix must match rows in operator.");
+
+		return apply_columns(m_apply_transpose, m_cols, x);
+	}
+
+	/// <summary>
+	///   Gram operator constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The operator A, which must outlive this operator.</param>
+	template <typename T>
+	gram_operator<T>::gram_operator(const linear_operator<T>& A)
+		: m_A(A)
+	{
+	}
+
+	/// <summary>
+	///   Calculates the product A^T.A.X.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> gram_operator<T>::apply(const mat<T>& x) const
+	{
+		return m_A.apply_transpose(m_A.apply(x));
+	}
+
+	/// <summary>
+	///   Calculates the product (A^T.A)^T.X, which equals A^T.A.X.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> gram_operator<T>::apply_transpose(const mat<T>& x) const
+	{
+		return apply(x);
+	}
+
+	/// <summary>
+	///   Kronecker product operator constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The left operator, which must outlive this operator.</param>
+	/// <param name="B">The right operator, which must outlive this operator.</param>
+	template <typename T>
+	kronecker_operator<T>::kronecker_operator(const linear_operator<T>& A, const linear_operator<T>& B)
+		: m_A(A)
+		, m_B(B)
+	{
+	}
+
+	/// <summary>
+	///   Applies the Kronecker product of two operators to a block, using
+	///   the reshaping identity (A (x) B).vec(X) = vec(A.X.B^T).
+	/// </summary>
+	template <typename T>
+	static mat<T> kronecker_apply(
+		const std::function<mat<T>(const mat<T>&)>& a,
+		const std::function<mat<T>(const mat<T>&)>& b,
+		unsigned int a_rows, unsigned int a_cols,
+		unsigned int b_rows, unsigned int b_cols,
+		const mat<T>& x)
+	{
+		mat<T> result(a_rows * b_rows, x.cols());
+		mat<T> X(a_cols, b_cols);
+
+		// Validate arguments
+		if (x.rows() != a_cols * b_cols)
+			throw std::runtime_error("Rows in right matrix must match columns in operator.");
+
+		for (unsigned int k = 0; k < x.cols(); k++)
+		{
+			// Reshape the column into a matrix
+			for (unsigned int i = 0; i < a_cols; i++)
+				for (unsigned int j = 0; j < b_cols; j++)
+					X[i][j] = x[i * b_cols + j][k];
+
+			// Calculate A.X.B^T as (B.(A.X)^T)^T
+			mat<T> Y = b(a(X).transpose());
+
+			// Flatten back into the column
+			for (unsigned int i = 0; i < a_rows; i++)
+				for (unsigned int j = 0; j < b_rows; j++)
+					result[i * b_rows + j][k] = Y[j][i];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the product (A (x) B).X.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> kronecker_operator<T>::apply(const mat<T>& x) const
+	{
+		return kronecker_apply<T>(
+			[this](const mat<T>& v) { return m_A.apply(v); },
+			[this](const mat<T>& v) { return m_B.apply(v); },
+			m_A.rows(), m_A.cols(), m_B.rows(), m_B.cols(), x);
+	}
+
+	/// <summary>
+	///   Calculates the product (A (x) B)^T.X, using (A (x) B)^T = A^T (x) B^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The block of column vectors.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> kronecker_operator<T>::apply_transpose(const mat<T>& x) const
+	{
+		return kronecker_apply<T>(
+			[this](const mat<T>& v) { return m_A.apply_transpose(v); },
+			[this](const mat<T>& v) { return m_B.apply_transpose(v); },
+			m_A.cols(), m_A.rows(), m_B.cols(), m_B.rows(), x);
+	}
+
+	/// <summary>
+	///   Finds the dominant eigenvalue of a square operator by power 
+	///   iteration, stopping once the Rayleigh quotient has converged.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <param name="v">The initial guess, overwritten with the unit eigenvector.</param>
+	/// <param name="max_iter">Maximum number of iterations.</param>
+	/// <param name="tol">Relative change in the eigenvalue at which to stop.</param>
+	/// <returns>The dominant eigenvalue.</returns>
+	template <typename T>
+	T power_iteration(
+		const linear_operator<T>& A,
+		mat<T>& v,
+		unsigned int max_iter,
+		double tol)
+	{
+		T lambda = 0;
+
+		// Validate arguments
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Power iteration requires a square operator.");
+		if (v.rows() != A.cols() || v.cols() != 1)
+			throw std::runtime_error("Initial guess must be a column vector matching the operator.");
+
+		for (unsigned int i = 0; i < max_iter; i++)
+		{
+			LINMAT_TRACE_ITERATION("power_iteration", i);
+			T norm = v.frobenius_norm();
+			if (norm == 0)
+				break;
+			v = v / norm;
+
+			// Rayleigh quotient for the unit vector
+			mat<T> w = A.apply(v);
+			T lambda_1 = 0;
+			for (unsigned int j = 0; j < v.rows(); j++)
+				lambda_1 += v[j][0] * w[j][0];
+			v = w;
+
+			// Evaluate convergence
+			bool done = std::fabs(lambda_1 - lambda) <= tol * std::fabs(lambda_1);
+			lambda = lambda_1;
+			if (done)
+				break;
+		}
+
+		T norm = v.frobenius_norm();
+		if (norm != 0)
+			v = v / norm;
+
+		return lambda;
+	}
+
+	/// <summary>
+	///   Calculates the spectral (l2) norm of the operator.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The operator.</param>
+	/// <param name="engine">The random number engine, owned by the caller.</param>
+	/// <returns>The scalar valued spectral norm.</returns>
+	template <typename T>
+	T spectral_norm(const linear_operator<T>& A, std::mt19937& engine)
+	{
+		// The spectral norm of matrix A can be found from the square-root of 
+		// the largest eigenvalue of (A^T).(A)
+		mat<T> b_k(A.cols(), 1);
+		T lambda_max;
+		std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+		// Randomize initial guess 
+		for (unsigned int i = 0; i < A.cols(); i++)
+			b_k[i][0] = static_cast<T>(distribution(engine));
+
+		// Largest eigenvalue by power iteration
+		for (unsigned int i = 0; i < constants::MAX_ITER; i++)
+		{
+			LINMAT_TRACE_ITERATION("spectral_norm", i);
+			b_k = A.apply_transpose(A.apply(b_k / b_k.frobenius_norm()));
+		}
+
+		// Find the largest eigenvalue
+		lambda_max = b_k.frobenius_norm();
+
+		// Return square root
+		return std::sqrt(lambda_max);
+	}
+
+	/// <summary>
+	///   Estimates the spectral norm of the operator for scaling an initial
+	///   inverse, by power iteration on A^T.A to a loose tolerance.
+	/// </summary>
+	template <typename T>
+	static T estimate_spectral_norm_guess(const linear_operator<T>& A)
+	{
+		std::mt19937 engine(constants::RNG_SEED);
+		mat<T> v = mat<T>::make_randn(A.cols(), 1, engine);
+		T lambda = power_iteration<T>(gram_operator<T>(A), v, 100, 1e-4);
+
+		return std::sqrt(std::max(lambda, static_cast<T>(0)));
+	}
+
+	/// <summary>
+	///   Overwrites the product A.X with the residual R = I - A.X, returning
+	///   the Frobenius norm of R accumulated in the same pass.
+	/// </summary>
+	template <typename T>
+	static T identity_residual(mat<T>& AX)
+	{
+		T result = 0;
+
+		for (unsigned int i = 0; i < AX.rows(); i++)
+			for (unsigned int j = 0; j < AX.cols(); j++)
+			{
+				AX[i][j] = ((i == j) ? 1 : 0) - AX[i][j];
+				result += AX[i][j] * AX[i][j];
+			}
+
+		return std::sqrt(result);
+	}
+
+	/// <summary>
+	///   Adds the identity to a square matrix in place.
+	/// </summary>
+	template <typename T>
+	static void add_identity(mat<T>& m)
+	{
+		for (unsigned int i = 0; i < m.rows(); i++)
+			m[i][i] += 1;
+	}
+
+	/// <summary>
+	///     Calculates the inverse of the operator using Newton-Schulz iteration.
+	///     The inverse is dense, but the operator itself is only applied.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <returns>A new matrix which is the inverse</returns>
+	template <typename T>
+	mat<T> inv_shulz(const linear_operator<T>& A)
+	{
+		mat<T> X;
+		inv_hyperpower(A, X, 2);
+		return X;
+	}
+
+	/// <summary>
+	///     Calculates the inverse of the operator using the hyperpower 
+	///     iteration of the given order, X = X.(I + R + ... + R^(p-1)) with 
+	///     residual R = I - A.X, which reduces the residual to R^p each step.
+	///     Order 2 is the Newton-Schulz iteration. The iteration stops when 
+	///     ||R|| reaches the tolerance or stops decreasing. Once ||R|| < 1, a 
+	///     residual which stops decreasing has reached the accuracy allowed 
+	///     by rounding, and is accepted as converged; a residual which grows
+	///     from ||R|| >= 1 is taken as divergence.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square operator.</param>
+	/// <param name="X">The initial guess, overwritten with the inverse. If 
+	///   empty, the initial guess is A^T scaled by an estimate of the
+	///   reciprocal squared spectral norm.</param>
+	/// <param name="order">Order of the iteration, from 2 to 4.</param>
+	/// <param name="options">Iteration limit and tolerance on ||I - A.X||.</param>
+	/// <returns>The iteration count, residual norm and convergence flag.</returns>
+	template <typename T>
+	solver_result inv_hyperpower(
+		const linear_operator<T>& A,
+		mat<T>& X,
+		unsigned int order,
+		const solver_options& options)
+	{
+		unsigned int n = A.rows();
+		solver_result result;
+
+		// Validate arguments
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Inverse is undefined for a rectangular operator.");
+		if (order < 2 || order > 4)
+			throw std::runtime_error("Hyperpower order must be 2, 3 or 4.");
+
+		// Default initial guess, X = alpha.A^T with alpha = 1 / ||A||^2
+		if (X.rows() != n || X.cols() != n)
+		{
+			T sigma = estimate_spectral_norm_guess(A);
+			if (sigma == 0)
+				throw std::runtime_error("Matrix is singular.");
+			X = A.apply_transpose(mat<T>::make_eye(n, n)) * static_cast<T>(1 / (sigma * sigma));
+		}
+
+		// Residual of the initial guess
+		mat<T> R = A.apply(X);
+		T r_norm = identity_residual(R);
+		bool stagnated = false;
+		result.residual = static_cast<double>(r_norm);
+
+		while (result.residual > options.tol && result.iterations < options.max_iter)
+		{
+			LINMAT_TRACE_ITERATION("inv_hyperpower", result.iterations);
+
+			// Horner evaluation of S = I + R.(I + R.(...))
+			mat<T> S = R;
+			add_identity(S);
+			for (unsigned int k = 2; k < order; k++)
+			{
+				S = R.mult(S);
+				add_identity(S);
+			}
+			mat<T> X_1 = X.mult(S);
+
+			// Residual of the update, formed in the same pass as its norm
+			R = A.apply(X_1);
+			T r_norm_1 = identity_residual(R);
+
+			// Stop on divergence, or once rounding error prevents progress
+			if (!std::isfinite(static_cast<double>(r_norm_1)) || !(r_norm_1 < r_norm))
+			{
+				stagnated = std::isfinite(static_cast<double>(r_norm_1)) && r_norm < 1;
+				break;
+			}
+
+			X = X_1;
+			r_norm = r_norm_1;
+			result.residual = static_cast<double>(r_norm);
+			result.iterations++;
+		}
+
+		result.converged = result.residual <= options.tol || stagnated;
+		return result;
+	}
+
+	// Explicit template instantiations
+	template class dense_operator<float>;
+	template class dense_operator<double>;
+	template class dense_operator<long double>;
+	template class function_operator<float>;
+	template class function_operator<double>;
+	template class function_operator<long double>;
+	template class gram_operator<float>;
+	template class gram_operator<double>;
+	template class gram_operator<long double>;
+	template class kronecker_operator<float>;
+	template class kronecker_operator<double>;
+	template class kronecker_operator<long double>;
+	template float power_iteration(const linear_operator<float>& A, mat<float>& v, unsigned int max_iter, double tol);
+	template double power_iteration(const linear_operator<double>& A, mat<double>& v, unsigned int max_iter, double tol);
+	template long double power_iteration(const linear_operator<long double>& A, mat<long double>& v, unsigned int max_iter, double tol);
+	template float spectral_norm(const linear_operator<float>& A, std::mt19937& engine);
+	template double spectral_norm(const linear_operator<double>& A, std::mt19937& engine);
+	template long double spectral_norm(const linear_operator<long double>& A, std::mt19937& engine);
+	template mat<float> inv_shulz(const linear_operator<float>& A);
+	template mat<double> inv_shulz(const linear_operator<double>& A);
+	template mat<long double> inv_shulz(const linear_operator<long double>& A);
+	template solver_result inv_hyperpower(const linear_operator<float>& A, mat<float>& X, unsigned int order, const solver_options& options);
+	template solver_result inv_hyperpower(const linear_operator<double>& A, mat<double>& X, unsigned int order, const solver_options& options);
+	template solver_result inv_hyperpower(const linear_operator<long double>& A, mat<long double>& X, unsigned int order, const solver_options& options);
+}
@@ -0,0 +1,490 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../inc/mapped.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace linmat
+{
+	static_assert(sizeof(mat_file_header) == 64, "Matrix file header must be 64 bytes.");
+
+	// Binary matrix format constants
+	static const char FORMAT_MAGIC[8] = { 'L', 'I', 'N', 'M', 'A', 'T', 0, 0 };
+	static const std::uint32_t FORMAT_VERSION = 1;
+	static const std::uint32_t FORMAT_BYTE_ORDER = 0x01020304;
+	static const std::uint32_t FORMAT_ALIGNMENT = 64;
+
+	/// <summary>
+	///   Gets the format code of an element type.
+	/// </summary>
+	/// <returns>The element type code.</returns>
+	static std::uint32_t dtype_of(float) { return 1; }
+	static std::uint32_t dtype_of(double) { return 2; }
+	static std::uint32_t dtype_of(long double) { return 3; }
+
+	/// <summary>
+	///   Creates the header of a matrix file.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="rows">Number of rows.</param>
+	/// <param name="cols">Number of columns.</param>
+	/// <param name="layout">Order of the elements.</param>
+	/// <returns>The header.</returns>
+	template <typename T>
+	static mat_file_header make_header(unsigned int rows, unsigned int cols, storage_layout layout)
+	{
+		mat_file_header header;
+
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, FORMAT_MAGIC, sizeof(header.magic));
+		header.version = FORMAT_VERSION;
+		header.byte_order = FORMAT_BYTE_ORDER;
+		header.dtype = dtype_of(T());
+		header.element_size = sizeof(T);
+		header.rows = rows;
+		header.cols = cols;
+		header.layout = static_cast<std::uint32_t>(layout);
+		header.alignment = FORMAT_ALIGNMENT;
+		header.data_offset = (sizeof(mat_file_header) + FORMAT_ALIGNMENT - 1) / FORMAT_ALIGNMENT * FORMAT_ALIGNMENT;
+
+		return header;
+	}
+
+	/// <summary>
+	///   Validates the header of a matrix file for the element type and the
+	///   size of the file.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="header">The header.</param>
+	/// <param name="size">Size of the file in bytes.</param>
+	template <typename T>
+	static void validate_header(const mat_file_header& header, std::uint64_t size)
+	{
+		if (size < sizeof(mat_file_header) || std::memcmp(header.magic, FORMAT_MAGIC, sizeof(header.magic)) != 0)
+			throw std::runtime_error("Not a matrix file.");
+		if (header.byte_order != FORMAT_BYTE_ORDER)
+			throw std::runtime_error("Matrix file byte order does not match this machine.");
+		if (header.version != FORMAT_VERSION)
+			throw std::runtime_error("Unsupported matrix file version.");
+		if (header.dtype != dtype_of(T()) || header.element_size != sizeof(T))
+			throw std::runtime_error("Matrix file element type does not match.");
+		if (header.layout > static_cast<std::uint32_t>(storage_layout::col_major))
+			throw std::runtime_error("Unsupported matrix file layout.");
+		if (header.rows > UINT_MAX || header.cols > UINT_MAX)
+			throw std::runtime_error("Matrix file dimensions are too large.");
+		if (header.data_offset < sizeof(mat_file_header) || header.data_offset % alignof(T) != 0
+			|| header.data_offset > size
+			|| (header.cols != 0 && header.rows > (size - header.data_offset) / sizeof(T) / header.cols))
+			throw std::runtime_error("Matrix file is truncated.");
+	}
+
+	/// <summary>
+	///   Creates a matrix file of zeros and maps it for reading and writing.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file, which is replaced if it exists.</param>
+	/// <param name="rows">Number of rows.</param>
+	/// <param name="cols">Number of columns.</param>
+	/// <param name="layout">Order of the elements.</param>
+	/// <returns>The mapped matrix.</returns>
+	template <typename T>
+	mapped_mat<T> mapped_mat<T>::create(const std::string& path, unsigned int rows, unsigned int cols, storage_layout layout)
+	{
+		mat_file_header header = make_header<T>(rows, cols, layout);
+		std::uint64_t size = header.data_offset + static_cast<std::uint64_t>(rows) * cols * sizeof(T);
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		// Extend the file by writing its last byte, leaving the rest sparse
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		if (size > sizeof(header))
+		{
+			file.seekp(static_cast<std::streamoff>(size - 1));
+			file.put(0);
+		}
+		file.close();
+		if (!file)
+			throw std::runtime_error("Unable to write matrix file.");
+
+		return mapped_mat<T>(path, map_mode::read_write);
+	}
+
+	/// <summary>
+	///   Constructor maps a matrix file into memory.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file.</param>
+	/// <param name="mode">Access to the mapped elements.</param>
+	template <typename T>
+	mapped_mat<T>::mapped_mat(const std::string& path, map_mode mode)
+		: m_view(nullptr)
+		, m_size(0)
+		, m_data(nullptr)
+		, m_rows(0)
+		, m_cols(0)
+		, m_layout(storage_layout::row_major)
+		, m_mode(mode)
+	{
+		map(path, mode);
+	}
+
+	/// <summary>
+	///   Move constructor takes over the mapping.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The mapped matrix to move from.</param>
+	template <typename T>
+	mapped_mat<T>::mapped_mat(mapped_mat<T>&& other)
+		: m_view(other.m_view)
+		, m_size(other.m_size)
+		, m_data(other.m_data)
+		, m_rows(other.m_rows)
+		, m_cols(other.m_cols)
+		, m_layout(other.m_layout)
+		, m_mode(other.m_mode)
+	{
+		other.m_view = nullptr;
+		other.m_data = nullptr;
+		other.m_size = 0;
+	}
+
+	/// <summary>
+	///   Destructor unmaps the file. Writes through a read-write mapping 
+	///   are written back to the file by the operating system.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	mapped_mat<T>::~mapped_mat()
+	{
+		unmap();
+	}
+
+	/// <summary>
+	///   Maps the file and validates its header.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file.</param>
+	/// <param name="mode">Access to the mapped elements.</param>
+	template <typename T>
+	void mapped_mat<T>::map(const std::string& path, map_mode mode)
+	{
+		std::uint64_t size;
+
+#ifdef _WIN32
+		DWORD access = mode == map_mode::read_write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+		HANDLE file = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("Unable to open matrix file.");
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(mat_file_header)))
+		{
+			CloseHandle(file);
+			throw std::runtime_error("Not a matrix file.");
+		}
+		size = static_cast<std::uint64_t>(file_size.QuadPart);
+
+		DWORD protect = mode == map_mode::read_only ? PAGE_READONLY : mode == map_mode::copy_on_write ? PAGE_WRITECOPY : PAGE_READWRITE;
+		DWORD view_access = mode == map_mode::read_only ? FILE_MAP_READ : mode == map_mode::copy_on_write ? FILE_MAP_COPY : FILE_MAP_WRITE;
+		HANDLE mapping = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr)
+			throw std::runtime_error("Unable to map matrix file.");
+		m_view = MapViewOfFile(mapping, view_access, 0, 0, 0);
+		CloseHandle(mapping);
+		if (m_view == nullptr)
+			throw std::runtime_error("Unable to map matrix file.");
+#else
+		int file = open(path.c_str(), mode == map_mode::read_write ? O_RDWR : O_RDONLY);
+		if (file < 0)
+			throw std::runtime_error("Unable to open matrix file.");
+
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(mat_file_header)))
+		{
+			close(file);
+			throw std::runtime_error("Not a matrix file.");
+		}
+		size = static_cast<std::uint64_t>(info.st_size);
+
+		int protect = mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+		int flags = mode == map_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+		void* view = mmap(nullptr, static_cast<std::size_t>(size), protect, flags, file, 0);
+		close(file);
+		if (view == MAP_FAILED)
+			throw std::runtime_error("Unable to map matrix file.");
+		m_view = view;
+#endif
+		m_size = static_cast<std::size_t>(size);
+
+		// Validate the header in place
+		const mat_file_header& header = *static_cast<const mat_file_header*>(m_view);
+		try
+		{
+			if (size > SIZE_MAX)
+				throw std::runtime_error("Matrix file is too large to map.");
+			validate_header<T>(header, size);
+		}
+		catch (...)
+		{
+			unmap();
+			throw;
+		}
+
+		m_rows = static_cast<unsigned int>(header.rows);
+		m_cols = static_cast<unsigned int>(header.cols);
+		m_layout = static_cast<storage_layout>(header.layout);
+		m_data = reinterpret_cast<T*>(static_cast<char*>(m_view) + header.data_offset);
+	}
+
+	/// <summary>
+	///   Unmaps the file, if mapped.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	void mapped_mat<T>::unmap(void)
+	{
+		if (m_view == nullptr)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_view);
+#else
+		munmap(m_view, m_size);
+#endif
+		m_view = nullptr;
+		m_data = nullptr;
+	}
+
+	/// <summary>
+	///   Gets a pointer to the elements, in the order of the layout.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Pointer to the first element.</returns>
+	template <typename T>
+	T* mapped_mat<T>::data(void)
+	{
+		return m_data;
+	}
+
+	/// <summary>
+	///   Gets a pointer to the elements, in the order of the layout.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Pointer to the first element.</returns>
+	template <typename T>
+	const T* mapped_mat<T>::data(void) const
+	{
+		return m_data;
+	}
+
+	/// <summary>
+	///   Copies the mapped elements into a matrix, one row at a time.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new matrix with the mapped elements.</returns>
+	template <typename T>
+	mat<T> mapped_mat<T>::to_mat(void) const
+	{
+		mat<T> result(m_rows, m_cols);
+
+		for (unsigned int i = 0; i < m_rows; i++)
+			if (m_layout == storage_layout::row_major)
+				std::copy(m_data + static_cast<std::size_t>(i) * m_cols, m_data + static_cast<std::size_t>(i + 1) * m_cols, result[i].begin());
+			else
+				for (unsigned int j = 0; j < m_cols; j++)
+					result[i][j] = (*this)(i, j);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Writes modified pages of a read-write mapping back to the file.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	void mapped_mat<T>::flush(void)
+	{
+		if (m_view == nullptr || m_mode != map_mode::read_write)
+			return;
+
+#ifdef _WIN32
+		if (!FlushViewOfFile(m_view, 0))
+#else
+		if (msync(m_view, m_size, MS_SYNC) != 0)
+#endif
+			throw std::runtime_error("Unable to write matrix file.");
+	}
+
+	/// <summary>
+	///   Gets the number of rows.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Number of rows.</returns>
+	template <typename T>
+	unsigned int mapped_mat<T>::rows(void) const
+	{
+		return m_rows;
+	}
+
+	/// <summary>
+	///   Gets the number of columns.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Number of columns.</returns>
+	template <typename T>
+	unsigned int mapped_mat<T>::cols(void) const
+	{
+		return m_cols;
+	}
+
+	/// <summary>
+	///   Gets the order of the elements in the file.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The storage layout.</returns>
+	template <typename T>
+	storage_layout mapped_mat<T>::layout(void) const
+	{
+		return m_layout;
+	}
+
+	/// <summary>
+	///   Gets the access to the mapped elements.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The mapping mode.</returns>
+	template <typename T>
+	map_mode mapped_mat<T>::mode(void) const
+	{
+		return m_mode;
+	}
+
+	/// <summary>
+	///   Accesses an element. Writing to a read-only mapping is an access
+	///   violation.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="row">Row of the element.</param>
+	/// <param name="col">Column of the element.</param>
+	/// <returns>Reference to the element.</returns>
+	template <typename T>
+	T& mapped_mat<T>::operator()(unsigned int row, unsigned int col)
+	{
+		if (m_layout == storage_layout::row_major)
+			return m_data[static_cast<std::size_t>(row) * m_cols + col];
+		return m_data[static_cast<std::size_t>(col) * m_rows + row];
+	}
+
+	/// <summary>
+	///   Accesses an element.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="row">Row of the element.</param>
+	/// <param name="col">Column of the element.</param>
+	/// <returns>Reference to the element.</returns>
+	template <typename T>
+	const T& mapped_mat<T>::operator()(unsigned int row, unsigned int col) const
+	{
+		if (m_layout == storage_layout::row_major)
+			return m_data[static_cast<std::size_t>(row) * m_cols + col];
+		return m_data[static_cast<std::size_t>(col) * m_rows + row];
+	}
+
+	/// <summary>
+	///   Writes a matrix to a file in the binary matrix format.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The matrix.</param>
+	/// <param name="path">Path of the file, which is replaced if it exists.</param>
+	/// <param name="layout">Order of the elements.</param>
+	template <typename T>
+	void save_binary(const mat<T>& m, const std::string& path, storage_layout layout)
+	{
+		mat_file_header header = make_header<T>(m.rows(), m.cols(), layout);
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (std::uint64_t i = sizeof(header); i < header.data_offset; i++)
+			file.put(0);
+
+		if (layout == storage_layout::row_major)
+			for (unsigned int i = 0; i < m.rows(); i++)
+				file.write(reinterpret_cast<const char*>(m[i].data()), static_cast<std::streamsize>(m.cols() * sizeof(T)));
+		else
+		{
+			std::vector<T> column(m.rows());
+			for (unsigned int j = 0; j < m.cols(); j++)
+			{
+				for (unsigned int i = 0; i < m.rows(); i++)
+					column[i] = m[i][j];
+				file.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(m.rows() * sizeof(T)));
+			}
+		}
+
+		file.close();
+		if (!file)
+			throw std::runtime_error("Unable to write matrix file.");
+	}
+
+	/// <summary>
+	///   Reads a matrix from a file in the binary matrix format, by mapping
+	///   the file and copying each row.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file.</param>
+	/// <returns>A new matrix with the elements of the file.</returns>
+	template <typename T>
+	mat<T> load_binary(const std::string& path)
+	{
+		return mapped_mat<T>(path).to_mat();
+	}
+
+	// Explicit template instantiations
+	template class mapped_mat<float>;
+	template class mapped_mat<double>;
+	template class mapped_mat<long double>;
+	template void save_binary(const mat<float>& m, const std::string& path, storage_layout layout);
+	template void save_binary(const mat<double>& m, const std::string& path, storage_layout layout);
+	template void save_binary(const mat<long double>& m, const std::string& path, storage_layout layout);
+	template mat<float> load_binary<float>(const std::string& path);
+	template mat<double> load_binary<double>(const std::string& path);
+	template mat<long double> load_binary<long double>(const std::string& path);
+}
@@ -21,11 +21,23 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
 */
-#include <ctime>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
 #include <stdexcept>
 #include "../inc/mat.hpp"
 #include "../inc/operators.hpp"
 #include "../inc/constants.hpp"
+#include "../inc/factorization.hpp"
+#include "../inc/half.hpp"
+#include "../inc/instrument.hpp"
+#include "../inc/linear_operator.hpp"
+#include "../inc/mapped.hpp"
+#include "../inc/packed.hpp"
+#include "../inc/scheduler.hpp"
+#include "../inc/structured.hpp"
+#include "../inc/tuning.hpp"
 
 namespace linmat {
 
@@ -63,6 +75,7 @@ namespace linmat {
 	template <typename T>
 	std::unique_ptr<mat<T>> mat<T>::unique_make_ones(unsigned int m, unsigned int n)
 	{
+		LINMAT_COUNT("mat::unique_make_ones", 0, sizeof(T) * m * n);
 		std::unique_ptr<mat<T>> obj = std::make_unique<mat<T>>(m, n);
 		for (unsigned int j = 0; j < m; j++)
 			std::fill((*obj)[j].begin(), (*obj)[j].end(), 1);
@@ -80,6 +93,7 @@ namespace linmat {
 	template <typename T>
 	std::unique_ptr<mat<T>> mat<T>::unique_make_zeros(unsigned int m, unsigned int n)
 	{
+		LINMAT_COUNT("mat::unique_make_zeros", 0, sizeof(T) * m * n);
 		std::unique_ptr<mat<T>> obj = std::make_unique<mat<T>>(m, n);
 		return obj;
 	}
@@ -94,6 +108,7 @@ namespace linmat {
 	template <typename T>
 	std::unique_ptr<mat<T>> mat<T>::unique_make_eye(unsigned int rows, unsigned int cols)
 	{
+		LINMAT_COUNT("mat::unique_make_eye", 0, sizeof(T) * rows * cols);
 		std::unique_ptr<mat<T>> obj = std::make_unique<mat<T>>(rows, cols);
 		for (unsigned int i = 0; i < rows && i < cols; i++)
 			(*obj)[i][i] = 1;
@@ -110,6 +125,7 @@ namespace linmat {
 	template <typename T>
 	mat<T> mat<T>::make_ones(unsigned int rows, unsigned int cols)
 	{
+		LINMAT_COUNT("mat::make_ones", 0, sizeof(T) * rows * cols);
 		mat<T> m(rows, cols);
 		for (unsigned int i = 0; i < rows; i++)
 			std::fill(m[i].begin(), m[i].end(), 1);
@@ -126,6 +142,7 @@ namespace linmat {
 	template <typename T>
 	mat<T> mat<T>::make_zeros(unsigned int rows, unsigned int cols)
 	{
+		LINMAT_COUNT("mat::make_zeros", 0, sizeof(T) * rows * cols);
 		mat<T> m(rows, cols);
 		return m;
 	}
@@ -140,12 +157,34 @@ namespace linmat {
 	template <typename T>
 	mat<T> mat<T>::make_eye(unsigned int rows, unsigned int cols)
 	{
+		LINMAT_COUNT("mat::make_eye", 0, sizeof(T) * rows * cols);
 		mat<T> m(rows, cols);
 		for (unsigned int i = 0; i < rows && i < cols; i++)
 			m[i][i] = 1;
 		return m;
 	}
 
+	/// <summary>
+	///   Factory function which returns a matrix with entries drawn from the
+	///   standard normal distribution.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="rows">Number of rows.</param>
+	/// <param name="cols">Number of columns.</param>
+	/// <param name="engine">The random number engine to draw entries from.</param>
+	/// <returns>A new matrix of normally distributed random entries.</returns>
+	template <typename T>
+	mat<T> mat<T>::make_randn(unsigned int rows, unsigned int cols, std::mt19937& engine)
+	{
+		LINMAT_COUNT("mat::make_randn", 0, sizeof(T) * rows * cols);
+		mat<T> m(rows, cols);
+		std::normal_distribution<double> distribution(0.0, 1.0);
+		for (unsigned int i = 0; i < rows; i++)
+			for (unsigned int j = 0; j < cols; j++)
+				m[i][j] = static_cast<T>(distribution(engine));
+		return m;
+	}
+
 	/// <summary>
 	///   Matrix default constructor.
 	/// </summary>
@@ -188,43 +227,339 @@ namespace linmat {
 	}
 
 	/// <summary>
-	///   Calculates matrix multiplication.
+	///   Matrix constructor from a file in the binary matrix format. The
+	///   file is memory-mapped and each row copied, without parsing.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file.</param>
+	template <typename T>
+	mat<T>::mat(const std::string& path)
+		: mat(load_binary<T>(path))
+	{
+	}
+
+	/// <summary>
+	///   Calculates matrix multiplication. The product is accumulated in 
+	///   blocks sized by the gemm_mc, gemm_kc and gemm_nc tuning parameters,
+	///   so that the block of the right matrix is reused from cache, and the
+	///   inner loop runs along rows of the right matrix and the result.
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	/// <param name="other">The matrix on the right side of the multiplication.</param>
 	/// <returns>A new matrix which is the product.</returns>
 	template <typename T>
-	mat<T> mat<T>::mult(const mat<T>& other)
+	mat<T> mat<T>::mult(const mat<T>& other) const
+	{
+		LINMAT_COUNT("mat::mult", 2.0 * m_rows * m_cols * other.cols(), sizeof(T) * m_rows * other.cols());
+		mat result(m_rows, other.cols());
+		unsigned int n = other.cols();
+		tuning_params params = tuning();
+
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		// Perform blocked matrix multiplication
+		for (unsigned int jj = 0; jj < n; jj += params.gemm_nc)
+		{
+			unsigned int j_end = std::min(n, jj + params.gemm_nc);
+			for (unsigned int kk = 0; kk < m_cols; kk += params.gemm_kc)
+			{
+				unsigned int k_end = std::min(m_cols, kk + params.gemm_kc);
+				for (unsigned int ii = 0; ii < m_rows; ii += params.gemm_mc)
+				{
+					unsigned int i_end = std::min(m_rows, ii + params.gemm_mc);
+					for (unsigned int i = ii; i < i_end; i++)
+					{
+						const T* a = (*this)[i].data();
+						T* c = result[i].data();
+						for (unsigned int k = kk; k < k_end; k++)
+						{
+							T a_ik = a[k];
+							const T* b = other[k].data();
+							for (unsigned int j = jj; j < j_end; j++)
+								c[j] += a_ik * b[j];
+						}
+					}
+				}
+			}
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Copies a block of a matrix, padding with zeros where the block 
+	///   extends past the last row or column.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The matrix to copy from.</param>
+	/// <param name="row">The first row of the block.</param>
+	/// <param name="col">The first column of the block.</param>
+	/// <param name="rows">Number of rows in the block.</param>
+	/// <param name="cols">Number of columns in the block.</param>
+	/// <returns>A new matrix which is the block.</returns>
+	template <typename T>
+	static mat<T> block_of(const mat<T>& m, unsigned int row, unsigned int col, unsigned int rows, unsigned int cols)
+	{
+		mat<T> result(rows, cols);
+
+		for (unsigned int i = 0; i < rows && row + i < m.rows(); i++)
+			for (unsigned int j = 0; j < cols && col + j < m.cols(); j++)
+				result[i][j] = m[row + i][col + j];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies two matrices with the Strassen-Winograd recursion, which
+	///   uses seven half-size products and fifteen additions at each level.
+	///   Odd dimensions are padded with zeros. Below the cutoff, the blocked
+	///   multiplication is used.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The left matrix.</param>
+	/// <param name="B">The right matrix.</param>
+	/// <param name="cutoff">Dimension below which the blocked multiplication is used.</param>
+	/// <param name="depth">Remaining depth at which products run as scheduler tasks.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	static mat<T> strassen_winograd(const mat<T>& A, const mat<T>& B, unsigned int cutoff, unsigned int depth)
+	{
+		unsigned int m = A.rows(), k = A.cols(), n = B.cols();
+
+		if (std::min(m, std::min(k, n)) <= cutoff)
+			return A.mult(B);
+
+		unsigned int mh = (m + 1) / 2, kh = (k + 1) / 2, nh = (n + 1) / 2;
+		mat<T> A11 = block_of(A, 0, 0, mh, kh), A12 = block_of(A, 0, kh, mh, kh);
+		mat<T> A21 = block_of(A, mh, 0, mh, kh), A22 = block_of(A, mh, kh, mh, kh);
+		mat<T> B11 = block_of(B, 0, 0, kh, nh), B12 = block_of(B, 0, nh, kh, nh);
+		mat<T> B21 = block_of(B, kh, 0, kh, nh), B22 = block_of(B, kh, nh, kh, nh);
+
+		// Winograd's sums of the quadrants
+		mat<T> S1 = A21 + A22;
+		mat<T> S2 = S1 - A11;
+		mat<T> S3 = A11 - A21;
+		mat<T> S4 = A12 - S2;
+		mat<T> T1 = B12 - B11;
+		mat<T> T2 = B22 - T1;
+		mat<T> T3 = B22 - B12;
+		mat<T> T4 = T2 - B21;
+
+		// The seven products, as scheduler tasks near the top of the recursion
+		const mat<T>* lhs[7] = { &A11, &A12, &S4, &A22, &S1, &S2, &S3 };
+		const mat<T>* rhs[7] = { &B11, &B21, &B22, &T4, &T1, &T2, &T3 };
+		mat<T> P[7];
+		if (depth > 0)
+		{
+			task_group group;
+			for (unsigned int p = 0; p < 7; p++)
+				group.run([&P, &lhs, &rhs, p, cutoff, depth]()
+					{
+						P[p] = strassen_winograd(*lhs[p], *rhs[p], cutoff, depth - 1);
+					});
+			group.wait();
+		}
+		else
+			for (unsigned int p = 0; p < 7; p++)
+				P[p] = strassen_winograd(*lhs[p], *rhs[p], cutoff, 0);
+
+		// Combine the products into the quadrants of the result
+		mat<T> U2 = P[0] + P[5];
+		mat<T> U3 = U2 + P[6];
+		mat<T> U4 = U2 + P[4];
+		mat<T> C11 = P[0] + P[1];
+		mat<T> C12 = U4 + P[2];
+		mat<T> C21 = U3 - P[3];
+		mat<T> C22 = U3 + P[4];
+
+		mat<T> result(m, n);
+		for (unsigned int i = 0; i < m; i++)
+		{
+			const mat<T>& top = i < mh ? C11 : C21;
+			const mat<T>& right = i < mh ? C12 : C22;
+			unsigned int r = i < mh ? i : i - mh;
+			for (unsigned int j = 0; j < n; j++)
+				result[i][j] = j < nh ? top[r][j] : right[r][j - nh];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates matrix multiplication with the selected algorithm.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The matrix on the right side of the multiplication.</param>
+	/// <param name="algorithm">The multiplication algorithm.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> mat<T>::mult(const mat<T>& other, mult_algorithm algorithm) const
+	{
+		LINMAT_COUNT("mat::mult(algorithm)", 0, 0);
+		if (algorithm == mult_algorithm::strassen)
+			return mult_strassen(other, tuning().strassen_cutoff);
+
+		return mult(other);
+	}
+
+	/// <summary>
+	///   Calculates matrix multiplication with the Strassen-Winograd 
+	///   algorithm, in O(n^2.81) operations. The error is bounded in norm,
+	///   ||C - AB|| <= c.n^3.58.u.||A||.||B||, rather than for each element as
+	///   with the blocked multiplication. Elements of the product much 
+	///   smaller than ||A||.||B|| may therefore lose relative accuracy, 
+	///   particularly when the rows of A or columns of B are badly scaled.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The matrix on the right side of the multiplication.</param>
+	/// <param name="cutoff">Dimension below which the blocked multiplication is used.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> mat<T>::mult_strassen(const mat<T>& other, unsigned int cutoff) const
+	{
+		LINMAT_COUNT("mat::mult_strassen", 0, sizeof(T) * m_rows * other.cols());
+		unsigned int depth = 0;
+
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		// Large products run the top levels of the recursion in parallel
+		if (std::max(m_rows, other.cols()) >= tuning().parallel_threshold)
+			depth = constants::STRASSEN_PARALLEL_DEPTH;
+
+		return strassen_winograd(*this, other, std::max(cutoff, 1u), depth);
+	}
+
+	/// <summary>
+	///   Multiplies the matrix on the right by a diagonal matrix, scaling its
+	///   columns in O(mn) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> mat<T>::mult(const diag_mat<T>& other) const
+	{
+		LINMAT_COUNT("mat::mult(diag_mat)", 1.0 * m_rows * m_cols, sizeof(T) * m_rows * m_cols);
+		mat result(*this);
+
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int j = 0; j < m_cols; j++)
+				result[i][j] *= other[j];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies the matrix on the right by a scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> mat<T>::mult(const identity<T>& other) const
+	{
+		LINMAT_COUNT("mat::mult(identity)", 1.0 * m_rows * m_cols, sizeof(T) * m_rows * m_cols);
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		return (*this) * other.scale();
+	}
+
+	/// <summary>
+	///   Multiplies the matrix on the right by a permutation matrix, 
+	///   reordering its columns.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> mat<T>::mult(const perm_mat<T>& other) const
+	{
+		LINMAT_COUNT("mat::mult(perm_mat)", 0, sizeof(T) * m_rows * m_cols);
+		mat result(m_rows, m_cols);
+		const std::vector<unsigned int>& p = other.permutation();
+
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		// Column k of the matrix moves to column p[k]
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int k = 0; k < m_cols; k++)
+				result[i][p[k]] = (*this)[i][k];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies the matrix on the right by a constant matrix. Every 
+	///   column of the product is the row sums, scaled by the value.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> mat<T>::mult(const const_mat<T>& other) const
 	{
+		LINMAT_COUNT("mat::mult(const_mat)", 1.0 * m_rows * m_cols, sizeof(T) * m_rows * other.cols());
 		mat result(m_rows, other.cols());
 
 		// Validate arguments
 		if (m_cols != other.rows())
 			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
 
-		// Perform matrix multiplication
 		for (unsigned int i = 0; i < m_rows; i++)
-			for (unsigned int j = 0; j < other.cols(); j++)
-				for (unsigned int k = 0; k < m_cols; k++)
-					result[i][j] += (*this)[i][k] * other[k][j];
+		{
+			T s = 0;
+			for (unsigned int k = 0; k < m_cols; k++)
+				s += (*this)[i][k];
+			std::fill(result[i].begin(), result[i].end(), s * other.value());
+		}
 
 		return result;
 	}
 
 	/// <summary>
-	///   Calculates the matrix raised to a power.
+	///   Calculates the matrix raised to a power by repeated squaring, using
+	///   O(log n) multiplications.
 	/// </summary>
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <param name="n">The power to raise the matrix to.</param>
 	/// <returns>A new matrix which is the original matrix raised to a power.</returns>
 	template <typename T>
-	mat<T> mat<T>::pow(unsigned int n)
+	mat<T> mat<T>::pow(unsigned int n) const
 	{
-		mat<T> result = mat<T>::make_eye(m_rows, m_cols);
+		LINMAT_COUNT("mat::pow", 0, 0);
+		// Enforce square matrix
+		if (m_cols != m_rows)
+			throw std::runtime_error("Matrix power is undefined for a rectangular matrix.");
 
-		// Calculate power
-		for (unsigned int i = 0; i < n; i++)
-			result = result.mult((*this));
+		if (n == 0)
+			return mat<T>::make_eye(m_rows, m_cols);
+
+		// Multiply the result by the squares selected by the bits of n
+		mat<T> square(*this);
+		while (n % 2 == 0)
+		{
+			square = square.mult(square);
+			n /= 2;
+		}
+		mat<T> result(square);
+		for (n /= 2; n > 0; n /= 2)
+		{
+			square = square.mult(square);
+			if (n % 2 == 1)
+				result = result.mult(square);
+		}
 
 		return result;
 	}
@@ -235,8 +570,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>The scalar valued trace of the matrix.</returns>
 	template <typename T>
-	T mat<T>::trace(void)
+	T mat<T>::trace(void) const
 	{
+		LINMAT_COUNT("mat::trace", m_rows, 0);
 		T result = 0;
 
 		// Calculate the trace as the sum of the diagonals
@@ -252,8 +588,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>A new matrix which is the transpose.</returns>
 	template <typename T>
-	mat<T> mat<T>::transpose(void)
+	mat<T> mat<T>::transpose(void) const
 	{
+		LINMAT_COUNT("mat::transpose", 0, sizeof(T) * m_rows * m_cols);
 		mat result(m_cols, m_rows);
 
 		// Swap elements
@@ -264,14 +601,72 @@ namespace linmat {
 		return result;
 	}
 
+	/// <summary>
+	///   Calculates the Gram matrix A^T.A, computing the upper triangle from
+	///   the rank-1 contribution of each row and mirroring it to the lower.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new symmetric nxn matrix.</returns>
+	template <typename T>
+	mat<T> mat<T>::gram(void) const
+	{
+		LINMAT_COUNT("mat::gram", 1.0 * m_rows * m_cols * (m_cols + 1), sizeof(T) * m_cols * m_cols);
+		mat result = mat<T>::make_zeros(m_cols, m_cols);
+
+		// Accumulate the upper triangle one row at a time
+		for (unsigned int k = 0; k < m_rows; k++)
+		{
+			const std::vector<T>& row = (*this)[k];
+			for (unsigned int i = 0; i < m_cols; i++)
+			{
+				T a = row[i];
+				for (unsigned int j = i; j < m_cols; j++)
+					result[i][j] += a * row[j];
+			}
+		}
+
+		// Mirror to the lower triangle
+		for (unsigned int i = 0; i < m_cols; i++)
+			for (unsigned int j = 0; j < i; j++)
+				result[i][j] = result[j][i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the outer Gram matrix A.A^T, computing the lower triangle
+	///   from the dot products of rows and mirroring it to the upper.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new symmetric mxm matrix.</returns>
+	template <typename T>
+	mat<T> mat<T>::outer_gram(void) const
+	{
+		LINMAT_COUNT("mat::outer_gram", 1.0 * m_cols * m_rows * (m_rows + 1), sizeof(T) * m_rows * m_rows);
+		mat result(m_rows, m_rows);
+
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				T s = 0;
+				for (unsigned int k = 0; k < m_cols; k++)
+					s += (*this)[i][k] * (*this)[j][k];
+				result[i][j] = s;
+				result[j][i] = s;
+			}
+
+		return result;
+	}
+
 	/// <summary>
 	///   Calculates the Frobenius norm.
 	/// </summary>
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>Scalar valued norm of the matrix.</returns>
 	template <typename T>
-	T mat<T>::frobenius_norm(void)
+	T mat<T>::frobenius_norm(void) const
 	{
+		LINMAT_COUNT("mat::frobenius_norm", 2.0 * m_rows * m_cols, 0);
 		T result = 0;
 
 		// Calculate the Frobenius norm
@@ -283,37 +678,73 @@ namespace linmat {
 	}
 
 	/// <summary>
-	///   Calculates the spectral (l2) norm of the matrix. 
+	///   Calculates the 1-norm, the maximum absolute column sum.
 	/// </summary>
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
-	/// <returns>The scalar valued spectral norm.</returns>
+	/// <returns>Scalar valued norm of the matrix.</returns>
 	template <typename T>
-	T mat<T>::spectral_norm(void)
+	T mat<T>::norm_1(void) const
 	{
-		// The spectral norm of matrix A can be found from the square-root of 
-		// the largest eigenvalue of (A^T).(A)
-		mat<T> b_k(m_rows, 1);
-		mat<T> At = (*this).transpose();
-		T lambda_max;
+		LINMAT_COUNT("mat::norm_1", 1.0 * m_rows * m_cols, 0);
+		std::vector<T> sums(m_cols);
 
-		// Initialize random number generator
-		std::srand(static_cast<unsigned int>(std::time(0)));
+		// Accumulate column sums a row at a time
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int j = 0; j < m_cols; j++)
+				sums[j] += std::fabs((*this)[i][j]);
 
-		// Randomize initial guess 
-		for (unsigned int i = 0; i < m_cols; i++)
-			b_k[i][0] = static_cast<T>(rand()) / RAND_MAX;
+		return sums.empty() ? 0 : *std::max_element(sums.begin(), sums.end());
+	}
+
+	/// <summary>
+	///   Calculates the infinity norm, the maximum absolute row sum.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T mat<T>::norm_inf(void) const
+	{
+		LINMAT_COUNT("mat::norm_inf", 1.0 * m_rows * m_cols, 0);
+		T result = 0;
 
-		// Largest eigenvalue by power iteration
-		for (unsigned int i = 0; i < constants::MAX_ITER; i++)
+		for (unsigned int i = 0; i < m_rows; i++)
 		{
-			b_k = At.mult((*this).mult(b_k / b_k.frobenius_norm()));
+			T sum = 0;
+			for (unsigned int j = 0; j < m_cols; j++)
+				sum += std::fabs((*this)[i][j]);
+			result = std::max(result, sum);
 		}
 
-		// Find the largest eigenvalue
-		lambda_max = b_k.frobenius_norm();
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the spectral (l2) norm of the matrix. The initial guess
+	///   is drawn from an engine local to the call, seeded with a fixed seed,
+	///   so the result is reproducible and the method is thread-safe.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The scalar valued spectral norm.</returns>
+	template <typename T>
+	T mat<T>::spectral_norm(void) const
+	{
+		LINMAT_COUNT("mat::spectral_norm", 0, 0);
+		std::mt19937 engine(constants::RNG_SEED);
+		return spectral_norm(engine);
+	}
 
-		// Return square root
-		return std::sqrt(lambda_max);
+	/// <summary>
+	///   Calculates the spectral (l2) norm of the matrix, drawing the initial
+	///   guess from the given engine.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="engine">The random number engine, owned by the caller.</param>
+	/// <returns>The scalar valued spectral norm.</returns>
+	template <typename T>
+	T mat<T>::spectral_norm(std::mt19937& engine) const
+	{
+		LINMAT_COUNT("mat::spectral_norm(engine)", 0, 0);
+		return linmat::spectral_norm<T>(dense_operator<T>(*this), engine);
 	}
 
 	/// <summary>
@@ -322,8 +753,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>The matrix determinant.</returns>
 	template <typename T>
-	T mat<T>::det_2(void)
+	T mat<T>::det_2(void) const
 	{
+		LINMAT_COUNT("mat::det_2", 3, 0);
 		// Enforce 2x2 condition
 		if (m_rows != 2 || m_cols != 2)
 			throw std::runtime_error("Requires 2x2 matrix.");
@@ -339,8 +771,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>The matrix determinant.</returns>
 	template <typename T>
-	T mat<T>::det_3(void)
+	T mat<T>::det_3(void) const
 	{
+		LINMAT_COUNT("mat::det_3", 17, 0);
 		// Enforce 3x3 condition
 		if (m_rows != 3 || m_cols != 3)
 			throw std::runtime_error("Requires 3x3 matrix.");
@@ -361,8 +794,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>The matrix inverse.</returns>
 	template <typename T>
-	mat<T> mat<T>::inv_2(void)
+	mat<T> mat<T>::inv_2(void) const
 	{
+		LINMAT_COUNT("mat::inv_2", 10, sizeof(T) * 4);
 		mat<T> m(m_rows, m_cols);
 		T det;
 
@@ -393,8 +827,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>The matrix inverse.</returns>
 	template <typename T>
-	mat<T> mat<T>::inv_3(void)
+	mat<T> mat<T>::inv_3(void) const
 	{
+		LINMAT_COUNT("mat::inv_3", 50, sizeof(T) * 9);
 		mat<T> m(m_rows, m_cols);
 		T det;
 
@@ -430,8 +865,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>A new matrix which is the inverse</returns>
 	template <typename T>
-	mat<T> mat<T>::inv(void)
+	mat<T> mat<T>::inv(void) const
 	{
+		LINMAT_COUNT("mat::inv", m_rows <= tuning().inv_iterative_threshold ? 2.0 * m_rows * m_rows * m_rows : 0.0, sizeof(T) * m_rows * m_cols);
 		mat<T> m(m_rows, m_cols);
 
 		// If 2x2
@@ -440,6 +876,9 @@ namespace linmat {
 		// If 3x3
 		else if (m_rows == 3 && m_cols == 3)
 			m = inv_3();
+		// If small enough for direct factorization
+		else if (m_rows == m_cols && m_rows <= tuning().inv_iterative_threshold)
+			m = lu_factorization<T>(*this).inverse();
 		// Otherwise
 		else
 			m = inv_shulz();
@@ -453,35 +892,59 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>A new matrix which is the inverse</returns>
 	template <typename T>
-	mat<T> mat<T>::inv_shulz(void)
+	mat<T> mat<T>::inv_shulz(void) const
+	{
+		LINMAT_COUNT("mat::inv_shulz", 0, 0);
+		return inv_hyperpower(2);
+	}
+
+	/// <summary>
+	///     Calculates the inverse of the matrix using the hyperpower iteration
+	///     of order 2 (Newton-Schulz), 3 or 4. The initial guess is the 
+	///     transpose scaled by 1 / (||A||_1.||A||_inf), which bounds the 
+	///     reciprocal squared spectral norm without iterating. Throws if the
+	///     iteration diverges or reaches the iteration limit, as it does for
+	///     a singular matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="order">Order of the iteration, from 2 to 4.</param>
+	/// <returns>A new matrix which is the inverse</returns>
+	template <typename T>
+	mat<T> mat<T>::inv_hyperpower(unsigned int order) const
 	{
-		mat<T> X(m_rows, m_cols);
-		mat<T> X_1(m_rows, m_cols);
-		mat<T> D(m_rows, m_cols);
-		mat<T> I = mat<T>::make_eye(m_rows, m_cols);
-		float done = false;
+		LINMAT_COUNT("mat::inv_hyperpower", 0, sizeof(T) * m_rows * m_cols);
+		// Enforce square matrix
+		if (m_cols != m_rows)
+			throw std::runtime_error("Inverse is undefined for a rectangular matrix.");
 
-		// Find alpha
-		T alpha = static_cast<T>(0.5 * 2 / std::pow(spectral_norm(), 2));
-		
 		// Set the initial conditions for X
-		X = transpose() * alpha;
+		T scale = norm_1() * norm_inf();
+		if (scale == 0)
+			throw std::runtime_error("Matrix is singular.");
+		mat<T> X = transpose() / scale;
 
-		// Find matrix inverse by Schulz iteration
-		for (unsigned int i = 0; i < constants::MAX_ITER && !done; i++)
-		{
-			X_1 = ((I * static_cast<T>(2) - X.mult(*this)).mult(X));
-			D = (X_1 - X) / X;
-			X = X_1;
+		solver_result result = linmat::inv_hyperpower<T>(dense_operator<T>(*this), X, order);
+		if (!result.converged)
+			throw std::runtime_error("Iteration did not converge.");
 
-			// Evaluate convergence
-			done = true;
-			for (unsigned int i = 0; i < m_rows; i++)
-				for (unsigned int j = 0; j < m_cols; j++)
-					if (std::abs(D[i][j]) > constants::CONV_TOL)
-						done = false;
-		}
+		return X;
+	}
 
+	/// <summary>
+	///     Calculates the inverse of a matrix which has changed slightly since
+	///     its previous inverse was found, by warm starting Newton-Schulz 
+	///     iteration from the previous inverse. Falls back to LU factorization
+	///     if the iteration would diverge.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="prev_inverse">The inverse of the matrix before it changed.</param>
+	/// <returns>A new matrix which is the inverse</returns>
+	template <typename T>
+	mat<T> mat<T>::inv_update(const mat<T>& prev_inverse) const
+	{
+		LINMAT_COUNT("mat::inv_update", 0, sizeof(T) * m_rows * m_cols);
+		mat<T> X = prev_inverse;
+		linmat::inv_update<T>(*this, X);
 		return X;
 	}
 
@@ -501,7 +964,7 @@ namespace linmat {
 		std::vector<unsigned int> &p,
 		std::vector<std::vector<unsigned int>>& ps,
 		std::vector<T> &ss,
-		T& s)
+		T& s) const
 	{
 		// Base case
 		if (k == 1)
@@ -537,8 +1000,9 @@ namespace linmat {
 	/// <typeparam name="T"></typeparam>
 	/// <returns>The determinant.</returns>
 	template <typename T>
-	T mat<T>::det_leibniz(void)
+	T mat<T>::det_leibniz(void) const
 	{
+		LINMAT_COUNT("mat::det_leibniz", 0, 0);
 		std::vector<std::vector<unsigned int>> ps;
 		std::vector<unsigned int> p0;
 		std::vector<T> ss; 
@@ -573,8 +1037,9 @@ namespace linmat {
 	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
 	/// <returns>The determinant.</returns>
 	template <typename T>
-	T mat<T>::det(void)
+	T mat<T>::det(void) const
 	{
+		LINMAT_COUNT("mat::det", 0, 0);
 		T result;
 
 		// If 2x2
@@ -599,8 +1064,9 @@ namespace linmat {
 	/// <param name="L">An empty matrix L which will be written to.</param>
 	/// <param name="U">An empty matrix U which will be written to.</param>
 	template <typename T>
-	void mat<T>::lu_decomposition(mat<T>& L,mat<T>& U)
+	void mat<T>::lu_decomposition(mat<T>& L,mat<T>& U) const
 	{
+		LINMAT_COUNT("mat::lu_decomposition", 2.0 * m_rows * m_rows * m_rows / 3, sizeof(T) * 2 * m_rows * m_cols);
 		// Enforce square matrix
 		if (m_cols != m_rows)
 			throw std::runtime_error("LU decomposition is undefined for a rectangular matrix.");
@@ -627,17 +1093,89 @@ namespace linmat {
 		}
 	}
 
+	/// <summary>
+	///   Performs LU decomposition of the matrix into packed triangular 
+	///   factors, which together hold n^2 + n entries rather than 2n^2. This
+	///   uses the compact form of the Doolittle algorithm, so L has a unit 
+	///   diagonal and the factors match the dense overload.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="L">A lower triangular matrix L which will be written to.</param>
+	/// <param name="U">An upper triangular matrix U which will be written to.</param>
+	template <typename T>
+	void mat<T>::lu_decomposition(tri_mat<T>& L, tri_mat<T>& U) const
+	{
+		LINMAT_COUNT("mat::lu_decomposition(tri_mat)", 2.0 * m_rows * m_rows * m_rows / 3, sizeof(T) * m_rows * (m_rows + 1));
+		// Enforce square matrix
+		if (m_cols != m_rows)
+			throw std::runtime_error("LU decomposition is undefined for a rectangular matrix.");
+
+		// Handle edge case
+		if (m_cols < 2)
+			throw std::runtime_error("Matrix dimensions must be greater than one.");
+
+		L = tri_mat<T>(m_rows, true);
+		U = tri_mat<T>(m_rows, false);
+
+		for (unsigned int i = 0; i < m_rows; i++)
+		{
+			// Row i of U
+			for (unsigned int j = i; j < m_rows; j++)
+			{
+				T s = (*this)[i][j];
+				for (unsigned int k = 0; k < i; k++)
+					s -= L(i, k) * U(k, j);
+				U(i, j) = s;
+			}
+
+			// Column i of L
+			L(i, i) = 1;
+			for (unsigned int j = i + 1; j < m_rows; j++)
+			{
+				T s = (*this)[j][i];
+				for (unsigned int k = 0; k < i; k++)
+					s -= L(j, k) * U(k, i);
+				L(j, i) = s / U(i, i);
+			}
+		}
+	}
+
+	/// <summary>
+	///   Performs Cholesky decomposition of the Hermitian positive-definite
+	///   matrix into a packed lower triangular factor, such that A = LL^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="L">A lower triangular matrix L which will be written to.</param>
+	template <typename T>
+	void mat<T>::cholesky_decomposition(tri_mat<T>& L) const
+	{
+		LINMAT_COUNT("mat::cholesky_decomposition(tri_mat)", 1.0 * m_rows * m_rows * m_rows / 3, sizeof(T) * m_rows * (m_rows + 1) / 2);
+		// Enforce square matrix
+		if (m_cols != m_rows)
+			throw std::runtime_error("Cholesky decomposition is undefined for a rectangular matrix.");
+
+		// Enforce Hermitian
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int j = 0; j <= i; j++)
+				if ((*this)[i][j] != (*this)[j][i])
+					throw std::runtime_error("Matrix must be Hermitian.");
+
+		sym_mat<T>(*this).cholesky_decomposition(L);
+	}
+
 	/// <summary>
 	///   Performs Cholesky decomposition (factorization) of the Hermitian 
 	///   positive-definite matrix into a lower triangular matrix L, such 
 	///   that A = LL^T. This implementation uses the Cholesky-Banachiewicz 
-	///   algorithm.
+	///   algorithm, or the tiled decomposition for large matrices. Both 
+	///   throw if the matrix is not positive-definite.
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	/// <param name="L">An empty matrix L which will be written to.</param>
 	template <typename T>
-	void mat<T>::cholesky_decomposition(mat<T>& L)
+	void mat<T>::cholesky_decomposition(mat<T>& L) const
 	{
+		LINMAT_COUNT("mat::cholesky_decomposition", 1.0 * m_rows * m_rows * m_rows / 3, sizeof(T) * m_rows * m_cols);
 		T s;
 
 		// Enforce square matrix
@@ -654,6 +1192,14 @@ namespace linmat {
 		if (m_cols < 2)
 			throw std::runtime_error("Matrix dimensions must be greater than one.");
 
+		// Large matrices are factorized by tiles in parallel
+		tuning_params params = tuning();
+		if (m_rows >= params.parallel_threshold && m_rows >= 2 * params.cholesky_tile)
+		{
+			cholesky_decomposition_tiled(L, params.cholesky_tile);
+			return;
+		}
+
 		// Initialize L and U
 		L = mat<T>::make_zeros(m_rows, m_cols);;
 
@@ -667,16 +1213,332 @@ namespace linmat {
 				for (unsigned int k = 0; k < j; k++)
 					s += L[i][k] * L[j][k];
 				if (i == j)
+				{
+					if (!((*this)[i][j] - s > 0))
+						throw std::runtime_error("Matrix must be positive-definite.");
 					L[i][j] = std::sqrt((*this)[i][j] - s);
+				}
 				else
 					L[i][j] = ((*this)[i][j] - s) / L[j][j];
 			}
 		}
 	}
 
+	/// <summary>
+	///   Performs Cholesky decomposition of the Hermitian positive-definite
+	///   matrix by square tiles, as a graph of tasks on the work-stealing 
+	///   scheduler. Each tile of L is factorized once the updates from the
+	///   tiles to its left are applied, so the factorization of a panel
+	///   overlaps the updates of the trailing matrix by earlier panels.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="L">An empty matrix L which will be written to.</param>
+	/// <param name="tile">The order of each tile.</param>
+	template <typename T>
+	void mat<T>::cholesky_decomposition_tiled(mat<T>& L, unsigned int tile) const
+	{
+		LINMAT_COUNT("mat::cholesky_decomposition_tiled", 1.0 * m_rows * m_rows * m_rows / 3, sizeof(T) * m_rows * m_cols);
+		// Enforce square matrix
+		if (m_cols != m_rows)
+			throw std::runtime_error("Cholesky decomposition is undefined for a rectangular matrix.");
+
+		// Enforce Hermitian
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int j = 0; j <= i; j++)
+				if ((*this)[i][j] != (*this)[j][i])
+					throw std::runtime_error("Matrix must be Hermitian.");
+
+		unsigned int n = m_rows;
+		unsigned int b = std::max(tile, 1u);
+		unsigned int tiles = (n + b - 1) / b;
+
+		// Lower triangle of the matrix is factorized in place
+		L = mat<T>::make_zeros(n, n);
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+				L[i][j] = (*this)[i][j];
+
+		// Factorizes the diagonal tile k
+		auto potrf = [&L, n, b](unsigned int k)
+		{
+			LINMAT_TRACE_SCOPE("cholesky_tiled::potrf");
+			unsigned int k0 = k * b, k1 = std::min(n, k0 + b);
+			for (unsigned int i = k0; i < k1; i++)
+				for (unsigned int j = k0; j <= i; j++)
+				{
+					T s = L[i][j];
+					for (unsigned int p = k0; p < j; p++)
+						s -= L[i][p] * L[j][p];
+					if (i == j)
+					{
+						if (!(s > 0))
+							throw std::runtime_error("Matrix must be positive-definite.");
+						L[i][j] = std::sqrt(s);
+					}
+					else
+						L[i][j] = s / L[j][j];
+				}
+		};
+
+		// Solves tile (i, k) against the factorized diagonal tile k
+		auto trsm = [&L, n, b](unsigned int i, unsigned int k)
+		{
+			LINMAT_TRACE_SCOPE("cholesky_tiled::trsm");
+			unsigned int i0 = i * b, i1 = std::min(n, i0 + b);
+			unsigned int k0 = k * b, k1 = std::min(n, k0 + b);
+			for (unsigned int r = i0; r < i1; r++)
+				for (unsigned int j = k0; j < k1; j++)
+				{
+					T s = L[r][j];
+					for (unsigned int p = k0; p < j; p++)
+						s -= L[r][p] * L[j][p];
+					L[r][j] = s / L[j][j];
+				}
+		};
+
+		// Subtracts L(i, k).L(j, k)^T from tile (i, j)
+		auto update = [&L, n, b](unsigned int i, unsigned int j, unsigned int k)
+		{
+			LINMAT_TRACE_SCOPE("cholesky_tiled::update");
+			unsigned int i0 = i * b, i1 = std::min(n, i0 + b);
+			unsigned int j0 = j * b, j1 = std::min(n, j0 + b);
+			unsigned int k0 = k * b, k1 = std::min(n, k0 + b);
+			for (unsigned int r = i0; r < i1; r++)
+			{
+				const T* lr = L[r].data();
+				for (unsigned int c = j0; c < j1 && c <= r; c++)
+				{
+					const T* lc = L[c].data();
+					T s = 0;
+					for (unsigned int p = k0; p < k1; p++)
+						s += lr[p] * lc[p];
+					L[r][c] -= s;
+				}
+			}
+		};
+
+		// Build the task graph, with the updates of each tile in order
+		task_graph graph;
+		std::vector<std::vector<unsigned int>> last(tiles, std::vector<unsigned int>(tiles));
+		std::vector<std::vector<bool>> updated(tiles, std::vector<bool>(tiles, false));
+		auto after = [&last, &updated](unsigned int i, unsigned int j, std::vector<unsigned int> dependencies)
+		{
+			if (updated[i][j])
+				dependencies.push_back(last[i][j]);
+			return dependencies;
+		};
+
+		for (unsigned int k = 0; k < tiles; k++)
+		{
+			unsigned int factor = graph.add([potrf, k]() { potrf(k); }, after(k, k, {}));
+			std::vector<unsigned int> solved(tiles);
+			for (unsigned int i = k + 1; i < tiles; i++)
+				solved[i] = graph.add([trsm, i, k]() { trsm(i, k); }, after(i, k, { factor }));
+			for (unsigned int i = k + 1; i < tiles; i++)
+				for (unsigned int j = k + 1; j <= i; j++)
+				{
+					std::vector<unsigned int> dependencies{ solved[i] };
+					if (j != i)
+						dependencies.push_back(solved[j]);
+					last[i][j] = graph.add([update, i, j, k]() { update(i, j, k); }, after(i, j, dependencies));
+					updated[i][j] = true;
+				}
+		}
+
+		graph.run();
+	}
+
+	/// <summary>
+	///   Performs the thin QR decomposition (factorization) of the mxn matrix,
+	///   with m >= n, into a matrix Q with orthonormal columns and an upper
+	///   triangular matrix R, such that A = QR. This implementation uses 
+	///   modified Gram-Schmidt with a second reorthogonalization pass.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="Q">An empty mxn matrix Q which will be written to.</param>
+	/// <param name="R">An empty nxn matrix R which will be written to.</param>
+	template <typename T>
+	void mat<T>::qr_decomposition(mat<T>& Q, mat<T>& R) const
+	{
+		LINMAT_COUNT("mat::qr_decomposition", 4.0 * m_rows * m_cols * m_cols, sizeof(T) * (m_rows * m_cols + m_cols * m_cols));
+		// Enforce tall or square matrix
+		if (m_rows < m_cols)
+			throw std::runtime_error("QR decomposition requires rows greater than or equal to columns.");
+
+		// Work on the columns of A as rows of the transpose
+		mat<T> W = transpose();
+		R = mat<T>::make_zeros(m_cols, m_cols);
+
+		// For each column
+		for (unsigned int j = 0; j < m_cols; j++)
+		{
+			// Remove components along previous columns, twice for stability
+			for (unsigned int pass = 0; pass < 2; pass++)
+			{
+				for (unsigned int k = 0; k < j; k++)
+				{
+					T r = 0;
+					for (unsigned int i = 0; i < m_rows; i++)
+						r += W[k][i] * W[j][i];
+					for (unsigned int i = 0; i < m_rows; i++)
+						W[j][i] -= r * W[k][i];
+					R[k][j] += r;
+				}
+			}
+
+			// Normalize, leaving a zero column if linearly dependent
+			T norm = 0;
+			for (unsigned int i = 0; i < m_rows; i++)
+				norm += W[j][i] * W[j][i];
+			norm = std::sqrt(norm);
+			R[j][j] = norm;
+			for (unsigned int i = 0; i < m_rows; i++)
+				W[j][i] = (norm > 0) ? W[j][i] / norm : 0;
+		}
+
+		Q = W.transpose();
+	}
+
+	/// <summary>
+	///   Performs the thin singular value decomposition of the mxn matrix 
+	///   into U, S and V such that A = U.S.V^T, where S is a diagonal matrix
+	///   of singular values in descending order. This implementation uses
+	///   the one-sided Jacobi method, which rotates a pair of columns until
+	///   their inner product is within m.eps of the product of their norms,
+	///   with the machine epsilon of T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="U">An empty matrix U which will be written to with the 
+	///   left singular vectors.</param>
+	/// <param name="S">An empty matrix S which will be written to with the
+	///   singular values.</param>
+	/// <param name="V">An empty matrix V which will be written to with the
+	///   right singular vectors.</param>
+	template <typename T>
+	void mat<T>::svd(mat<T>& U, mat<T>& S, mat<T>& V) const
+	{
+		LINMAT_COUNT("mat::svd", 0, 0);
+		// Wide matrices are decomposed through their transpose
+		if (m_rows < m_cols)
+		{
+			transpose().svd(V, S, U);
+			return;
+		}
+
+		// Columns of A are stored as rows of W, and columns of V as rows of Vt
+		unsigned int n = m_cols;
+		mat<T> W = transpose();
+		mat<T> Vt = mat<T>::make_eye(n, n);
+		T tol = static_cast<T>(m_rows) * std::numeric_limits<T>::epsilon();
+		bool done = false;
+
+		// Orthogonalize pairs of columns by plane rotations
+		for (unsigned int sweep = 0; sweep < constants::MAX_ITER && !done; sweep++)
+		{
+			LINMAT_TRACE_ITERATION("svd", sweep);
+			done = true;
+			for (unsigned int p = 0; p + 1 < n; p++)
+			{
+				for (unsigned int q = p + 1; q < n; q++)
+				{
+					T alpha = 0, beta = 0, gamma = 0;
+					for (unsigned int i = 0; i < m_rows; i++)
+					{
+						alpha += W[p][i] * W[p][i];
+						beta += W[q][i] * W[q][i];
+						gamma += W[p][i] * W[q][i];
+					}
+
+					// Skip columns which are already orthogonal
+					if (gamma == 0 || std::fabs(gamma) <= tol * std::sqrt(alpha * beta))
+						continue;
+					done = false;
+
+					// Calculate the rotation
+					T zeta = (beta - alpha) / (2 * gamma);
+					T t = ((zeta < 0) ? -1 : 1) / (std::fabs(zeta) + std::sqrt(1 + zeta * zeta));
+					T c = 1 / std::sqrt(1 + t * t);
+					T s = c * t;
+
+					// Apply the rotation to A and V
+					for (unsigned int i = 0; i < m_rows; i++)
+					{
+						T wp = W[p][i];
+						W[p][i] = c * wp - s * W[q][i];
+						W[q][i] = s * wp + c * W[q][i];
+					}
+					for (unsigned int i = 0; i < n; i++)
+					{
+						T vp = Vt[p][i];
+						Vt[p][i] = c * vp - s * Vt[q][i];
+						Vt[q][i] = s * vp + c * Vt[q][i];
+					}
+				}
+			}
+		}
+
+		// Singular values are the norms of the rotated columns
+		std::vector<T> sigma(n);
+		std::vector<unsigned int> order(n);
+		for (unsigned int j = 0; j < n; j++)
+		{
+			T norm = 0;
+			for (unsigned int i = 0; i < m_rows; i++)
+				norm += W[j][i] * W[j][i];
+			sigma[j] = std::sqrt(norm);
+			order[j] = j;
+		}
+
+		// Sort in order of descending singular value
+		std::sort(order.begin(), order.end(),
+			[&sigma](unsigned int a, unsigned int b) { return sigma[a] > sigma[b]; });
+
+		U = mat<T>::make_zeros(m_rows, n);
+		S = mat<T>::make_zeros(n, n);
+		V = mat<T>::make_zeros(n, n);
+		for (unsigned int k = 0; k < n; k++)
+		{
+			unsigned int j = order[k];
+			S[k][k] = sigma[j];
+			for (unsigned int i = 0; i < m_rows; i++)
+				U[i][k] = (sigma[j] > 0) ? W[j][i] / sigma[j] : 0;
+			for (unsigned int i = 0; i < n; i++)
+				V[i][k] = Vt[j][i];
+		}
+	}
+
 	// Explicit template instantiations
 	template class mat<float>;
 	template class mat<double>;
 	template class mat<long double>;
+
+	// Storage and element access of 16-bit matrices, which are converted 
+	// to float for other methods
+	template std::unique_ptr<mat<float16>> mat<float16>::unique_make_ones(unsigned int m, unsigned int n);
+	template std::unique_ptr<mat<float16>> mat<float16>::unique_make_zeros(unsigned int m, unsigned int n);
+	template std::unique_ptr<mat<float16>> mat<float16>::unique_make_eye(unsigned int m, unsigned int n);
+	template mat<float16> mat<float16>::make_ones(unsigned int rows, unsigned int cols);
+	template mat<float16> mat<float16>::make_zeros(unsigned int rows, unsigned int cols);
+	template mat<float16> mat<float16>::make_eye(unsigned int rows, unsigned int cols);
+	template mat<float16> mat<float16>::make_randn(unsigned int rows, unsigned int cols, std::mt19937& engine);
+	template mat<float16>::mat();
+	template mat<float16>::mat(unsigned int rows, unsigned int cols);
+	template mat<float16>::mat(std::initializer_list<std::initializer_list<float16>> args);
+	template mat<float16> mat<float16>::transpose(void) const;
+	template std::vector<float16>& mat<float16>::operator[] (unsigned int i);
+	template const std::vector<float16>& mat<float16>::operator[] (unsigned int i) const;
+	template std::unique_ptr<mat<bfloat16>> mat<bfloat16>::unique_make_ones(unsigned int m, unsigned int n);
+	template std::unique_ptr<mat<bfloat16>> mat<bfloat16>::unique_make_zeros(unsigned int m, unsigned int n);
+	template std::unique_ptr<mat<bfloat16>> mat<bfloat16>::unique_make_eye(unsigned int m, unsigned int n);
+	template mat<bfloat16> mat<bfloat16>::make_ones(unsigned int rows, unsigned int cols);
+	template mat<bfloat16> mat<bfloat16>::make_zeros(unsigned int rows, unsigned int cols);
+	template mat<bfloat16> mat<bfloat16>::make_eye(unsigned int rows, unsigned int cols);
+	template mat<bfloat16> mat<bfloat16>::make_randn(unsigned int rows, unsigned int cols, std::mt19937& engine);
+	template mat<bfloat16>::mat();
+	template mat<bfloat16>::mat(unsigned int rows, unsigned int cols);
+	template mat<bfloat16>::mat(std::initializer_list<std::initializer_list<bfloat16>> args);
+	template mat<bfloat16> mat<bfloat16>::transpose(void) const;
+	template std::vector<bfloat16>& mat<bfloat16>::operator[] (unsigned int i);
+	template const std::vector<bfloat16>& mat<bfloat16>::operator[] (unsigned int i) const;
 }
 
@@ -23,6 +23,8 @@
 */
 #include "../inc/operators.hpp"
 #include "../inc/mat.hpp"
+#include "../inc/half.hpp"
+#include "../inc/instrument.hpp"
 
 namespace linmat
 {
@@ -36,6 +38,7 @@ namespace linmat
 	template <typename T>
 	std::ostream& operator<<(std::ostream& os, const mat<T>& m)
 	{
+		LINMAT_COUNT("operator<<", 0, 0);
 		for (unsigned int i = 0; i < m.rows(); i++)
 		{
 			os << "[ ";
@@ -44,7 +47,7 @@ namespace linmat
 				T x = m[i][j];
 				os << x << " ";
 			}
-			os << "]" << std::endl;
+			os << "]\n";
 		}
 		return os;
 	}
@@ -59,6 +62,7 @@ namespace linmat
 	template <typename T>
 	mat<T> operator+(const mat<T>& lhs, const mat<T>& rhs)
 	{
+		LINMAT_COUNT("operator+", 1.0 * lhs.rows() * lhs.cols(), sizeof(T) * lhs.rows() * lhs.cols());
 		mat<T> result(lhs.rows(), lhs.cols());
 
 		if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
@@ -81,6 +85,7 @@ namespace linmat
 	template <typename T>
 	mat<T> operator-(const mat<T>& lhs, const mat<T>& rhs)
 	{
+		LINMAT_COUNT("operator-", 1.0 * lhs.rows() * lhs.cols(), sizeof(T) * lhs.rows() * lhs.cols());
 		mat<T> result(lhs.rows(), lhs.cols());
 
 		if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
@@ -103,6 +108,7 @@ namespace linmat
 	template <typename T>
 	mat<T> operator*(const mat<T>& lhs, const mat<T>& rhs)
 	{
+		LINMAT_COUNT("operator*", 1.0 * lhs.rows() * lhs.cols(), sizeof(T) * lhs.rows() * lhs.cols());
 		mat<T> result(lhs.rows(), lhs.cols());
 
 		if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
@@ -124,6 +130,7 @@ namespace linmat
 	/// <returns>A new matrix which is the result of the element-wise multiplicaiton.</returns>
 	template <typename T>
 	mat<T> operator*(const mat<T>& lhs, const T& rhs) {
+		LINMAT_COUNT("operator*(scalar)", 1.0 * lhs.rows() * lhs.cols(), sizeof(T) * lhs.rows() * lhs.cols());
 		mat<T> result(lhs.rows(), lhs.cols());
 
 		for (unsigned int i = 0; i < lhs.rows(); i++)
@@ -142,6 +149,7 @@ namespace linmat
 	/// <returns>A new matrix which is the result of the element-wise multiplication.</returns>
 	template <typename T>
 	mat<T> operator*(const T& lhs, const mat<T>& rhs) {
+		LINMAT_COUNT("operator*(scalar)", 1.0 * rhs.rows() * rhs.cols(), sizeof(T) * rhs.rows() * rhs.cols());
 		mat<T> result(rhs.rows(), rhs.cols());
 
 		for (unsigned int i = 0; i < rhs.rows(); i++)
@@ -160,6 +168,7 @@ namespace linmat
 	/// <returns>A new matrix which is a result of the element-wise division.</returns>
 	template <typename T>
 	mat<T> operator/(const mat<T>& lhs, const mat<T>& rhs) {
+		LINMAT_COUNT("operator/", 1.0 * lhs.rows() * lhs.cols(), sizeof(T) * lhs.rows() * lhs.cols());
 		mat<T> result(lhs.rows(), lhs.cols());
 
 		for (unsigned int i = 0; i < lhs.rows(); i++)
@@ -178,6 +187,7 @@ namespace linmat
 	/// <returns>A new matrix which is the reuslt of the element-wise division.</returns>
 	template <typename T>
 	mat<T> operator/(const mat<T>& lhs, const T& rhs) {
+		LINMAT_COUNT("operator/(scalar)", 1.0 * lhs.rows() * lhs.cols(), sizeof(T) * lhs.rows() * lhs.cols());
 		mat<T> result(lhs.rows(), lhs.cols());
 
 		for (unsigned int i = 0; i < lhs.rows(); i++)
@@ -196,6 +206,7 @@ namespace linmat
 	/// <returns>A new matrix which is a result of the element-wise division.</returns>
 	template <typename T>
 	mat<T> operator/(const T& lhs, const mat<T>& rhs) {
+		LINMAT_COUNT("operator/(scalar)", 1.0 * rhs.rows() * rhs.cols(), sizeof(T) * rhs.rows() * rhs.cols());
 		mat<T> result(rhs.rows(), rhs.cols());
 
 		for (unsigned int i = 0; i < rhs.rows(); i++)
@@ -233,4 +244,22 @@ namespace linmat
 	template mat<float> operator/(const float& lhs, const mat<float>& rhs);
 	template mat<double> operator/(const double& lhs, const mat<double>& rhs);
 	template mat<long double> operator/(const long double& lhs, const mat<long double>& rhs);
+	template std::ostream& operator<<(std::ostream&, const mat<float16>& m);
+	template mat<float16> operator+(const mat<float16>& lhs, const mat<float16>& rhs);
+	template mat<float16> operator-(const mat<float16>& lhs, const mat<float16>& rhs);
+	template mat<float16> operator*(const mat<float16>& lhs, const mat<float16>& rhs);
+	template mat<float16> operator*(const mat<float16>& lhs, const float16& rhs);
+	template mat<float16> operator*(const float16& lhs, const mat<float16>& rhs);
+	template mat<float16> operator/(const mat<float16>& lhs, const mat<float16>& rhs);
+	template mat<float16> operator/(const mat<float16>& lhs, const float16& rhs);
+	template mat<float16> operator/(const float16& lhs, const mat<float16>& rhs);
+	template std::ostream& operator<<(std::ostream&, const mat<bfloat16>& m);
+	template mat<bfloat16> operator+(const mat<bfloat16>& lhs, const mat<bfloat16>& rhs);
+	template mat<bfloat16> operator-(const mat<bfloat16>& lhs, const mat<bfloat16>& rhs);
+	template mat<bfloat16> operator*(const mat<bfloat16>& lhs, const mat<bfloat16>& rhs);
+	template mat<bfloat16> operator*(const mat<bfloat16>& lhs, const bfloat16& rhs);
+	template mat<bfloat16> operator*(const bfloat16& lhs, const mat<bfloat16>& rhs);
+	template mat<bfloat16> operator/(const mat<bfloat16>& lhs, const mat<bfloat16>& rhs);
+	template mat<bfloat16> operator/(const mat<bfloat16>& lhs, const bfloat16& rhs);
+	template mat<bfloat16> operator/(const bfloat16& lhs, const mat<bfloat16>& rhs);
 }
\ No newline at end of file
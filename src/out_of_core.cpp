@@ -0,0 +1,433 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <vector>
+#include "../inc/out_of_core.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Reference to a tile of a mapped matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	template <typename T>
+	struct tile_ref
+	{
+		const mapped_mat<T>* m;
+		unsigned int row;
+		unsigned int col;
+		unsigned int rows;
+		unsigned int cols;
+	};
+
+	/// <summary>
+	///   Gets the order of square tiles such that the given number of tiles
+	///   fit in the memory budget.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="memory_budget">Memory for tiles in bytes.</param>
+	/// <param name="tiles">Number of tiles held in memory at once.</param>
+	/// <param name="n">Largest dimension of the matrices.</param>
+	/// <returns>The order of the tiles.</returns>
+	template <typename T>
+	static unsigned int tile_order(std::size_t memory_budget, unsigned int tiles, unsigned int n)
+	{
+		double order = std::floor(std::sqrt(static_cast<double>(memory_budget) / (tiles * sizeof(T))));
+
+		return static_cast<unsigned int>(std::max(1.0, std::min(order, static_cast<double>(std::max(n, 1u)))));
+	}
+
+	/// <summary>
+	///   Copies a tile of a mapped matrix into memory.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="tile">Reference to the tile.</param>
+	/// <returns>A new matrix which is the tile.</returns>
+	template <typename T>
+	static mat<T> read_tile(const tile_ref<T>& tile)
+	{
+		mat<T> result(tile.rows, tile.cols);
+
+		for (unsigned int i = 0; i < tile.rows; i++)
+			if (tile.m->layout() == storage_layout::row_major)
+			{
+				const T* row = &(*tile.m)(tile.row + i, tile.col);
+				std::copy(row, row + tile.cols, result[i].begin());
+			}
+			else
+				for (unsigned int j = 0; j < tile.cols; j++)
+					result[i][j] = (*tile.m)(tile.row + i, tile.col + j);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Copies a tile from memory into a mapped matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The mapped matrix.</param>
+	/// <param name="row">First row of the tile.</param>
+	/// <param name="col">First column of the tile.</param>
+	/// <param name="tile">The tile.</param>
+	template <typename T>
+	static void write_tile(mapped_mat<T>& m, unsigned int row, unsigned int col, const mat<T>& tile)
+	{
+		for (unsigned int i = 0; i < tile.rows(); i++)
+			if (m.layout() == storage_layout::row_major)
+				std::copy(tile[i].begin(), tile[i].end(), &m(row + i, col));
+			else
+				for (unsigned int j = 0; j < tile.cols(); j++)
+					m(row + i, col + j) = tile[i][j];
+	}
+
+	/// <summary>
+	///   Runs a sequence of steps, each of which needs a set of tiles. The
+	///   tiles of the next step are read on another thread while the 
+	///   current step runs, so reading from disk overlaps computation. The
+	///   tiles of a step must not be written by earlier steps.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <typeparam name="F">Function taking the step index and its tiles.</typeparam>
+	/// <param name="steps">The tiles needed by each step.</param>
+	/// <param name="step">The function which runs a step.</param>
+	template <typename T, typename F>
+	static void prefetch_steps(const std::vector<std::vector<tile_ref<T>>>& steps, F step)
+	{
+		auto load = [&steps](std::size_t s)
+		{
+			LINMAT_TRACE_ITERATION("out_of_core::prefetch", s);
+			std::vector<mat<T>> tiles;
+			for (const tile_ref<T>& tile : steps[s])
+				tiles.push_back(read_tile(tile));
+			return tiles;
+		};
+
+		std::future<std::vector<mat<T>>> next;
+		if (!steps.empty())
+			next = std::async(std::launch::async, load, 0);
+		for (std::size_t s = 0; s < steps.size(); s++)
+		{
+			std::vector<mat<T>> tiles = next.get();
+			if (s + 1 < steps.size())
+				next = std::async(std::launch::async, load, s + 1);
+			LINMAT_TRACE_ITERATION("out_of_core::step", s);
+			step(s, tiles);
+		}
+	}
+
+	/// <summary>
+	///   Validates that a result matrix can be written and has the given 
+	///   dimensions.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The result matrix.</param>
+	/// <param name="rows">Required number of rows.</param>
+	/// <param name="cols">Required number of columns.</param>
+	template <typename T>
+	static void validate_result(const mapped_mat<T>& m, unsigned int rows, unsigned int cols)
+	{
+		if (m.mode() == map_mode::read_only)
+			throw std::runtime_error("Result matrix must be mapped for writing.");
+		if (m.rows() != rows || m.cols() != cols)
+			throw std::runtime_error("Result matrix dimensions do not match.");
+	}
+
+	/// <summary>
+	///   Calculates the product of two file-backed matrices tile by tile,
+	///   holding at most six tiles in memory. Each tile of C is accumulated
+	///   over the tiles of a row of A and a column of B while the next pair
+	///   of tiles is read.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The left matrix.</param>
+	/// <param name="B">The right matrix.</param>
+	/// <param name="C">A writable matrix for the product.</param>
+	/// <param name="memory_budget">Memory for tiles in bytes.</param>
+	template <typename T>
+	void mult_out_of_core(const mapped_mat<T>& A, const mapped_mat<T>& B, mapped_mat<T>& C, std::size_t memory_budget)
+	{
+		// Validate arguments
+		if (A.cols() != B.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+		validate_result(C, A.rows(), B.cols());
+
+		unsigned int b = tile_order<T>(memory_budget, 6, std::max(A.rows(), std::max(A.cols(), B.cols())));
+		unsigned int m = A.rows(), k = A.cols(), n = B.cols();
+		std::vector<std::vector<tile_ref<T>>> steps;
+		std::vector<unsigned int> rows, cols, inner;
+
+		for (unsigned int i = 0; i < m; i += b)
+			for (unsigned int j = 0; j < n; j += b)
+				for (unsigned int p = 0; p < std::max(k, 1u); p += b)
+				{
+					unsigned int mi = std::min(b, m - i), nj = std::min(b, n - j), kp = std::min(b, k - std::min(k, p));
+					steps.push_back({ { &A, i, p, mi, kp }, { &B, p, j, kp, nj } });
+					rows.push_back(i);
+					cols.push_back(j);
+					inner.push_back(p);
+				}
+
+		mat<T> sum;
+		prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& tiles)
+			{
+				if (inner[s] == 0)
+					sum = mat<T>::make_zeros(steps[s][0].rows, steps[s][1].cols);
+				if (steps[s][0].cols > 0)
+				{
+					mat<T> product = tiles[0].mult(tiles[1]);
+					for (unsigned int r = 0; r < sum.rows(); r++)
+						for (unsigned int c = 0; c < sum.cols(); c++)
+							sum[r][c] += product[r][c];
+				}
+				if (inner[s] + b >= k)
+					write_tile(C, rows[s], cols[s], sum);
+			});
+	}
+
+	/// <summary>
+	///   Performs LU decomposition of a file-backed matrix tile by tile,
+	///   holding at most eight tiles in memory. As with the in-memory 
+	///   decomposition, the Doolittle algorithm is used without pivoting, so
+	///   L has a unit diagonal. Each step factorizes a diagonal tile, solves
+	///   the tiles to its right and below, then updates the trailing tiles
+	///   while the next tiles are read.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix.</param>
+	/// <param name="L">A writable matrix for the lower triangular factor.</param>
+	/// <param name="U">A writable matrix for the upper triangular factor.</param>
+	/// <param name="memory_budget">Memory for tiles in bytes.</param>
+	template <typename T>
+	void lu_decomposition_out_of_core(const mapped_mat<T>& A, mapped_mat<T>& L, mapped_mat<T>& U, std::size_t memory_budget)
+	{
+		// Enforce square matrix
+		if (A.rows() != A.cols())
+			throw std::runtime_error("LU decomposition is undefined for a rectangular matrix.");
+		validate_result(L, A.rows(), A.cols());
+		validate_result(U, A.rows(), A.cols());
+
+		unsigned int n = A.rows();
+		unsigned int b = tile_order<T>(memory_budget, 8, n);
+		unsigned int tiles = (n + b - 1) / b;
+		auto size = [n, b](unsigned int t) { return std::min(b, n - t * b); };
+		std::vector<std::vector<tile_ref<T>>> steps;
+
+		// Copy A to U, which is factorized in place, and L to the identity
+		for (unsigned int i = 0; i < tiles; i++)
+			for (unsigned int j = 0; j < tiles; j++)
+				steps.push_back({ { &A, i * b, j * b, size(i), size(j) } });
+		prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+			{
+				unsigned int i = static_cast<unsigned int>(s) / tiles, j = static_cast<unsigned int>(s) % tiles;
+				write_tile(U, i * b, j * b, t[0]);
+				write_tile(L, i * b, j * b, i == j ? mat<T>::make_eye(size(i), size(j)) : mat<T>::make_zeros(size(i), size(j)));
+			});
+
+		for (unsigned int k = 0; k < tiles; k++)
+		{
+			unsigned int k0 = k * b, nk = size(k);
+
+			// Factorize the diagonal tile
+			mat<T> W = read_tile<T>({ &U, k0, k0, nk, nk });
+			mat<T> Lkk = mat<T>::make_eye(nk, nk), Ukk = mat<T>::make_zeros(nk, nk);
+			for (unsigned int i = 0; i < nk; i++)
+			{
+				if (W[i][i] == 0)
+					throw std::runtime_error("Matrix is singular.");
+				for (unsigned int j = i + 1; j < nk; j++)
+				{
+					W[j][i] /= W[i][i];
+					for (unsigned int p = i + 1; p < nk; p++)
+						W[j][p] -= W[j][i] * W[i][p];
+				}
+			}
+			for (unsigned int i = 0; i < nk; i++)
+				for (unsigned int j = 0; j < nk; j++)
+					(j < i ? Lkk : Ukk)[i][j] = W[i][j];
+			write_tile(L, k0, k0, Lkk);
+			write_tile(U, k0, k0, Ukk);
+
+			// Solve the tiles to the right, U(k, j) = Lkk^-1.U(k, j)
+			steps.clear();
+			for (unsigned int j = k + 1; j < tiles; j++)
+				steps.push_back({ { &U, k0, j * b, nk, size(j) } });
+			prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+				{
+					mat<T>& X = t[0];
+					for (unsigned int r = 1; r < nk; r++)
+						for (unsigned int p = 0; p < r; p++)
+							for (unsigned int c = 0; c < X.cols(); c++)
+								X[r][c] -= Lkk[r][p] * X[p][c];
+					write_tile(U, k0, steps[s][0].col, X);
+				});
+
+			// Solve the tiles below, L(i, k) = U(i, k).Ukk^-1
+			steps.clear();
+			for (unsigned int i = k + 1; i < tiles; i++)
+				steps.push_back({ { &U, i * b, k0, size(i), nk } });
+			prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+				{
+					mat<T>& X = t[0];
+					for (unsigned int r = 0; r < X.rows(); r++)
+						for (unsigned int c = 0; c < nk; c++)
+						{
+							T sum = X[r][c];
+							for (unsigned int p = 0; p < c; p++)
+								sum -= X[r][p] * Ukk[p][c];
+							X[r][c] = sum / Ukk[c][c];
+						}
+					write_tile(L, steps[s][0].row, k0, X);
+					write_tile(U, steps[s][0].row, k0, mat<T>::make_zeros(X.rows(), nk));
+				});
+
+			// Update the trailing tiles, U(i, j) -= L(i, k).U(k, j)
+			steps.clear();
+			for (unsigned int i = k + 1; i < tiles; i++)
+				for (unsigned int j = k + 1; j < tiles; j++)
+					steps.push_back({ { &L, i * b, k0, size(i), nk }, { &U, k0, j * b, nk, size(j) }, { &U, i * b, j * b, size(i), size(j) } });
+			prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+				{
+					mat<T> product = t[0].mult(t[1]);
+					for (unsigned int r = 0; r < product.rows(); r++)
+						for (unsigned int c = 0; c < product.cols(); c++)
+							t[2][r][c] -= product[r][c];
+					write_tile(U, steps[s][2].row, steps[s][2].col, t[2]);
+				});
+		}
+	}
+
+	/// <summary>
+	///   Performs Cholesky decomposition of a file-backed symmetric 
+	///   positive-definite matrix tile by tile, holding at most seven tiles
+	///   in memory. Only the lower triangle of A is read. Each step 
+	///   factorizes a diagonal tile, solves the tiles below it, then updates
+	///   the trailing lower tiles while the next tiles are read.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The symmetric positive-definite matrix.</param>
+	/// <param name="L">A writable matrix for the lower triangular factor.</param>
+	/// <param name="memory_budget">Memory for tiles in bytes.</param>
+	template <typename T>
+	void cholesky_decomposition_out_of_core(const mapped_mat<T>& A, mapped_mat<T>& L, std::size_t memory_budget)
+	{
+		// Enforce square matrix
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Cholesky decomposition is undefined for a rectangular matrix.");
+		validate_result(L, A.rows(), A.cols());
+
+		unsigned int n = A.rows();
+		unsigned int b = tile_order<T>(memory_budget, 7, n);
+		unsigned int tiles = (n + b - 1) / b;
+		auto size = [n, b](unsigned int t) { return std::min(b, n - t * b); };
+		std::vector<std::vector<tile_ref<T>>> steps;
+
+		// Copy the lower triangle of A to L, which is factorized in place
+		for (unsigned int i = 0; i < tiles; i++)
+			for (unsigned int j = 0; j <= i; j++)
+				steps.push_back({ { &A, i * b, j * b, size(i), size(j) } });
+		prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+			{
+				const tile_ref<T>& tile = steps[s][0];
+				if (tile.row == tile.col)
+					for (unsigned int r = 0; r < tile.rows; r++)
+						for (unsigned int c = r + 1; c < tile.cols; c++)
+							t[0][r][c] = 0;
+				write_tile(L, tile.row, tile.col, t[0]);
+				if (tile.row != tile.col)
+					write_tile(L, tile.col, tile.row, mat<T>::make_zeros(tile.cols, tile.rows));
+			});
+
+		for (unsigned int k = 0; k < tiles; k++)
+		{
+			unsigned int k0 = k * b, nk = size(k);
+
+			// Factorize the diagonal tile
+			mat<T> Lkk = read_tile<T>({ &L, k0, k0, nk, nk });
+			for (unsigned int i = 0; i < nk; i++)
+				for (unsigned int j = 0; j <= i; j++)
+				{
+					T sum = Lkk[i][j];
+					for (unsigned int p = 0; p < j; p++)
+						sum -= Lkk[i][p] * Lkk[j][p];
+					if (i == j)
+					{
+						if (!(sum > 0))
+							throw std::runtime_error("Matrix must be positive-definite.");
+						Lkk[i][j] = std::sqrt(sum);
+					}
+					else
+						Lkk[i][j] = sum / Lkk[j][j];
+				}
+			write_tile(L, k0, k0, Lkk);
+
+			// Solve the tiles below, L(i, k) = L(i, k).Lkk^-T
+			steps.clear();
+			for (unsigned int i = k + 1; i < tiles; i++)
+				steps.push_back({ { &L, i * b, k0, size(i), nk } });
+			prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+				{
+					mat<T>& X = t[0];
+					for (unsigned int r = 0; r < X.rows(); r++)
+						for (unsigned int c = 0; c < nk; c++)
+						{
+							T sum = X[r][c];
+							for (unsigned int p = 0; p < c; p++)
+								sum -= X[r][p] * Lkk[c][p];
+							X[r][c] = sum / Lkk[c][c];
+						}
+					write_tile(L, steps[s][0].row, k0, X);
+				});
+
+			// Update the trailing lower tiles, L(i, j) -= L(i, k).L(j, k)^T
+			steps.clear();
+			for (unsigned int i = k + 1; i < tiles; i++)
+				for (unsigned int j = k + 1; j <= i; j++)
+					steps.push_back({ { &L, i * b, k0, size(i), nk }, { &L, j * b, k0, size(j), nk }, { &L, i * b, j * b, size(i), size(j) } });
+			prefetch_steps(steps, [&](std::size_t s, std::vector<mat<T>>& t)
+				{
+					bool diagonal = steps[s][2].row == steps[s][2].col;
+					mat<T> product = t[0].mult(t[1].transpose());
+					for (unsigned int r = 0; r < product.rows(); r++)
+						for (unsigned int c = 0; c < product.cols() && (!diagonal || c <= r); c++)
+							t[2][r][c] -= product[r][c];
+					write_tile(L, steps[s][2].row, steps[s][2].col, t[2]);
+				});
+		}
+	}
+
+	// Explicit template instantiations
+	template void mult_out_of_core(const mapped_mat<float>& A, const mapped_mat<float>& B, mapped_mat<float>& C, std::size_t memory_budget);
+	template void mult_out_of_core(const mapped_mat<double>& A, const mapped_mat<double>& B, mapped_mat<double>& C, std::size_t memory_budget);
+	template void mult_out_of_core(const mapped_mat<long double>& A, const mapped_mat<long double>& B, mapped_mat<long double>& C, std::size_t memory_budget);
+	template void lu_decomposition_out_of_core(const mapped_mat<float>& A, mapped_mat<float>& L, mapped_mat<float>& U, std::size_t memory_budget);
+	template void lu_decomposition_out_of_core(const mapped_mat<double>& A, mapped_mat<double>& L, mapped_mat<double>& U, std::size_t memory_budget);
+	template void lu_decomposition_out_of_core(const mapped_mat<long double>& A, mapped_mat<long double>& L, mapped_mat<long double>& U, std::size_t memory_budget);
+	template void cholesky_decomposition_out_of_core(const mapped_mat<float>& A, mapped_mat<float>& L, std::size_t memory_budget);
+	template void cholesky_decomposition_out_of_core(const mapped_mat<double>& A, mapped_mat<double>& L, std::size_t memory_budget);
+	template void cholesky_decomposition_out_of_core(const mapped_mat<long double>& A, mapped_mat<long double>& L, std::size_t memory_budget);
+}
@@ -0,0 +1,537 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "../inc/packed.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Triangular matrix class constructor, with all entries zeroed.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of rows and columns.</param>
+	/// <param name="lower">True for a lower triangular matrix, otherwise upper.</param>
+	template <typename T>
+	tri_mat<T>::tri_mat(unsigned int n, bool lower)
+		: m_n(n)
+		, m_lower(lower)
+		, m_elements(static_cast<std::size_t>(n) * (n + 1) / 2)
+	{
+	}
+
+	/// <summary>
+	///   Triangular matrix class constructor from the triangle of a dense
+	///   matrix. Entries outside the triangle are ignored.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The square dense matrix.</param>
+	/// <param name="lower">True for a lower triangular matrix, otherwise upper.</param>
+	template <typename T>
+	tri_mat<T>::tri_mat(const mat<T>& m, bool lower)
+		: tri_mat(m.rows(), lower)
+	{
+		if (m.rows() != m.cols())
+			throw std::runtime_error("Triangular matrix must be square.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j < m_n; j++)
+				if (in_triangle(i, j))
+					m_elements[index(i, j)] = m[i][j];
+	}
+
+	/// <summary>
+	///   Returns the position of an entry of the triangle in packed storage.
+	///   Row i of a lower triangle starts at i(i+1)/2, and row i of an upper
+	///   triangle starts at i(2n-i+1)/2.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>The packed index.</returns>
+	template <typename T>
+	std::size_t tri_mat<T>::index(unsigned int i, unsigned int j) const
+	{
+		std::size_t r = i;
+
+		if (m_lower)
+			return r * (r + 1) / 2 + j;
+		return r * (2 * static_cast<std::size_t>(m_n) - r + 1) / 2 + (j - i);
+	}
+
+	/// <summary>
+	///   Subscript operator for an entry of the triangle.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A reference to the entry.</returns>
+	template <typename T>
+	T& tri_mat<T>::operator() (unsigned int i, unsigned int j)
+	{
+		if (!in_triangle(i, j))
+			throw std::runtime_error("Entry is outside the triangle.");
+
+		return m_elements[index(i, j)];
+	}
+
+	/// <summary>
+	///   Subscript operator for constant operand, returning zero outside the
+	///   triangle.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A scalar value.</returns>
+	template <typename T>
+	T tri_mat<T>::operator() (unsigned int i, unsigned int j) const
+	{
+		return in_triangle(i, j) ? m_elements[index(i, j)] : 0;
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the triangular matrix (TRMM),
+	///   using only the entries of the triangle.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> tri_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(m_n, other.cols());
+
+		// Validate arguments
+		if (m_n != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+		{
+			unsigned int first = m_lower ? 0 : i;
+			unsigned int last = m_lower ? i : m_n - 1;
+			const T* row = &m_elements[index(i, first)];
+			for (unsigned int k = first; k <= last; k++)
+			{
+				T a = row[k - first];
+				for (unsigned int j = 0; j < other.cols(); j++)
+					result[i][j] += a * other[k][j];
+			}
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves T.X = B by forward substitution for a lower triangle, or back
+	///   substitution for an upper triangle (TRSM).
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> tri_mat<T>::solve(const mat<T>& b) const
+	{
+		mat<T> x(b);
+
+		// Validate arguments
+		if (b.rows() != m_n)
+			throw std::runtime_error("Rows in right-hand side must match the triangular matrix.");
+
+		for (unsigned int step = 0; step < m_n; step++)
+		{
+			unsigned int i = m_lower ? step : m_n - 1 - step;
+			unsigned int first = m_lower ? 0 : i + 1;
+			unsigned int last = m_lower ? i : m_n;
+			for (unsigned int k = first; k < last; k++)
+			{
+				T a = m_elements[index(i, k)];
+				for (unsigned int j = 0; j < b.cols(); j++)
+					x[i][j] -= a * x[k][j];
+			}
+
+			T d = m_elements[index(i, i)];
+			if (d == 0)
+				throw std::runtime_error("Matrix is singular.");
+			for (unsigned int j = 0; j < b.cols(); j++)
+				x[i][j] /= d;
+		}
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the transpose, exchanging a lower and upper triangle.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new triangular matrix which is the transpose.</returns>
+	template <typename T>
+	tri_mat<T> tri_mat<T>::transpose(void) const
+	{
+		tri_mat<T> result(m_n, !m_lower);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j < m_n; j++)
+				if (in_triangle(i, j))
+					result.m_elements[result.index(j, i)] = m_elements[index(i, j)];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the product of the diagonal.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T tri_mat<T>::det(void) const
+	{
+		T result = 1;
+
+		for (unsigned int i = 0; i < m_n; i++)
+			result *= m_elements[index(i, i)];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the Frobenius norm.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T tri_mat<T>::frobenius_norm(void) const
+	{
+		T result = 0;
+
+		for (const T& x : m_elements)
+			result += x * x;
+
+		return std::sqrt(result);
+	}
+
+	/// <summary>
+	///   Calculates the 1-norm, the maximum absolute column sum.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T tri_mat<T>::norm_1(void) const
+	{
+		std::vector<T> sums(m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j < m_n; j++)
+				if (in_triangle(i, j))
+					sums[j] += std::fabs(m_elements[index(i, j)]);
+
+		return m_n > 0 ? *std::max_element(sums.begin(), sums.end()) : 0;
+	}
+
+	/// <summary>
+	///   Calculates the infinity norm, the maximum absolute row sum.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T tri_mat<T>::norm_inf(void) const
+	{
+		return transpose().norm_1();
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> tri_mat<T>::dense(void) const
+	{
+		mat<T> result(m_n, m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j < m_n; j++)
+				if (in_triangle(i, j))
+					result[i][j] = m_elements[index(i, j)];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Symmetric matrix class constructor, with all entries zeroed.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of rows and columns.</param>
+	template <typename T>
+	sym_mat<T>::sym_mat(unsigned int n)
+		: m_n(n)
+		, m_elements(static_cast<std::size_t>(n) * (n + 1) / 2)
+	{
+	}
+
+	/// <summary>
+	///   Symmetric matrix class constructor from the lower triangle of a 
+	///   dense matrix, which must equal the transpose of the upper triangle.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The square symmetric dense matrix.</param>
+	template <typename T>
+	sym_mat<T>::sym_mat(const mat<T>& m)
+		: sym_mat(m.rows())
+	{
+		if (m.rows() != m.cols())
+			throw std::runtime_error("Symmetric matrix must be square.");
+
+		// Enforce symmetric
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j < i; j++)
+				if (m[i][j] != m[j][i])
+					throw std::runtime_error("Matrix must be symmetric.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+				m_elements[index(i, j)] = m[i][j];
+	}
+
+	/// <summary>
+	///   Returns the position of an entry in packed storage, using the lower
+	///   triangle for entries above the diagonal.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>The packed index.</returns>
+	template <typename T>
+	std::size_t sym_mat<T>::index(unsigned int i, unsigned int j)
+	{
+		if (j > i)
+			std::swap(i, j);
+
+		return static_cast<std::size_t>(i) * (i + 1) / 2 + j;
+	}
+
+	/// <summary>
+	///   Subscript operator. Entries (i, j) and (j, i) share storage.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A reference to the entry.</returns>
+	template <typename T>
+	T& sym_mat<T>::operator() (unsigned int i, unsigned int j)
+	{
+		return m_elements[index(i, j)];
+	}
+
+	/// <summary>
+	///   Subscript operator for constant operand.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A reference to the entry.</returns>
+	template <typename T>
+	const T& sym_mat<T>::operator() (unsigned int i, unsigned int j) const
+	{
+		return m_elements[index(i, j)];
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the symmetric matrix (SYMM). Each
+	///   stored entry below the diagonal contributes to two rows of the 
+	///   product.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> sym_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(m_n, other.cols());
+
+		// Validate arguments
+		if (m_n != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+		{
+			const T* row = &m_elements[index(i, 0)];
+			for (unsigned int k = 0; k <= i; k++)
+			{
+				T a = row[k];
+				for (unsigned int j = 0; j < other.cols(); j++)
+					result[i][j] += a * other[k][j];
+				if (k < i)
+					for (unsigned int j = 0; j < other.cols(); j++)
+						result[k][j] += a * other[i][j];
+			}
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves S.X = B for a positive-definite matrix using the packed
+	///   Cholesky factor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> sym_mat<T>::solve(const mat<T>& b) const
+	{
+		tri_mat<T> L(m_n);
+
+		cholesky_decomposition(L);
+
+		return L.transpose().solve(L.solve(b));
+	}
+
+	/// <summary>
+	///   Performs the Cholesky decomposition of the positive-definite matrix
+	///   into a packed lower triangular factor, such that S = LL^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="L">A lower triangular matrix which will be written to.</param>
+	template <typename T>
+	void sym_mat<T>::cholesky_decomposition(tri_mat<T>& L) const
+	{
+		L = tri_mat<T>(m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				T s = m_elements[index(i, j)];
+				for (unsigned int k = 0; k < j; k++)
+					s -= L(i, k) * L(j, k);
+				if (i == j)
+				{
+					if (!(s > 0))
+						throw std::runtime_error("Matrix must be positive-definite.");
+					L(i, i) = std::sqrt(s);
+				}
+				else
+					L(i, j) = s / L(j, j);
+			}
+	}
+
+	/// <summary>
+	///   Calculates the trace of the matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The scalar valued trace of the matrix.</returns>
+	template <typename T>
+	T sym_mat<T>::trace(void) const
+	{
+		T result = 0;
+
+		for (unsigned int i = 0; i < m_n; i++)
+			result += m_elements[index(i, i)];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the Frobenius norm, counting entries off the diagonal
+	///   twice.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T sym_mat<T>::frobenius_norm(void) const
+	{
+		T result = 0;
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				T x = m_elements[index(i, j)];
+				result += (i == j ? 1 : 2) * x * x;
+			}
+
+		return std::sqrt(result);
+	}
+
+	/// <summary>
+	///   Calculates the 1-norm, the maximum absolute column sum.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T sym_mat<T>::norm_1(void) const
+	{
+		std::vector<T> sums(m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				T x = std::fabs(m_elements[index(i, j)]);
+				sums[j] += x;
+				if (j < i)
+					sums[i] += x;
+			}
+
+		return m_n > 0 ? *std::max_element(sums.begin(), sums.end()) : 0;
+	}
+
+	/// <summary>
+	///   Calculates the infinity norm, which equals the 1-norm for a 
+	///   symmetric matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Scalar valued norm of the matrix.</returns>
+	template <typename T>
+	T sym_mat<T>::norm_inf(void) const
+	{
+		return norm_1();
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> sym_mat<T>::dense(void) const
+	{
+		mat<T> result(m_n, m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			for (unsigned int j = 0; j <= i; j++)
+			{
+				result[i][j] = m_elements[index(i, j)];
+				result[j][i] = result[i][j];
+			}
+
+		return result;
+	}
+
+	// Explicit template instantiations
+	template class tri_mat<float>;
+	template class tri_mat<double>;
+	template class tri_mat<long double>;
+	template class sym_mat<float>;
+	template class sym_mat<double>;
+	template class sym_mat<long double>;
+}
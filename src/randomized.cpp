@@ -0,0 +1,364 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include "../inc/randomized.hpp"
+#include "../inc/linear_operator.hpp"
+#include "../inc/operators.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Returns the leading columns of a matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The matrix to truncate.</param>
+	/// <param name="k">The number of columns to keep.</param>
+	/// <returns>A new matrix of the first k columns.</returns>
+	template <typename T>
+	static mat<T> leading_columns(const mat<T>& m, unsigned int k)
+	{
+		mat<T> result(m.rows(), k);
+
+		for (unsigned int i = 0; i < m.rows(); i++)
+			for (unsigned int j = 0; j < k; j++)
+				result[i][j] = m[i][j];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Finds a matrix Q with l orthonormal columns whose range approximates
+	///   the range of A, by sampling A with a Gaussian test matrix. Power 
+	///   passes sharpen the approximation when singular values decay slowly.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The mxn matrix to sample.</param>
+	/// <param name="l">Number of samples, i.e. the target rank plus oversampling.</param>
+	/// <param name="power_iters">Number of power passes through A^T and A.</param>
+	/// <param name="seed">Seed for the random number generator.</param>
+	/// <returns>An mxl matrix with orthonormal columns.</returns>
+	template <typename T>
+	mat<T> randomized_range_finder(
+		const linear_operator<T>& A,
+		unsigned int l,
+		unsigned int power_iters,
+		unsigned int seed)
+	{
+		std::mt19937 engine(seed);
+		mat<T> Q, R;
+
+		// The range cannot have more dimensions than the matrix
+		l = std::min(l, std::min(A.rows(), A.cols()));
+		if (l == 0)
+			throw std::runtime_error("Number of samples must be greater than zero.");
+
+		// Sample the range with a Gaussian test matrix
+		mat<T> Y = A.apply(mat<T>::make_randn(A.cols(), l, engine));
+		Y.qr_decomposition(Q, R);
+
+		// Power passes, re-orthonormalizing to avoid loss of precision
+		for (unsigned int i = 0; i < power_iters; i++)
+		{
+			mat<T> Z = A.apply_transpose(Q);
+			Z.qr_decomposition(Q, R);
+			Y = A.apply(Q);
+			Y.qr_decomposition(Q, R);
+		}
+
+		return Q;
+	}
+
+	/// <summary>
+	///   Calculates a rank-k approximation to the singular value decomposition
+	///   of A, such that A ~ U.S.V^T, using a randomized range finder followed
+	///   by an exact decomposition of the small projected matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The mxn matrix to decompose.</param>
+	/// <param name="k">The target rank.</param>
+	/// <param name="U">An empty matrix which will be written to with the mxk 
+	///   left singular vectors.</param>
+	/// <param name="S">An empty matrix which will be written to with the kxk
+	///   diagonal matrix of singular values.</param>
+	/// <param name="V">An empty matrix which will be written to with the nxk
+	///   right singular vectors.</param>
+	/// <param name="oversampling">Number of additional samples beyond k.</param>
+	/// <param name="power_iters">Number of power passes through A^T and A.</param>
+	/// <param name="seed">Seed for the random number generator.</param>
+	template <typename T>
+	void randomized_svd(
+		const linear_operator<T>& A,
+		unsigned int k,
+		mat<T>& U,
+		mat<T>& S,
+		mat<T>& V,
+		unsigned int oversampling,
+		unsigned int power_iters,
+		unsigned int seed)
+	{
+		mat<T> Ub, Sb, Vb;
+
+		// Enforce valid rank
+		if (k == 0 || k > A.rows() || k > A.cols())
+			throw std::runtime_error("Rank must be between one and the smallest matrix dimension.");
+
+		// Project A onto the approximate range
+		mat<T> Q = randomized_range_finder(A, k + oversampling, power_iters, seed);
+		mat<T> B = A.apply_transpose(Q).transpose();
+
+		// Decompose the small matrix and lift back to the full space
+		B.svd(Ub, Sb, Vb);
+		U = leading_columns(Q.mult(Ub), k);
+		V = leading_columns(Vb, k);
+		S = mat<T>::make_zeros(k, k);
+		for (unsigned int i = 0; i < k; i++)
+			S[i][i] = Sb[i][i];
+	}
+
+	/// <summary>
+	///   Estimates the spectral (l2) norm of the matrix by power iteration on
+	///   A^T.A, stopping once the estimate has converged to a relative tolerance.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The matrix.</param>
+	/// <param name="max_iter">Maximum number of power iterations.</param>
+	/// <param name="tol">Relative change in the estimate at which to stop.</param>
+	/// <param name="seed">Seed for the random number generator.</param>
+	/// <returns>An estimate (lower bound) of the spectral norm.</returns>
+	template <typename T>
+	T estimate_spectral_norm(
+		const linear_operator<T>& A,
+		unsigned int max_iter,
+		double tol,
+		unsigned int seed)
+	{
+		std::mt19937 engine(seed);
+		mat<T> v = mat<T>::make_randn(A.cols(), 1, engine);
+
+		// The Rayleigh quotient of A^T.A is ||A.v||^2 for unit v
+		T lambda = power_iteration<T>(gram_operator<T>(A), v, max_iter, tol);
+
+		return std::sqrt(std::max(lambda, static_cast<T>(0)));
+	}
+
+	/// <summary>
+	///   Estimates the trace of the square matrix using Hutchinson's method
+	///   with Rademacher probe vectors.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square matrix.</param>
+	/// <param name="samples">Number of probe vectors.</param>
+	/// <param name="seed">Seed for the random number generator.</param>
+	/// <returns>An unbiased estimate of the trace.</returns>
+	template <typename T>
+	T estimate_trace(
+		const linear_operator<T>& A,
+		unsigned int samples,
+		unsigned int seed)
+	{
+		std::mt19937 engine(seed);
+		std::bernoulli_distribution distribution(0.5);
+		mat<T> Z(A.cols(), samples);
+		T result = 0;
+
+		// Enforce square matrix
+		if (A.rows() != A.cols())
+			throw std::runtime_error("Trace is undefined for a rectangular matrix.");
+		if (samples == 0)
+			throw std::runtime_error("Number of samples must be greater than zero.");
+
+		// Probe vectors with entries of +1 or -1
+		for (unsigned int i = 0; i < Z.rows(); i++)
+			for (unsigned int j = 0; j < samples; j++)
+				Z[i][j] = distribution(engine) ? static_cast<T>(1) : static_cast<T>(-1);
+
+		// Average of z^T.A.z over all probes
+		mat<T> AZ = A.apply(Z);
+		for (unsigned int i = 0; i < Z.rows(); i++)
+			for (unsigned int j = 0; j < samples; j++)
+				result += Z[i][j] * AZ[i][j];
+
+		return result / static_cast<T>(samples);
+	}
+
+	/// <summary>
+	///   Estimates the l2 condition number of the matrix, as the ratio of the
+	///   largest to the smallest singular value. The smallest singular value
+	///   is found by power iteration on the shifted matrix s^2.I - A^T.A, so
+	///   no factorization of A is required.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The square or tall matrix.</param>
+	/// <param name="max_iter">Maximum number of power iterations per singular value.</param>
+	/// <param name="tol">Relative change in the estimate at which to stop.</param>
+	/// <param name="seed">Seed for the random number generator.</param>
+	/// <returns>An estimate of the condition number, or infinity if singular.</returns>
+	template <typename T>
+	T estimate_condition_number(
+		const linear_operator<T>& A,
+		unsigned int max_iter,
+		double tol,
+		unsigned int seed)
+	{
+		std::mt19937 engine(seed + 1);
+		mat<T> v = mat<T>::make_randn(A.cols(), 1, engine);
+		T sigma_min = 0;
+
+		// Enforce square or tall matrix
+		if (A.rows() < A.cols())
+			throw std::runtime_error("Condition number requires rows greater than or equal to columns.");
+
+		// Find the largest singular value, and a shift slightly beyond its square
+		T sigma_max = estimate_spectral_norm(A, max_iter, tol, seed);
+		T shift = static_cast<T>(1.01) * sigma_max * sigma_max;
+		if (sigma_max == 0)
+			return std::numeric_limits<T>::infinity();
+
+		// The dominant eigenvector of the shifted matrix is the right singular
+		// vector with the smallest singular value
+		for (unsigned int i = 0; i < max_iter; i++)
+		{
+			v = v / v.frobenius_norm();
+			mat<T> w = A.apply(v);
+			T sigma_1 = w.frobenius_norm();
+			v = v * shift - A.apply_transpose(w);
+
+			// Evaluate convergence
+			bool done = std::fabs(sigma_1 - sigma_min) <= tol * sigma_1;
+			sigma_min = sigma_1;
+			if (done || v.frobenius_norm() == 0)
+				break;
+		}
+
+		if (sigma_min == 0)
+			return std::numeric_limits<T>::infinity();
+
+		return sigma_max / sigma_min;
+	}
+
+	/// <summary>
+	///   Finds an approximate orthonormal basis for the range of a dense matrix.
+	/// </summary>
+	template <typename T>
+	mat<T> randomized_range_finder(
+		const mat<T>& A,
+		unsigned int l,
+		unsigned int power_iters,
+		unsigned int seed)
+	{
+		return randomized_range_finder<T>(dense_operator<T>(A), l, power_iters, seed);
+	}
+
+	/// <summary>
+	///   Calculates a rank-k approximation to the singular value decomposition
+	///   of a dense matrix.
+	/// </summary>
+	template <typename T>
+	void randomized_svd(
+		const mat<T>& A,
+		unsigned int k,
+		mat<T>& U,
+		mat<T>& S,
+		mat<T>& V,
+		unsigned int oversampling,
+		unsigned int power_iters,
+		unsigned int seed)
+	{
+		randomized_svd<T>(dense_operator<T>(A), k, U, S, V, oversampling, power_iters, seed);
+	}
+
+	/// <summary>
+	///   Estimates the spectral (l2) norm of a dense matrix.
+	/// </summary>
+	template <typename T>
+	T estimate_spectral_norm(
+		const mat<T>& A,
+		unsigned int max_iter,
+		double tol,
+		unsigned int seed)
+	{
+		return estimate_spectral_norm<T>(dense_operator<T>(A), max_iter, tol, seed);
+	}
+
+	/// <summary>
+	///   Estimates the trace of a dense square matrix.
+	/// </summary>
+	template <typename T>
+	T estimate_trace(
+		const mat<T>& A,
+		unsigned int samples,
+		unsigned int seed)
+	{
+		return estimate_trace<T>(dense_operator<T>(A), samples, seed);
+	}
+
+	/// <summary>
+	///   Estimates the l2 condition number of a dense matrix.
+	/// </summary>
+	template <typename T>
+	T estimate_condition_number(
+		const mat<T>& A,
+		unsigned int max_iter,
+		double tol,
+		unsigned int seed)
+	{
+		return estimate_condition_number<T>(dense_operator<T>(A), max_iter, tol, seed);
+	}
+
+	// Explicit template instantiations
+	template mat<float> randomized_range_finder(const mat<float>& A, unsigned int l, unsigned int power_iters, unsigned int seed);
+	template mat<float> randomized_range_finder(const linear_operator<float>& A, unsigned int l, unsigned int power_iters, unsigned int seed);
+	template mat<double> randomized_range_finder(const mat<double>& A, unsigned int l, unsigned int power_iters, unsigned int seed);
+	template mat<double> randomized_range_finder(const linear_operator<double>& A, unsigned int l, unsigned int power_iters, unsigned int seed);
+	template mat<long double> randomized_range_finder(const mat<long double>& A, unsigned int l, unsigned int power_iters, unsigned int seed);
+	template mat<long double> randomized_range_finder(const linear_operator<long double>& A, unsigned int l, unsigned int power_iters, unsigned int seed);
+	template void randomized_svd(const mat<float>& A, unsigned int k, mat<float>& U, mat<float>& S, mat<float>& V, unsigned int oversampling, unsigned int power_iters, unsigned int seed);
+	template void randomized_svd(const linear_operator<float>& A, unsigned int k, mat<float>& U, mat<float>& S, mat<float>& V, unsigned int oversampling, unsigned int power_iters, unsigned int seed);
+	template void randomized_svd(const mat<double>& A, unsigned int k, mat<double>& U, mat<double>& S, mat<double>& V, unsigned int oversampling, unsigned int power_iters, unsigned int seed);
+	template void randomized_svd(const linear_operator<double>& A, unsigned int k, mat<double>& U, mat<double>& S, mat<double>& V, unsigned int oversampling, unsigned int power_iters, unsigned int seed);
+	template void randomized_svd(const mat<long double>& A, unsigned int k, mat<long double>& U, mat<long double>& S, mat<long double>& V, unsigned int oversampling, unsigned int power_iters, unsigned int seed);
+	template void randomized_svd(const linear_operator<long double>& A, unsigned int k, mat<long double>& U, mat<long double>& S, mat<long double>& V, unsigned int oversampling, unsigned int power_iters, unsigned int seed);
+	template float estimate_spectral_norm(const mat<float>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template float estimate_spectral_norm(const linear_operator<float>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template double estimate_spectral_norm(const mat<double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template double estimate_spectral_norm(const linear_operator<double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template long double estimate_spectral_norm(const mat<long double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template long double estimate_spectral_norm(const linear_operator<long double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template float estimate_trace(const mat<float>& A, unsigned int samples, unsigned int seed);
+	template float estimate_trace(const linear_operator<float>& A, unsigned int samples, unsigned int seed);
+	template double estimate_trace(const mat<double>& A, unsigned int samples, unsigned int seed);
+	template double estimate_trace(const linear_operator<double>& A, unsigned int samples, unsigned int seed);
+	template long double estimate_trace(const mat<long double>& A, unsigned int samples, unsigned int seed);
+	template long double estimate_trace(const linear_operator<long double>& A, unsigned int samples, unsigned int seed);
+	template float estimate_condition_number(const mat<float>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template float estimate_condition_number(const linear_operator<float>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template double estimate_condition_number(const mat<double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template double estimate_condition_number(const linear_operator<double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template long double estimate_condition_number(const mat<long double>& A, unsigned int max_iter, double tol, unsigned int seed);
+	template long double estimate_condition_number(const linear_operator<long double>& A, unsigned int max_iter, double tol, unsigned int seed);
+}
@@ -0,0 +1,351 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <stdexcept>
+#include "../inc/scheduler.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	// Scheduler and index of the worker running on this thread, if any
+	static thread_local const task_scheduler* t_scheduler = nullptr;
+	static thread_local unsigned int t_index = 0;
+
+	/// <summary>
+	///   Constructor starts the worker threads.
+	/// </summary>
+	/// <param name="threads">Number of worker threads, or zero for the hardware concurrency.</param>
+	task_scheduler::task_scheduler(unsigned int threads)
+		: m_queued(0), m_next(0), m_stop(false)
+	{
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+
+		for (unsigned int i = 0; i < threads; i++)
+			m_workers.push_back(std::unique_ptr<worker>(new worker()));
+		for (unsigned int i = 0; i < threads; i++)
+			m_threads.push_back(std::thread(&task_scheduler::work, this, i));
+	}
+
+	/// <summary>
+	///   Destructor stops and joins the worker threads. Tasks still queued
+	///   are discarded.
+	/// </summary>
+	task_scheduler::~task_scheduler()
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_sleep_lock);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for (std::thread& thread : m_threads)
+			thread.join();
+	}
+
+	/// <summary>
+	///   Gets the shared scheduler, with one worker per hardware thread.
+	/// </summary>
+	/// <returns>Reference to the shared scheduler.</returns>
+	task_scheduler& task_scheduler::instance(void)
+	{
+		static task_scheduler scheduler;
+		return scheduler;
+	}
+
+	/// <summary>
+	///   Queues a task. A task submitted from a worker thread goes to the
+	///   back of that worker's deque, otherwise the workers are used in 
+	///   turn.
+	/// </summary>
+	/// <param name="task">The task to run.</param>
+	void task_scheduler::submit(std::function<void()> task)
+	{
+		unsigned int index;
+
+		if (t_scheduler == this)
+			index = t_index;
+		else
+			index = m_next++ % m_workers.size();
+
+		{
+			std::lock_guard<std::mutex> guard(m_workers[index]->lock);
+			m_workers[index]->tasks.push_back(std::move(task));
+		}
+		m_queued++;
+
+		// Lock to avoid waking before a sleeping worker has checked the queue
+		{
+			std::lock_guard<std::mutex> guard(m_sleep_lock);
+		}
+		m_wake.notify_one();
+	}
+
+	/// <summary>
+	///   Runs one queued task on the calling thread, if any. Used by threads
+	///   waiting on a task group so that they help rather than block.
+	/// </summary>
+	/// <returns>True if a task was run.</returns>
+	bool task_scheduler::run_one(void)
+	{
+		std::function<void()> task;
+		bool found;
+
+		if (t_scheduler == this)
+			found = pop(t_index, task) || steal(t_index, task);
+		else
+			found = steal(m_next % m_workers.size(), task);
+
+		if (found)
+		{
+			LINMAT_TRACE_SCOPE("task");
+			task();
+		}
+
+		return found;
+	}
+
+	/// <summary>
+	///   Gets the number of worker threads.
+	/// </summary>
+	/// <returns>Number of worker threads.</returns>
+	unsigned int task_scheduler::threads(void) const
+	{
+		return static_cast<unsigned int>(m_workers.size());
+	}
+
+	/// <summary>
+	///   Takes the most recently queued task from the back of a worker's 
+	///   own deque.
+	/// </summary>
+	/// <param name="index">Index of the worker.</param>
+	/// <param name="task">The task, if one was taken.</param>
+	/// <returns>True if a task was taken.</returns>
+	bool task_scheduler::pop(unsigned int index, std::function<void()>& task)
+	{
+		std::lock_guard<std::mutex> guard(m_workers[index]->lock);
+
+		if (m_workers[index]->tasks.empty())
+			return false;
+
+		task = std::move(m_workers[index]->tasks.back());
+		m_workers[index]->tasks.pop_back();
+		m_queued--;
+
+		return true;
+	}
+
+	/// <summary>
+	///   Takes the oldest task from the front of another worker's deque,
+	///   trying each worker in turn after the thief.
+	/// </summary>
+	/// <param name="thief">Index of the worker to start after.</param>
+	/// <param name="task">The task, if one was taken.</param>
+	/// <returns>True if a task was taken.</returns>
+	bool task_scheduler::steal(unsigned int thief, std::function<void()>& task)
+	{
+		unsigned int n = static_cast<unsigned int>(m_workers.size());
+
+		for (unsigned int i = 1; i <= n; i++)
+		{
+			worker& victim = *m_workers[(thief + i) % n];
+			std::lock_guard<std::mutex> guard(victim.lock);
+
+			if (!victim.tasks.empty())
+			{
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				m_queued--;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// <summary>
+	///   Worker thread loop, running tasks until the scheduler is stopped
+	///   and sleeping while no tasks are queued.
+	/// </summary>
+	/// <param name="index">Index of the worker.</param>
+	void task_scheduler::work(unsigned int index)
+	{
+		t_scheduler = this;
+		t_index = index;
+
+		while (true)
+		{
+			if (run_one())
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_sleep_lock);
+			m_wake.wait(lock, [this] { return m_stop || m_queued > 0; });
+			if (m_stop)
+				return;
+		}
+	}
+
+	/// <summary>
+	///   Constructor for an empty task group.
+	/// </summary>
+	/// <param name="scheduler">The scheduler to run tasks on.</param>
+	task_group::task_group(task_scheduler& scheduler)
+		: m_scheduler(scheduler), m_pending(0)
+	{
+	}
+
+	/// <summary>
+	///   Destructor waits for any tasks still running, discarding their 
+	///   exceptions.
+	/// </summary>
+	task_group::~task_group()
+	{
+		try
+		{
+			wait();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	/// <summary>
+	///   Forks a task onto the scheduler.
+	/// </summary>
+	/// <param name="task">The task to run.</param>
+	void task_group::run(std::function<void()> task)
+	{
+		m_pending++;
+		m_scheduler.submit([this, task]()
+			{
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> guard(m_error_lock);
+					if (!m_error)
+						m_error = std::current_exception();
+				}
+				m_pending--;
+			});
+	}
+
+	/// <summary>
+	///   Joins the tasks of the group, running queued tasks on the calling
+	///   thread until all have completed.
+	/// </summary>
+	void task_group::wait(void)
+	{
+		while (m_pending > 0)
+			if (!m_scheduler.run_one())
+				std::this_thread::yield();
+
+		if (m_error)
+		{
+			std::exception_ptr error = m_error;
+			m_error = nullptr;
+			std::rethrow_exception(error);
+		}
+	}
+
+	/// <summary>
+	///   Constructor for an empty task graph.
+	/// </summary>
+	/// <param name="scheduler">The scheduler to run tasks on.</param>
+	task_graph::task_graph(task_scheduler& scheduler)
+		: m_scheduler(scheduler)
+	{
+	}
+
+	/// <summary>
+	///   Adds a task to the graph, to be run after the tasks it depends on.
+	/// </summary>
+	/// <param name="task">The task to run.</param>
+	/// <param name="dependencies">Indices of tasks which must complete first.</param>
+	/// <returns>Index of the task in the graph.</returns>
+	unsigned int task_graph::add(std::function<void()> task, const std::vector<unsigned int>& dependencies)
+	{
+		unsigned int index = static_cast<unsigned int>(m_nodes.size());
+		std::unique_ptr<node> n(new node());
+
+		// Dependencies must already be in the graph, so it is acyclic
+		for (unsigned int d : dependencies)
+			if (d >= index)
+				throw std::runtime_error("Task dependency is not in the graph.");
+
+		n->task = std::move(task);
+		n->dependencies = static_cast<unsigned int>(dependencies.size());
+		for (unsigned int d : dependencies)
+			m_nodes[d]->successors.push_back(index);
+		m_nodes.push_back(std::move(n));
+
+		return index;
+	}
+
+	/// <summary>
+	///   Runs all the tasks of the graph and waits for them to complete. 
+	///   After an exception, tasks depending on the failed task are not run.
+	/// </summary>
+	void task_graph::run(void)
+	{
+		task_group group(m_scheduler);
+
+		for (std::unique_ptr<node>& n : m_nodes)
+			n->remaining = n->dependencies;
+		for (unsigned int i = 0; i < m_nodes.size(); i++)
+			if (m_nodes[i]->dependencies == 0)
+				start(group, i);
+
+		group.wait();
+	}
+
+	/// <summary>
+	///   Gets the number of tasks in the graph.
+	/// </summary>
+	/// <returns>Number of tasks.</returns>
+	unsigned int task_graph::size(void) const
+	{
+		return static_cast<unsigned int>(m_nodes.size());
+	}
+
+	/// <summary>
+	///   Starts a task whose dependencies have completed, then starts each
+	///   successor for which it was the last remaining dependency.
+	/// </summary>
+	/// <param name="group">The group the tasks are run in.</param>
+	/// <param name="index">Index of the task.</param>
+	void task_graph::start(task_group& group, unsigned int index)
+	{
+		group.run([this, &group, index]()
+			{
+				node& n = *m_nodes[index];
+				n.task();
+				for (unsigned int s : n.successors)
+					if (--m_nodes[s]->remaining == 0)
+						start(group, s);
+			});
+	}
+}
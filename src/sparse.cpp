@@ -0,0 +1,1108 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include "../inc/sparse.hpp"
+#include "../inc/scheduler.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Factory function which returns a sparse matrix from (row, column,
+	///   value) triplets in any order. Values of duplicate entries are summed.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="rows">Number of rows.</param>
+	/// <param name="cols">Number of columns.</param>
+	/// <param name="row_indices">The row index of each entry.</param>
+	/// <param name="col_indices">The column index of each entry.</param>
+	/// <param name="values">The value of each entry.</param>
+	/// <returns>A new sparse matrix.</returns>
+	template <typename T>
+	sparse_mat<T> sparse_mat<T>::from_triplets(
+		unsigned int rows,
+		unsigned int cols,
+		const std::vector<unsigned int>& row_indices,
+		const std::vector<unsigned int>& col_indices,
+		const std::vector<T>& values)
+	{
+		sparse_mat<T> result(rows, cols);
+		std::vector<unsigned int> order(values.size());
+
+		// Validate arguments
+		if (row_indices.size() != values.size() || col_indices.size() != values.size())
+			throw std::runtime_error("Triplet arrays must have equal lengths.");
+		for (unsigned int k = 0; k < values.size(); k++)
+			if (row_indices[k] >= rows || col_indices[k] >= cols)
+				throw std::runtime_error("Triplet index is out of range.");
+
+		// Sort the entries by row then column
+		for (unsigned int k = 0; k < order.size(); k++)
+			order[k] = k;
+		std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+			return row_indices[a] != row_indices[b]
+				? row_indices[a] < row_indices[b]
+				: col_indices[a] < col_indices[b];
+		});
+
+		// Compress, summing duplicates
+		for (unsigned int k = 0; k < order.size(); k++)
+		{
+			unsigned int e = order[k];
+			if (k > 0 && row_indices[e] == row_indices[order[k - 1]] && col_indices[e] == col_indices[order[k - 1]])
+				result.m_values.back() += values[e];
+			else
+			{
+				result.m_col_idx.push_back(col_indices[e]);
+				result.m_values.push_back(values[e]);
+				result.m_row_ptr[row_indices[e] + 1]++;
+			}
+		}
+		for (unsigned int i = 0; i < rows; i++)
+			result.m_row_ptr[i + 1] += result.m_row_ptr[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Sparse matrix class constructor, with no entries.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="rows">Number of rows.</param>
+	/// <param name="cols">Number of columns.</param>
+	template <typename T>
+	sparse_mat<T>::sparse_mat(unsigned int rows, unsigned int cols)
+		: m_rows(rows)
+		, m_cols(cols)
+		, m_row_ptr(rows + 1)
+	{
+	}
+
+	/// <summary>
+	///   Sparse matrix class constructor from the non-zero entries of a dense
+	///   matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The dense matrix.</param>
+	template <typename T>
+	sparse_mat<T>::sparse_mat(const mat<T>& m)
+		: sparse_mat(m.rows(), m.cols())
+	{
+		for (unsigned int i = 0; i < m_rows; i++)
+		{
+			for (unsigned int j = 0; j < m_cols; j++)
+				if (m[i][j] != 0)
+				{
+					m_col_idx.push_back(j);
+					m_values.push_back(m[i][j]);
+				}
+			m_row_ptr[i + 1] = static_cast<unsigned int>(m_values.size());
+		}
+	}
+
+	/// <summary>
+	///   Returns an entry of the matrix, which is zero if it is not stored.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A scalar value.</returns>
+	template <typename T>
+	T sparse_mat<T>::operator() (unsigned int i, unsigned int j) const
+	{
+		auto first = m_col_idx.begin() + m_row_ptr[i];
+		auto last = m_col_idx.begin() + m_row_ptr[i + 1];
+		auto it = std::lower_bound(first, last, j);
+
+		return (it != last && *it == j) ? m_values[it - m_col_idx.begin()] : 0;
+	}
+
+	/// <summary>
+	///   Multiplies a dense matrix on the left by the sparse matrix, in 
+	///   O(nnz.k) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> sparse_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(m_rows, other.cols());
+
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; k++)
+			{
+				T a = m_values[k];
+				const std::vector<T>& row = other[m_col_idx[k]];
+				for (unsigned int j = 0; j < other.cols(); j++)
+					result[i][j] += a * row[j];
+			}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies a vector by the sparse matrix in O(nnz) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The vector operand.</param>
+	/// <returns>A new vector which is the product.</returns>
+	template <typename T>
+	std::vector<T> sparse_mat<T>::mult(const std::vector<T>& x) const
+	{
+		std::vector<T> result(m_rows);
+
+		// Validate arguments
+		if (x.size() != m_cols)
+			throw std::runtime_error("Vector length must match columns in matrix.");
+
+		for (unsigned int i = 0; i < m_rows; i++)
+		{
+			T s = 0;
+			for (unsigned int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; k++)
+				s += m_values[k] * x[m_col_idx[k]];
+			result[i] = s;
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the transpose, which is also the compressed sparse column
+	///   form of the matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new sparse matrix which is the transpose.</returns>
+	template <typename T>
+	sparse_mat<T> sparse_mat<T>::transpose(void) const
+	{
+		sparse_mat<T> result(m_cols, m_rows);
+		std::vector<unsigned int> next(m_cols + 1);
+
+		// Count the entries in each column
+		for (unsigned int k = 0; k < nnz(); k++)
+			result.m_row_ptr[m_col_idx[k] + 1]++;
+		for (unsigned int j = 0; j < m_cols; j++)
+			result.m_row_ptr[j + 1] += result.m_row_ptr[j];
+
+		// Scatter the rows in order, so the new rows remain sorted
+		result.m_col_idx.resize(nnz());
+		result.m_values.resize(nnz());
+		std::copy(result.m_row_ptr.begin(), result.m_row_ptr.end(), next.begin());
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; k++)
+			{
+				unsigned int p = next[m_col_idx[k]]++;
+				result.m_col_idx[p] = i;
+				result.m_values[p] = m_values[k];
+			}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> sparse_mat<T>::dense(void) const
+	{
+		mat<T> result(m_rows, m_cols);
+
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; k++)
+				result[i][m_col_idx[k]] = m_values[k];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Flips an index for marking in the quotient graph, so that the 
+	///   flipped values are negative and distinct from -1.
+	/// </summary>
+	/// <param name="i">The index.</param>
+	/// <returns>The flipped index, -i - 2.</returns>
+	static int flip(int i)
+	{
+		return -i - 2;
+	}
+
+	/// <summary>
+	///   Clears the workspace marks when the mark would overflow.
+	/// </summary>
+	/// <param name="mark">The current mark.</param>
+	/// <param name="lemax">The largest element degree seen.</param>
+	/// <param name="w">The workspace.</param>
+	/// <param name="n">Number of nodes.</param>
+	/// <returns>The new mark, above every entry of w.</returns>
+	static long long clear_marks(long long mark, int lemax, std::vector<long long>& w, int n)
+	{
+		if (mark < 2 || mark > std::numeric_limits<long long>::max() / 2 - lemax)
+		{
+			for (int k = 0; k < n; k++)
+				if (w[k] != 0)
+					w[k] = 1;
+			mark = 2;
+		}
+		return mark;
+	}
+
+	/// <summary>
+	///   Calculates a fill-reducing ordering by approximate minimum degree 
+	///   (AMD), after Amestoy, Davis and Duff. Elimination is simulated on 
+	///   the quotient graph, in which each eliminated pivot is kept as an 
+	///   element listing its neighbors rather than forming a clique, so the
+	///   graph never grows beyond its initial size. Elements adjacent to a 
+	///   new pivot are absorbed into it, degrees are bounded from above by 
+	///   the sizes of the set differences of the elements instead of being
+	///   computed exactly, nodes with no neighbors outside the new element 
+	///   are eliminated with it, and nodes with identical adjacency are 
+	///   merged into supervariables. Dense rows are ordered last. The result
+	///   is postordered by the assembly tree, so that supernodes are formed 
+	///   from consecutive columns.
+	/// </summary>
+	/// <param name="n_nodes">Number of nodes.</param>
+	/// <param name="adj_ptr">The start of the neighbors of each node.</param>
+	/// <param name="adj_idx">The symmetric adjacency of the matrix, without the diagonal.</param>
+	/// <returns>The ordering, where pivot k is vertex perm[k].</returns>
+	static std::vector<unsigned int> amd_ordering(
+		unsigned int n_nodes,
+		const std::vector<unsigned int>& adj_ptr,
+		const std::vector<unsigned int>& adj_idx)
+	{
+		int n = static_cast<int>(n_nodes);
+		int cnz = static_cast<int>(adj_ptr[n_nodes]);
+		int dense = std::min(n - 2, std::max(16, static_cast<int>(10 * std::sqrt(static_cast<double>(n)))));
+		int nzmax = cnz + cnz / 5 + 2 * n;
+		std::vector<int> Cp(n + 1), Ci(nzmax);
+		std::vector<int> len(n + 1), nv(n + 1), next(n + 1), head(n + 1), last(n + 1);
+		std::vector<int> elen(n + 1), degree(n + 1), hhead(n + 1), post(n + 1);
+		std::vector<long long> w(n + 1);
+		int lemax = 0, mindeg = 0, nel = 0;
+		long long mark;
+
+		// Quotient graph, initially the graph of the matrix
+		for (int j = 0; j <= n; j++)
+			Cp[j] = static_cast<int>(adj_ptr[j]);
+		for (int p = 0; p < cnz; p++)
+			Ci[p] = static_cast<int>(adj_idx[p]);
+		for (int i = 0; i <= n; i++)
+		{
+			len[i] = i < n ? Cp[i + 1] - Cp[i] : 0;
+			head[i] = -1;
+			last[i] = -1;
+			next[i] = -1;
+			hhead[i] = -1;
+			nv[i] = 1;
+			w[i] = 1;
+			elen[i] = 0;
+			degree[i] = len[i];
+		}
+		mark = clear_marks(0, 0, w, n);
+
+		// Node n collects the dense rows, as a dead element
+		elen[n] = -2;
+		Cp[n] = -1;
+		w[n] = 0;
+
+		// Degree lists
+		for (int i = 0; i < n; i++)
+		{
+			int d = degree[i];
+			if (d == 0)
+			{
+				elen[i] = -2;
+				nel++;
+				Cp[i] = -1;
+				w[i] = 0;
+			}
+			else if (d > dense)
+			{
+				nv[i] = 0;
+				elen[i] = -1;
+				nel++;
+				Cp[i] = flip(n);
+				nv[n]++;
+			}
+			else
+			{
+				if (head[d] != -1)
+					last[head[d]] = i;
+				next[i] = head[d];
+				head[d] = i;
+			}
+		}
+
+		while (nel < n)
+		{
+			// Select the node of minimum approximate degree
+			int k = -1;
+			for (; mindeg < n && (k = head[mindeg]) == -1; mindeg++);
+			if (next[k] != -1)
+				last[next[k]] = -1;
+			head[mindeg] = next[k];
+			int elenk = elen[k];
+			int nvk = nv[k];
+			nel += nvk;
+
+			// Compact the graph if the new element may not fit
+			if (elenk > 0 && cnz + mindeg >= nzmax)
+			{
+				for (int j = 0; j < n; j++)
+				{
+					int p = Cp[j];
+					if (p >= 0)
+					{
+						Cp[j] = Ci[p];
+						Ci[p] = flip(j);
+					}
+				}
+				int q = 0;
+				for (int p = 0; p < cnz;)
+				{
+					int j = flip(Ci[p++]);
+					if (j >= 0)
+					{
+						Ci[q] = Cp[j];
+						Cp[j] = q++;
+						for (int k3 = 0; k3 < len[j] - 1; k3++)
+							Ci[q++] = Ci[p++];
+					}
+				}
+				cnz = q;
+			}
+
+			// Construct the new element Lk from the nodes of k and of the
+			// elements adjacent to k, absorbing those elements
+			int dk = 0;
+			nv[k] = -nvk;
+			int p = Cp[k];
+			int pk1 = elenk == 0 ? p : cnz;
+			int pk2 = pk1;
+			for (int k1 = 1; k1 <= elenk + 1; k1++)
+			{
+				int e, pj, ln;
+				if (k1 > elenk)
+				{
+					e = k;
+					pj = p;
+					ln = len[k] - elenk;
+				}
+				else
+				{
+					e = Ci[p++];
+					pj = Cp[e];
+					ln = len[e];
+				}
+				for (int k2 = 1; k2 <= ln; k2++)
+				{
+					int i = Ci[pj++];
+					int nvi = nv[i];
+					if (nvi <= 0)
+						continue;
+					dk += nvi;
+					nv[i] = -nvi;
+					Ci[pk2++] = i;
+					if (next[i] != -1)
+						last[next[i]] = last[i];
+					if (last[i] != -1)
+						next[last[i]] = next[i];
+					else
+						head[degree[i]] = next[i];
+				}
+				if (e != k)
+				{
+					Cp[e] = flip(k);
+					w[e] = 0;
+				}
+			}
+			if (elenk != 0)
+				cnz = pk2;
+			degree[k] = dk;
+			Cp[k] = pk1;
+			len[k] = pk2 - pk1;
+			elen[k] = -2;
+
+			// Sizes of the set differences |Le \ Lk| of the other elements
+			mark = clear_marks(mark, lemax, w, n);
+			for (int pk = pk1; pk < pk2; pk++)
+			{
+				int i = Ci[pk];
+				int eln = elen[i];
+				if (eln <= 0)
+					continue;
+				int nvi = -nv[i];
+				long long wnvi = mark - nvi;
+				for (p = Cp[i]; p <= Cp[i] + eln - 1; p++)
+				{
+					int e = Ci[p];
+					if (w[e] >= mark)
+						w[e] -= nvi;
+					else if (w[e] != 0)
+						w[e] = degree[e] + wnvi;
+				}
+			}
+
+			// Approximate degree of each node in Lk, pruning its lists
+			for (int pk = pk1; pk < pk2; pk++)
+			{
+				int i = Ci[pk];
+				int p1 = Cp[i];
+				int p2 = p1 + elen[i] - 1;
+				int pn = p1;
+				long long h = 0;
+				int d = 0;
+				for (p = p1; p <= p2; p++)
+				{
+					int e = Ci[p];
+					if (w[e] != 0)
+					{
+						int dext = static_cast<int>(w[e] - mark);
+						if (dext > 0)
+						{
+							d += dext;
+							Ci[pn++] = e;
+							h += e;
+						}
+						else
+						{
+							// Aggressive absorption of e, which lies within Lk
+							Cp[e] = flip(k);
+							w[e] = 0;
+						}
+					}
+				}
+				elen[i] = pn - p1 + 1;
+				int p3 = pn;
+				int p4 = p1 + len[i];
+				for (p = p2 + 1; p < p4; p++)
+				{
+					int j = Ci[p];
+					int nvj = nv[j];
+					if (nvj <= 0)
+						continue;
+					d += nvj;
+					Ci[pn++] = j;
+					h += j;
+				}
+				if (d == 0)
+				{
+					// Mass elimination of i with k
+					Cp[i] = flip(k);
+					int nvi = -nv[i];
+					dk -= nvi;
+					nvk += nvi;
+					nel += nvi;
+					nv[i] = 0;
+					elen[i] = -1;
+				}
+				else
+				{
+					degree[i] = std::min(degree[i], d);
+					Ci[pn] = Ci[p3];
+					Ci[p3] = Ci[p1];
+					Ci[p1] = k;
+					len[i] = pn - p1 + 1;
+					int bucket = static_cast<int>(h % n);
+					next[i] = hhead[bucket];
+					hhead[bucket] = i;
+					last[i] = bucket;
+				}
+			}
+			degree[k] = dk;
+			lemax = std::max(lemax, dk);
+			mark = clear_marks(mark + lemax, lemax, w, n);
+
+			// Merge nodes with identical adjacency into supervariables
+			for (int pk = pk1; pk < pk2; pk++)
+			{
+				int i = Ci[pk];
+				if (nv[i] >= 0)
+					continue;
+				int bucket = last[i];
+				i = hhead[bucket];
+				hhead[bucket] = -1;
+				for (; i != -1 && next[i] != -1; i = next[i], mark++)
+				{
+					int ln = len[i];
+					int eln = elen[i];
+					for (p = Cp[i] + 1; p <= Cp[i] + ln - 1; p++)
+						w[Ci[p]] = mark;
+					int jlast = i;
+					for (int j = next[i]; j != -1;)
+					{
+						bool same = len[j] == ln && elen[j] == eln;
+						for (p = Cp[j] + 1; same && p <= Cp[j] + ln - 1; p++)
+							if (w[Ci[p]] != mark)
+								same = false;
+						if (same)
+						{
+							Cp[j] = flip(i);
+							nv[i] += nv[j];
+							nv[j] = 0;
+							elen[j] = -1;
+							j = next[j];
+							next[jlast] = j;
+						}
+						else
+						{
+							jlast = j;
+							j = next[j];
+						}
+					}
+				}
+			}
+
+			// Finalize Lk, returning its nodes to the degree lists
+			p = pk1;
+			for (int pk = pk1; pk < pk2; pk++)
+			{
+				int i = Ci[pk];
+				int nvi = -nv[i];
+				if (nvi <= 0)
+					continue;
+				nv[i] = nvi;
+				int d = std::min(degree[i] + dk - nvi, n - nel - nvi);
+				if (head[d] != -1)
+					last[head[d]] = i;
+				next[i] = head[d];
+				last[i] = -1;
+				head[d] = i;
+				mindeg = std::min(mindeg, d);
+				degree[i] = d;
+				Ci[p++] = i;
+			}
+			nv[k] = nvk;
+			len[k] = p - pk1;
+			if (len[k] == 0)
+			{
+				Cp[k] = -1;
+				w[k] = 0;
+			}
+			if (elenk != 0)
+				cnz = p;
+		}
+
+		// Assembly tree, with each absorbed node a child of its element
+		for (int i = 0; i < n; i++)
+			Cp[i] = flip(Cp[i]);
+		for (int j = 0; j <= n; j++)
+			head[j] = -1;
+		for (int j = n; j >= 0; j--)
+			if (nv[j] <= 0)
+			{
+				next[j] = head[Cp[j]];
+				head[Cp[j]] = j;
+			}
+		for (int e = n; e >= 0; e--)
+			if (nv[e] > 0 && Cp[e] != -1)
+			{
+				next[e] = head[Cp[e]];
+				head[Cp[e]] = e;
+			}
+
+		// Postorder the tree by depth-first search from each root
+		int count = 0;
+		for (int i = 0; i <= n; i++)
+			if (Cp[i] == -1)
+			{
+				int top = 0;
+				w[0] = i;
+				while (top >= 0)
+				{
+					int q = static_cast<int>(w[top]);
+					int c = head[q];
+					if (c == -1)
+					{
+						top--;
+						post[count++] = q;
+					}
+					else
+					{
+						head[q] = next[c];
+						w[++top] = c;
+					}
+				}
+			}
+
+		// Drop node n, which is ordered last
+		std::vector<unsigned int> perm;
+		perm.reserve(n);
+		for (int k = 0; k < count; k++)
+			if (post[k] != n)
+				perm.push_back(static_cast<unsigned int>(post[k]));
+
+		return perm;
+	}
+
+	/// <summary>
+	///   Performs the ordering and symbolic analysis of a symmetric sparsity
+	///   pattern. The structure of each column of L is the union of the 
+	///   pattern of the permuted matrix below the diagonal and the structure
+	///   of its children in the elimination tree. Columns with nested 
+	///   structures and a single child are then merged into fundamental 
+	///   supernodes.
+	/// </summary>
+	/// <param name="n">Number of rows and columns.</param>
+	/// <param name="row_ptr">The start of each row of the pattern in CSR form.</param>
+	/// <param name="col_idx">The column index of each entry of the pattern.</param>
+	sparse_cholesky_analysis::sparse_cholesky_analysis(
+		unsigned int n,
+		const std::vector<unsigned int>& row_ptr,
+		const std::vector<unsigned int>& col_idx)
+		: m_n(n)
+		, m_inv_perm(n)
+		, m_parent(n, n)
+		, m_factor_nnz(0)
+	{
+		// Validate arguments
+		if (row_ptr.size() != n + 1 || row_ptr[n] > col_idx.size())
+			throw std::runtime_error("Pattern must be in CSR form.");
+
+		// Symmetric adjacency of the pattern, in CSR form without duplicates
+		std::vector<unsigned int> adj_ptr(n + 1), adj_idx, fill(n);
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+			{
+				unsigned int j = col_idx[k];
+				if (j >= n)
+					throw std::runtime_error("Pattern column index is out of range.");
+				if (i != j)
+				{
+					adj_ptr[i + 1]++;
+					adj_ptr[j + 1]++;
+				}
+			}
+		for (unsigned int i = 0; i < n; i++)
+			adj_ptr[i + 1] += adj_ptr[i];
+		adj_idx.resize(adj_ptr[n]);
+		for (unsigned int i = 0; i < n; i++)
+			fill[i] = adj_ptr[i];
+		for (unsigned int i = 0; i < n; i++)
+			for (unsigned int k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+			{
+				unsigned int j = col_idx[k];
+				if (i != j)
+				{
+					adj_idx[fill[i]++] = j;
+					adj_idx[fill[j]++] = i;
+				}
+			}
+		unsigned int nnz = 0;
+		for (unsigned int i = 0; i < n; i++)
+		{
+			std::vector<unsigned int>::iterator begin = adj_idx.begin() + adj_ptr[i];
+			std::sort(begin, adj_idx.begin() + adj_ptr[i + 1]);
+			std::vector<unsigned int>::iterator end = std::unique(begin, adj_idx.begin() + adj_ptr[i + 1]);
+			unsigned int count = static_cast<unsigned int>(end - begin);
+			if (nnz != adj_ptr[i])
+				std::copy(begin, end, adj_idx.begin() + nnz);
+			adj_ptr[i] = nnz;
+			nnz += count;
+		}
+		adj_ptr[n] = nnz;
+		adj_idx.resize(nnz);
+
+		// Fill-reducing ordering
+		m_perm = amd_ordering(n, adj_ptr, adj_idx);
+		for (unsigned int k = 0; k < n; k++)
+			m_inv_perm[m_perm[k]] = k;
+
+		// Structure of each column of L below the diagonal, and the etree
+		std::vector<std::vector<unsigned int>> structure(n);
+		std::vector<std::vector<unsigned int>> children(n);
+		for (unsigned int j = 0; j < n; j++)
+		{
+			std::vector<unsigned int> s;
+			for (unsigned int k = adj_ptr[m_perm[j]]; k < adj_ptr[m_perm[j] + 1]; k++)
+				if (m_inv_perm[adj_idx[k]] > j)
+					s.push_back(m_inv_perm[adj_idx[k]]);
+			std::sort(s.begin(), s.end());
+
+			for (unsigned int c : children[j])
+			{
+				std::vector<unsigned int> merged;
+				std::set_union(s.begin(), s.end(), structure[c].begin() + 1, structure[c].end(),
+					std::back_inserter(merged));
+				s.swap(merged);
+			}
+
+			structure[j].swap(s);
+			if (!structure[j].empty())
+			{
+				m_parent[j] = structure[j].front();
+				children[m_parent[j]].push_back(j);
+			}
+			m_factor_nnz += structure[j].size() + 1;
+		}
+
+		// Fundamental supernodes
+		m_first.push_back(0);
+		for (unsigned int j = 1; j < n; j++)
+			if (m_parent[j - 1] != j || children[j].size() != 1
+				|| structure[j - 1].size() != structure[j].size() + 1)
+				m_first.push_back(j);
+		m_first.push_back(n);
+
+		unsigned int count = supernodes();
+		std::vector<unsigned int> owner(n);
+		m_rows.resize(count);
+		for (unsigned int s = 0; s < count; s++)
+		{
+			unsigned int f = m_first[s];
+			for (unsigned int j = f; j < m_first[s + 1]; j++)
+				owner[j] = s;
+			m_rows[s].push_back(f);
+			m_rows[s].insert(m_rows[s].end(), structure[f].begin(), structure[f].end());
+			std::vector<unsigned int>().swap(structure[f]);
+		}
+
+		// Updating supernodes, and levels of the supernodal elimination tree
+		std::vector<unsigned int> level(count);
+		m_updaters.resize(count);
+		for (unsigned int s = 0; s < count; s++)
+		{
+			const std::vector<unsigned int>& rows = m_rows[s];
+			unsigned int last = n;
+			for (unsigned int k = columns(s); k < rows.size(); k++)
+				if (owner[rows[k]] != last)
+				{
+					last = owner[rows[k]];
+					m_updaters[last].push_back(s);
+				}
+
+			if (rows.size() > columns(s))
+			{
+				unsigned int p = owner[rows[columns(s)]];
+				level[p] = std::max(level[p], level[s] + 1);
+			}
+		}
+		for (unsigned int s = 0; s < count; s++)
+		{
+			if (level[s] >= m_levels.size())
+				m_levels.resize(level[s] + 1);
+			m_levels[level[s]].push_back(s);
+		}
+	}
+
+	/// <summary>
+	///   Performs the sparse Cholesky factorization, including the ordering
+	///   and symbolic analysis.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The symmetric positive-definite matrix, of which the lower triangle is used.</param>
+	/// <param name="threads">Number of parallel tasks, or zero for the number of scheduler threads.</param>
+	template <typename T>
+	sparse_cholesky_factorization<T>::sparse_cholesky_factorization(const sparse_mat<T>& A, unsigned int threads)
+		: m_analysis(std::make_shared<sparse_cholesky_analysis>(A))
+	{
+		factorize(A, threads);
+	}
+
+	/// <summary>
+	///   Performs the numeric sparse Cholesky factorization, reusing the
+	///   analysis of a matrix with the same pattern.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The symmetric positive-definite matrix, of which the lower triangle is used.</param>
+	/// <param name="analysis">The analysis of the pattern of A.</param>
+	/// <param name="threads">Number of parallel tasks, or zero for the number of scheduler threads.</param>
+	template <typename T>
+	sparse_cholesky_factorization<T>::sparse_cholesky_factorization(
+		const sparse_mat<T>& A,
+		std::shared_ptr<const sparse_cholesky_analysis> analysis,
+		unsigned int threads)
+		: m_analysis(analysis)
+	{
+		if (A.rows() != A.cols() || A.rows() != analysis->size())
+			throw std::runtime_error("Matrix dimensions must match the analysis.");
+
+		factorize(A, threads);
+	}
+
+	/// <summary>
+	///   Performs the numeric factorization. Supernodes in the same level of
+	///   the supernodal elimination tree have no dependencies on each other,
+	///   so each level is factorized in parallel.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="A">The symmetric positive-definite matrix.</param>
+	/// <param name="threads">Number of parallel tasks, or zero for the number of scheduler threads.</param>
+	template <typename T>
+	void sparse_cholesky_factorization<T>::factorize(const sparse_mat<T>& A, unsigned int threads)
+	{
+		const sparse_cholesky_analysis& an = *m_analysis;
+		unsigned int n = an.size();
+
+		// Lower triangle of the permuted matrix, by column
+		std::vector<std::vector<std::pair<unsigned int, T>>> columns(n);
+		const std::vector<unsigned int>& inv = an.inverse_permutation();
+		for (unsigned int r = 0; r < n; r++)
+			for (unsigned int k = A.row_ptr()[r]; k < A.row_ptr()[r + 1]; k++)
+			{
+				unsigned int c = A.col_idx()[k];
+				if (c <= r)
+				{
+					unsigned int i = std::max(inv[r], inv[c]);
+					unsigned int j = std::min(inv[r], inv[c]);
+					columns[j].push_back(std::make_pair(i, A.values()[k]));
+				}
+			}
+
+		m_blocks.assign(an.supernodes(), std::vector<T>());
+		if (threads == 0)
+			threads = std::max(1u, task_scheduler::instance().threads());
+
+		// Row maps of size n, allocated once for each task slot and reused
+		// at every level
+		std::vector<std::vector<unsigned int>> maps(threads);
+
+		for (const std::vector<unsigned int>& level : an.levels())
+		{
+			unsigned int workers = std::min(threads, static_cast<unsigned int>(level.size()));
+			std::atomic<unsigned int> next(0);
+
+			auto work = [&](unsigned int slot) {
+				std::vector<unsigned int>& map = maps[slot];
+				if (map.empty())
+					map.assign(n, n);
+				try
+				{
+					for (unsigned int k = next++; k < level.size(); k = next++)
+					{
+						LINMAT_TRACE_ITERATION("sparse_cholesky::supernode", level[k]);
+						factorize_supernode(level[k], columns, map);
+					}
+				}
+				catch (...)
+				{
+					next = static_cast<unsigned int>(level.size());
+					throw;
+				}
+			};
+
+			// Small levels run on this thread, and larger levels as tasks on
+			// the scheduler's long-lived workers
+			if (workers <= 1)
+				work(0);
+			else
+			{
+				task_group group;
+				for (unsigned int t = 0; t < workers; t++)
+					group.run([&work, t]() { work(t); });
+				group.wait();
+			}
+		}
+	}
+
+	/// <summary>
+	///   Factorizes one supernode by left-looking updates from the finished
+	///   supernodes below it, followed by a dense Cholesky factorization of 
+	///   its panel.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="s">The supernode.</param>
+	/// <param name="columns">The lower triangle of the permuted matrix, by column.</param>
+	/// <param name="map">Workspace of size n, holding n for every row.</param>
+	template <typename T>
+	void sparse_cholesky_factorization<T>::factorize_supernode(
+		unsigned int s,
+		const std::vector<std::vector<std::pair<unsigned int, T>>>& columns,
+		std::vector<unsigned int>& map)
+	{
+		const sparse_cholesky_analysis& an = *m_analysis;
+		const std::vector<unsigned int>& rows = an.row_structure(s);
+		unsigned int f = an.first_column(s);
+		unsigned int nc = an.columns(s);
+		unsigned int nr = static_cast<unsigned int>(rows.size());
+		std::vector<T> block(static_cast<std::size_t>(nr) * nc);
+
+		// Scatter the matrix entries into the panel
+		for (unsigned int k = 0; k < nr; k++)
+			map[rows[k]] = k;
+		for (unsigned int c = 0; c < nc; c++)
+			for (const std::pair<unsigned int, T>& entry : columns[f + c])
+			{
+				if (map[entry.first] == map.size())
+					throw std::runtime_error("Matrix pattern does not match the analysis.");
+				block[static_cast<std::size_t>(c) * nr + map[entry.first]] += entry.second;
+			}
+
+		// Subtract the contributions of each updating supernode
+		for (unsigned int d : an.updaters(s))
+		{
+			const std::vector<unsigned int>& drows = an.row_structure(d);
+			const std::vector<T>& dblock = m_blocks[d];
+			unsigned int dnc = an.columns(d);
+			unsigned int dnr = static_cast<unsigned int>(drows.size());
+
+			// Rows of d which fall in the columns of s
+			unsigned int p = static_cast<unsigned int>(
+				std::lower_bound(drows.begin() + dnc, drows.end(), f) - drows.begin());
+			unsigned int q = p;
+			while (q < dnr && drows[q] < f + nc)
+				q++;
+
+			for (unsigned int a = p; a < q; a++)
+			{
+				std::size_t target = static_cast<std::size_t>(drows[a] - f) * nr;
+				for (unsigned int b = a; b < dnr; b++)
+				{
+					T sum = 0;
+					for (unsigned int c = 0; c < dnc; c++)
+						sum += dblock[static_cast<std::size_t>(c) * dnr + b] * dblock[static_cast<std::size_t>(c) * dnr + a];
+					block[target + map[drows[b]]] -= sum;
+				}
+			}
+		}
+
+		// Dense Cholesky factorization of the panel, column by column
+		for (unsigned int c = 0; c < nc; c++)
+		{
+			T* col = &block[static_cast<std::size_t>(c) * nr];
+			for (unsigned int k = 0; k < c; k++)
+			{
+				const T* prev = &block[static_cast<std::size_t>(k) * nr];
+				T l = prev[c];
+				for (unsigned int r = c; r < nr; r++)
+					col[r] -= l * prev[r];
+			}
+			if (!(col[c] > 0))
+				throw std::runtime_error("Matrix must be positive-definite.");
+			T d = std::sqrt(col[c]);
+			col[c] = d;
+			for (unsigned int r = c + 1; r < nr; r++)
+				col[r] /= d;
+		}
+
+		for (unsigned int k = 0; k < nr; k++)
+			map[rows[k]] = static_cast<unsigned int>(map.size());
+		m_blocks[s].swap(block);
+	}
+
+	/// <summary>
+	///   Solves A.X = B by permuting B, forward and back substitution with 
+	///   the supernodal factor, and permuting the result back.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> sparse_cholesky_factorization<T>::solve_factor(const mat<T>& b) const
+	{
+		const sparse_cholesky_analysis& an = *m_analysis;
+		unsigned int n = size();
+		unsigned int m = b.cols();
+		mat<T> y(n, m), x(n, m);
+
+		// Validate arguments
+		if (b.rows() != n)
+			throw std::runtime_error("Rows in right-hand side must match the factorized matrix.");
+
+		for (unsigned int i = 0; i < n; i++)
+			y[i] = b[an.permutation()[i]];
+
+		// Solve L.Z = P.B
+		for (unsigned int s = 0; s < an.supernodes(); s++)
+		{
+			const std::vector<unsigned int>& rows = an.row_structure(s);
+			unsigned int nr = static_cast<unsigned int>(rows.size());
+			for (unsigned int c = 0; c < an.columns(s); c++)
+			{
+				const T* col = &m_blocks[s][static_cast<std::size_t>(c) * nr];
+				std::vector<T>& yc = y[rows[c]];
+				for (unsigned int j = 0; j < m; j++)
+					yc[j] /= col[c];
+				for (unsigned int r = c + 1; r < nr; r++)
+					for (unsigned int j = 0; j < m; j++)
+						y[rows[r]][j] -= col[r] * yc[j];
+			}
+		}
+
+		// Solve L^T.W = Z
+		for (unsigned int s = an.supernodes(); s-- > 0;)
+		{
+			const std::vector<unsigned int>& rows = an.row_structure(s);
+			unsigned int nr = static_cast<unsigned int>(rows.size());
+			for (unsigned int c = an.columns(s); c-- > 0;)
+			{
+				const T* col = &m_blocks[s][static_cast<std::size_t>(c) * nr];
+				std::vector<T>& yc = y[rows[c]];
+				for (unsigned int r = c + 1; r < nr; r++)
+					for (unsigned int j = 0; j < m; j++)
+						yc[j] -= col[r] * y[rows[r]][j];
+				for (unsigned int j = 0; j < m; j++)
+					yc[j] /= col[c];
+			}
+		}
+
+		for (unsigned int i = 0; i < n; i++)
+			x[an.permutation()[i]] = y[i];
+
+		return x;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the squared product of the diagonal
+	///   of the factor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T sparse_cholesky_factorization<T>::det_factor() const
+	{
+		const sparse_cholesky_analysis& an = *m_analysis;
+		T result = 1;
+
+		for (unsigned int s = 0; s < an.supernodes(); s++)
+		{
+			std::size_t nr = an.row_structure(s).size();
+			for (unsigned int c = 0; c < an.columns(s); c++)
+			{
+				T d = m_blocks[s][c * nr + c];
+				result *= d * d;
+			}
+		}
+
+		return result;
+	}
+
+	// Explicit template instantiations
+	template class sparse_mat<float>;
+	template class sparse_mat<double>;
+	template class sparse_mat<long double>;
+	template class sparse_cholesky_factorization<float>;
+	template class sparse_cholesky_factorization<double>;
+	template class sparse_cholesky_factorization<long double>;
+}
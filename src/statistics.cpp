@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <stdexcept>
+#include "../inc/statistics.hpp"
+#include "../inc/operators.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Gram accumulator class constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="cols">Number of columns in each row.</param>
+	template <typename T>
+	gram_accumulator<T>::gram_accumulator(unsigned int cols)
+		: m_cols(cols)
+		, m_count(0)
+		, m_mean(cols)
+		, m_comoment(mat<T>::make_zeros(cols, cols))
+	{
+	}
+
+	/// <summary>
+	///   Accumulates a block of rows. The block is centered on its own mean 
+	///   and reduced with a single SYRK-style Gram product, which is then 
+	///   merged into the running totals.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="block">A kxn block of rows.</param>
+	template <typename T>
+	void gram_accumulator<T>::add(const mat<T>& block)
+	{
+		gram_accumulator<T> other(m_cols);
+
+		if (block.cols() != m_cols)
+			throw std::runtime_error("Columns in block must match the accumulator.");
+		if (block.rows() == 0)
+			return;
+
+		// Mean of the block
+		for (unsigned int i = 0; i < block.rows(); i++)
+			for (unsigned int j = 0; j < m_cols; j++)
+				other.m_mean[j] += block[i][j];
+		for (unsigned int j = 0; j < m_cols; j++)
+			other.m_mean[j] /= block.rows();
+
+		// Co-moment of the centered block
+		mat<T> centered(block);
+		for (unsigned int i = 0; i < block.rows(); i++)
+			for (unsigned int j = 0; j < m_cols; j++)
+				centered[i][j] -= other.m_mean[j];
+		other.m_comoment = centered.gram();
+		other.m_count = block.rows();
+
+		merge(other);
+	}
+
+	/// <summary>
+	///   Merges the rows accumulated by another accumulator, using the 
+	///   pairwise update of Chan et al. This allows blocks to be accumulated
+	///   independently, for example on separate threads.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">An accumulator with the same number of columns.</param>
+	template <typename T>
+	void gram_accumulator<T>::merge(const gram_accumulator<T>& other)
+	{
+		if (other.m_cols != m_cols)
+			throw std::runtime_error("Columns in accumulators must match.");
+		if (other.m_count == 0)
+			return;
+
+		T n_a = static_cast<T>(m_count);
+		T n_b = static_cast<T>(other.m_count);
+		T n = n_a + n_b;
+		std::vector<T> delta(m_cols);
+		for (unsigned int j = 0; j < m_cols; j++)
+			delta[j] = other.m_mean[j] - m_mean[j];
+
+		// M = M_a + M_b + delta.delta^T.n_a.n_b / n, upper triangle mirrored
+		T w = n_a * n_b / n;
+		for (unsigned int i = 0; i < m_cols; i++)
+			for (unsigned int j = i; j < m_cols; j++)
+			{
+				T m = m_comoment[i][j] + other.m_comoment[i][j] + w * delta[i] * delta[j];
+				m_comoment[i][j] = m;
+				m_comoment[j][i] = m;
+			}
+
+		for (unsigned int j = 0; j < m_cols; j++)
+			m_mean[j] += delta[j] * n_b / n;
+		m_count += other.m_count;
+	}
+
+	/// <summary>
+	///   Returns the mean of the accumulated rows.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A 1xn matrix.</returns>
+	template <typename T>
+	mat<T> gram_accumulator<T>::mean() const
+	{
+		mat<T> result(1, m_cols);
+
+		result[0] = m_mean;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the Gram matrix X^T.X of the accumulated rows, recovered from
+	///   the co-moment as M + n.mu.mu^T.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new symmetric nxn matrix.</returns>
+	template <typename T>
+	mat<T> gram_accumulator<T>::gram() const
+	{
+		mat<T> result(m_comoment);
+		T n = static_cast<T>(m_count);
+
+		for (unsigned int i = 0; i < m_cols; i++)
+			for (unsigned int j = 0; j < m_cols; j++)
+				result[i][j] += n * m_mean[i] * m_mean[j];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the sample covariance matrix of the accumulated rows.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new symmetric nxn matrix.</returns>
+	template <typename T>
+	mat<T> gram_accumulator<T>::covariance() const
+	{
+		if (m_count < 2)
+			throw std::runtime_error("Covariance requires at least two rows.");
+
+		return m_comoment / static_cast<T>(m_count - 1);
+	}
+
+	// Explicit template instantiations
+	template class gram_accumulator<float>;
+	template class gram_accumulator<double>;
+	template class gram_accumulator<long double>;
+}
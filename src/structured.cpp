@@ -0,0 +1,948 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <stdexcept>
+#include "../inc/structured.hpp"
+#include "../inc/operators.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Diagonal matrix class constructor, with the diagonal zeroed.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of rows and columns.</param>
+	template <typename T>
+	diag_mat<T>::diag_mat(unsigned int n)
+		: m_diag(n)
+	{
+	}
+
+	/// <summary>
+	///   Diagonal matrix class constructor from the diagonal entries.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="diagonal">The diagonal entries.</param>
+	template <typename T>
+	diag_mat<T>::diag_mat(const std::vector<T>& diagonal)
+		: m_diag(diagonal)
+	{
+	}
+
+	/// <summary>
+	///   Diagonal matrix class constructor from initializer.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="args">The diagonal entries.</param>
+	template <typename T>
+	diag_mat<T>::diag_mat(const std::initializer_list<T>& args)
+		: m_diag(args)
+	{
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the diagonal matrix, scaling its
+	///   rows in O(mn) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> diag_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(other);
+
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < rows(); i++)
+			for (unsigned int j = 0; j < other.cols(); j++)
+				result[i][j] *= m_diag[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies two diagonal matrices.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new diagonal matrix which is the product.</returns>
+	template <typename T>
+	diag_mat<T> diag_mat<T>::mult(const diag_mat<T>& other) const
+	{
+		diag_mat<T> result(m_diag);
+
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result[i] *= other[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the inverse as the reciprocals of the diagonal.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new diagonal matrix which is the inverse.</returns>
+	template <typename T>
+	diag_mat<T> diag_mat<T>::inv(void) const
+	{
+		diag_mat<T> result(rows());
+
+		for (unsigned int i = 0; i < rows(); i++)
+		{
+			if (m_diag[i] == 0)
+				throw std::runtime_error("Matrix is singular.");
+			result[i] = 1 / m_diag[i];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the product of the diagonal.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T diag_mat<T>::det(void) const
+	{
+		T result = 1;
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result *= m_diag[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the trace as the sum of the diagonal.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The trace.</returns>
+	template <typename T>
+	T diag_mat<T>::trace(void) const
+	{
+		T result = 0;
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result += m_diag[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> diag_mat<T>::dense(void) const
+	{
+		mat<T> result(rows(), cols());
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result[i][i] = m_diag[i];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Adds a multiple of the diagonal matrix to a dense matrix in place.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The dense matrix to add to.</param>
+	/// <param name="alpha">The multiple to add.</param>
+	template <typename T>
+	void diag_mat<T>::add_to(mat<T>& m, T alpha) const
+	{
+		if (m.rows() != rows() || m.cols() != cols())
+			throw std::runtime_error("Matrix dimensions must be equivalent for element-wise addition.");
+
+		for (unsigned int i = 0; i < rows(); i++)
+			m[i][i] += alpha * m_diag[i];
+	}
+
+	/// <summary>
+	///   Scaled identity matrix class constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of rows and columns.</param>
+	/// <param name="alpha">The scale of the identity.</param>
+	template <typename T>
+	identity<T>::identity(unsigned int n, T alpha)
+		: m_n(n)
+		, m_alpha(alpha)
+	{
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> identity<T>::mult(const mat<T>& other) const
+	{
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		return other * m_alpha;
+	}
+
+	/// <summary>
+	///   Calculates the inverse of the scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new scaled identity which is the inverse.</returns>
+	template <typename T>
+	identity<T> identity<T>::inv(void) const
+	{
+		if (m_alpha == 0)
+			throw std::runtime_error("Matrix is singular.");
+
+		return identity<T>(m_n, 1 / m_alpha);
+	}
+
+	/// <summary>
+	///   Calculates the determinant of the scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The determinant.</returns>
+	template <typename T>
+	T identity<T>::det(void) const
+	{
+		T result = 1;
+
+		for (unsigned int i = 0; i < m_n; i++)
+			result *= m_alpha;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the trace of the scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>The trace.</returns>
+	template <typename T>
+	T identity<T>::trace(void) const
+	{
+		return m_alpha * m_n;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> identity<T>::dense(void) const
+	{
+		mat<T> result(m_n, m_n);
+
+		for (unsigned int i = 0; i < m_n; i++)
+			result[i][i] = m_alpha;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Adds a multiple of the scaled identity to a dense matrix in place.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The dense matrix to add to.</param>
+	/// <param name="alpha">The multiple to add.</param>
+	template <typename T>
+	void identity<T>::add_to(mat<T>& m, T alpha) const
+	{
+		if (m.rows() != m_n || m.cols() != m_n)
+			throw std::runtime_error("Matrix dimensions must be equivalent for element-wise addition.");
+
+		for (unsigned int i = 0; i < m_n; i++)
+			m[i][i] += alpha * m_alpha;
+	}
+
+	/// <summary>
+	///   Permutation matrix class constructor, with the identity permutation.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="n">Number of rows and columns.</param>
+	template <typename T>
+	perm_mat<T>::perm_mat(unsigned int n)
+		: m_perm(n)
+	{
+		for (unsigned int i = 0; i < n; i++)
+			m_perm[i] = i;
+	}
+
+	/// <summary>
+	///   Permutation matrix class constructor from a permutation, such as 
+	///   the one returned by lu_factorization::permutation().
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="perm">The column of the unit entry in each row.</param>
+	template <typename T>
+	perm_mat<T>::perm_mat(const std::vector<unsigned int>& perm)
+		: m_perm(perm)
+	{
+		std::vector<bool> seen(perm.size());
+
+		// Validate the permutation
+		for (unsigned int i = 0; i < perm.size(); i++)
+		{
+			if (perm[i] >= perm.size() || seen[perm[i]])
+				throw std::runtime_error("Not a permutation.");
+			seen[perm[i]] = true;
+		}
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the permutation matrix, 
+	///   reordering its rows.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> perm_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(other.rows(), other.cols());
+
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result[i] = other[m_perm[i]];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies two permutation matrices by composing the permutations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new permutation matrix which is the product.</returns>
+	template <typename T>
+	perm_mat<T> perm_mat<T>::mult(const perm_mat<T>& other) const
+	{
+		perm_mat<T> result(rows());
+
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result.m_perm[i] = other.m_perm[m_perm[i]];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the inverse, which is the transpose.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new permutation matrix which is the inverse.</returns>
+	template <typename T>
+	perm_mat<T> perm_mat<T>::inv(void) const
+	{
+		return transpose();
+	}
+
+	/// <summary>
+	///   Calculates the transpose by inverting the permutation.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new permutation matrix which is the transpose.</returns>
+	template <typename T>
+	perm_mat<T> perm_mat<T>::transpose(void) const
+	{
+		perm_mat<T> result(rows());
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result.m_perm[m_perm[i]] = i;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the determinant as the sign of the permutation, from 
+	///   the parity of its cycles.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>Either 1 or -1.</returns>
+	template <typename T>
+	T perm_mat<T>::det(void) const
+	{
+		std::vector<bool> visited(rows());
+		T result = 1;
+
+		for (unsigned int i = 0; i < rows(); i++)
+		{
+			// Each cycle of even length changes the sign
+			unsigned int length = 0;
+			for (unsigned int j = i; !visited[j]; j = m_perm[j])
+			{
+				visited[j] = true;
+				length++;
+			}
+			if (length > 0 && length % 2 == 0)
+				result = -result;
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> perm_mat<T>::dense(void) const
+	{
+		mat<T> result(rows(), cols());
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result[i][m_perm[i]] = 1;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Adds a multiple of the permutation matrix to a dense matrix in place.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The dense matrix to add to.</param>
+	/// <param name="alpha">The multiple to add.</param>
+	template <typename T>
+	void perm_mat<T>::add_to(mat<T>& m, T alpha) const
+	{
+		if (m.rows() != rows() || m.cols() != cols())
+			throw std::runtime_error("Matrix dimensions must be equivalent for element-wise addition.");
+
+		for (unsigned int i = 0; i < rows(); i++)
+			m[i][m_perm[i]] += alpha;
+	}
+
+	/// <summary>
+	///   Constant matrix class constructor.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="rows">Number of rows.</param>
+	/// <param name="cols">Number of columns.</param>
+	/// <param name="value">The value of every entry.</param>
+	template <typename T>
+	const_mat<T>::const_mat(unsigned int rows, unsigned int cols, T value)
+		: m_rows(rows)
+		, m_cols(cols)
+		, m_value(value)
+	{
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the constant matrix. Every row of
+	///   the product is the column sums of the operand, scaled by the value.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> const_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(m_rows, other.cols());
+		std::vector<T> sums(other.cols());
+
+		// Validate arguments
+		if (m_cols != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int i = 0; i < other.rows(); i++)
+			for (unsigned int j = 0; j < other.cols(); j++)
+				sums[j] += other[i][j];
+		for (unsigned int j = 0; j < other.cols(); j++)
+			sums[j] *= m_value;
+		for (unsigned int i = 0; i < m_rows; i++)
+			result[i] = sums;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Calculates the transpose of the constant matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new constant matrix which is the transpose.</returns>
+	template <typename T>
+	const_mat<T> const_mat<T>::transpose(void) const
+	{
+		return const_mat<T>(m_cols, m_rows, m_value);
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> const_mat<T>::dense(void) const
+	{
+		mat<T> result(m_rows, m_cols);
+
+		for (unsigned int i = 0; i < m_rows; i++)
+			std::fill(result[i].begin(), result[i].end(), m_value);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Adds a multiple of the constant matrix to a dense matrix in place.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The dense matrix to add to.</param>
+	/// <param name="alpha">The multiple to add.</param>
+	template <typename T>
+	void const_mat<T>::add_to(mat<T>& m, T alpha) const
+	{
+		if (m.rows() != m_rows || m.cols() != m_cols)
+			throw std::runtime_error("Matrix dimensions must be equivalent for element-wise addition.");
+
+		T a = alpha * m_value;
+		for (unsigned int i = 0; i < m_rows; i++)
+			for (unsigned int j = 0; j < m_cols; j++)
+				m[i][j] += a;
+	}
+
+	/// <summary>
+	///   Diagonal matrix multiplication with a scalar.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right scalar operand.</param>
+	/// <returns>A new diagonal matrix which is the result of the multiplication.</returns>
+	template <typename T>
+	diag_mat<T> operator*(const diag_mat<T>& lhs, const T& rhs)
+	{
+		diag_mat<T> result(lhs);
+
+		for (unsigned int i = 0; i < lhs.rows(); i++)
+			result[i] *= rhs;
+
+		return result;
+	}
+
+	/// <summary>
+	///   Diagonal matrix multiplication with a scalar.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left scalar operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new diagonal matrix which is the result of the multiplication.</returns>
+	template <typename T>
+	diag_mat<T> operator*(const T& lhs, const diag_mat<T>& rhs)
+	{
+		return rhs * lhs;
+	}
+
+	/// <summary>
+	///   Scaled identity multiplication with a scalar.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right scalar operand.</param>
+	/// <returns>A new scaled identity which is the result of the multiplication.</returns>
+	template <typename T>
+	identity<T> operator*(const identity<T>& lhs, const T& rhs)
+	{
+		return identity<T>(lhs.rows(), lhs.scale() * rhs);
+	}
+
+	/// <summary>
+	///   Scaled identity multiplication with a scalar.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left scalar operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new scaled identity which is the result of the multiplication.</returns>
+	template <typename T>
+	identity<T> operator*(const T& lhs, const identity<T>& rhs)
+	{
+		return rhs * lhs;
+	}
+
+	/// <summary>
+	///   Constant matrix multiplication with a scalar.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right scalar operand.</param>
+	/// <returns>A new constant matrix which is the result of the multiplication.</returns>
+	template <typename T>
+	const_mat<T> operator*(const const_mat<T>& lhs, const T& rhs)
+	{
+		return const_mat<T>(lhs.rows(), lhs.cols(), lhs.value() * rhs);
+	}
+
+	/// <summary>
+	///   Constant matrix multiplication with a scalar.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left scalar operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new constant matrix which is the result of the multiplication.</returns>
+	template <typename T>
+	const_mat<T> operator*(const T& lhs, const const_mat<T>& rhs)
+	{
+		return rhs * lhs;
+	}
+
+	/// <summary>
+	///   Addition operator between a dense matrix and a diagonal matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const diag_mat<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a diagonal matrix and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const diag_mat<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result(rhs);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a dense matrix and a diagonal matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const diag_mat<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, -1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a diagonal matrix and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const diag_mat<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result = rhs * static_cast<T>(-1);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a dense matrix and a scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const identity<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a scaled identity and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const identity<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result(rhs);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a dense matrix and a scaled identity.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const identity<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, -1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a scaled identity and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const identity<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result = rhs * static_cast<T>(-1);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a dense matrix and a permutation matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const perm_mat<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a permutation matrix and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const perm_mat<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result(rhs);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a dense matrix and a permutation matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const perm_mat<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, -1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a permutation matrix and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const perm_mat<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result = rhs * static_cast<T>(-1);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a dense matrix and a constant matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const mat<T>& lhs, const const_mat<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Addition operator between a constant matrix and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the sum.</returns>
+	template <typename T>
+	mat<T> operator+(const const_mat<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result(rhs);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a dense matrix and a constant matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const mat<T>& lhs, const const_mat<T>& rhs)
+	{
+		mat<T> result(lhs);
+		rhs.add_to(result, -1);
+		return result;
+	}
+
+	/// <summary>
+	///   Subtraction operator between a constant matrix and a dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="lhs">The left matrix operand.</param>
+	/// <param name="rhs">The right matrix operand.</param>
+	/// <returns>A new dense matrix which is the difference.</returns>
+	template <typename T>
+	mat<T> operator-(const const_mat<T>& lhs, const mat<T>& rhs)
+	{
+		mat<T> result = rhs * static_cast<T>(-1);
+		lhs.add_to(result, 1);
+		return result;
+	}
+
+	// Explicit template instantiations
+	template class diag_mat<float>;
+	template class diag_mat<double>;
+	template class diag_mat<long double>;
+	template class identity<float>;
+	template class identity<double>;
+	template class identity<long double>;
+	template class perm_mat<float>;
+	template class perm_mat<double>;
+	template class perm_mat<long double>;
+	template class const_mat<float>;
+	template class const_mat<double>;
+	template class const_mat<long double>;
+	template diag_mat<float> operator*(const diag_mat<float>& lhs, const float& rhs);
+	template diag_mat<double> operator*(const diag_mat<double>& lhs, const double& rhs);
+	template diag_mat<long double> operator*(const diag_mat<long double>& lhs, const long double& rhs);
+	template diag_mat<float> operator*(const float& lhs, const diag_mat<float>& rhs);
+	template diag_mat<double> operator*(const double& lhs, const diag_mat<double>& rhs);
+	template diag_mat<long double> operator*(const long double& lhs, const diag_mat<long double>& rhs);
+	template identity<float> operator*(const identity<float>& lhs, const float& rhs);
+	template identity<double> operator*(const identity<double>& lhs, const double& rhs);
+	template identity<long double> operator*(const identity<long double>& lhs, const long double& rhs);
+	template identity<float> operator*(const float& lhs, const identity<float>& rhs);
+	template identity<double> operator*(const double& lhs, const identity<double>& rhs);
+	template identity<long double> operator*(const long double& lhs, const identity<long double>& rhs);
+	template const_mat<float> operator*(const const_mat<float>& lhs, const float& rhs);
+	template const_mat<double> operator*(const const_mat<double>& lhs, const double& rhs);
+	template const_mat<long double> operator*(const const_mat<long double>& lhs, const long double& rhs);
+	template const_mat<float> operator*(const float& lhs, const const_mat<float>& rhs);
+	template const_mat<double> operator*(const double& lhs, const const_mat<double>& rhs);
+	template const_mat<long double> operator*(const long double& lhs, const const_mat<long double>& rhs);
+	template mat<float> operator+(const mat<float>& lhs, const diag_mat<float>& rhs);
+	template mat<double> operator+(const mat<double>& lhs, const diag_mat<double>& rhs);
+	template mat<long double> operator+(const mat<long double>& lhs, const diag_mat<long double>& rhs);
+	template mat<float> operator+(const diag_mat<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator+(const diag_mat<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator+(const diag_mat<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator-(const mat<float>& lhs, const diag_mat<float>& rhs);
+	template mat<double> operator-(const mat<double>& lhs, const diag_mat<double>& rhs);
+	template mat<long double> operator-(const mat<long double>& lhs, const diag_mat<long double>& rhs);
+	template mat<float> operator-(const diag_mat<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator-(const diag_mat<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator-(const diag_mat<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator+(const mat<float>& lhs, const identity<float>& rhs);
+	template mat<double> operator+(const mat<double>& lhs, const identity<double>& rhs);
+	template mat<long double> operator+(const mat<long double>& lhs, const identity<long double>& rhs);
+	template mat<float> operator+(const identity<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator+(const identity<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator+(const identity<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator-(const mat<float>& lhs, const identity<float>& rhs);
+	template mat<double> operator-(const mat<double>& lhs, const identity<double>& rhs);
+	template mat<long double> operator-(const mat<long double>& lhs, const identity<long double>& rhs);
+	template mat<float> operator-(const identity<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator-(const identity<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator-(const identity<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator+(const mat<float>& lhs, const perm_mat<float>& rhs);
+	template mat<double> operator+(const mat<double>& lhs, const perm_mat<double>& rhs);
+	template mat<long double> operator+(const mat<long double>& lhs, const perm_mat<long double>& rhs);
+	template mat<float> operator+(const perm_mat<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator+(const perm_mat<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator+(const perm_mat<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator-(const mat<float>& lhs, const perm_mat<float>& rhs);
+	template mat<double> operator-(const mat<double>& lhs, const perm_mat<double>& rhs);
+	template mat<long double> operator-(const mat<long double>& lhs, const perm_mat<long double>& rhs);
+	template mat<float> operator-(const perm_mat<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator-(const perm_mat<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator-(const perm_mat<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator+(const mat<float>& lhs, const const_mat<float>& rhs);
+	template mat<double> operator+(const mat<double>& lhs, const const_mat<double>& rhs);
+	template mat<long double> operator+(const mat<long double>& lhs, const const_mat<long double>& rhs);
+	template mat<float> operator+(const const_mat<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator+(const const_mat<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator+(const const_mat<long double>& lhs, const mat<long double>& rhs);
+	template mat<float> operator-(const mat<float>& lhs, const const_mat<float>& rhs);
+	template mat<double> operator-(const mat<double>& lhs, const const_mat<double>& rhs);
+	template mat<long double> operator-(const mat<long double>& lhs, const const_mat<long double>& rhs);
+	template mat<float> operator-(const const_mat<float>& lhs, const mat<float>& rhs);
+	template mat<double> operator-(const const_mat<double>& lhs, const mat<double>& rhs);
+	template mat<long double> operator-(const const_mat<long double>& lhs, const mat<long double>& rhs);
+}
@@ -0,0 +1,538 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../inc/text_io.hpp"
+#include "../inc/scheduler.hpp"
+
+namespace linmat
+{
+	// Size of text below which files are parsed or formatted on one thread
+	static const std::size_t TEXT_CHUNK_MIN = static_cast<std::size_t>(1) << 20;
+
+	/// <summary>
+	///   Reads a whole file into memory.
+	/// </summary>
+	/// <param name="path">Path of the file.</param>
+	/// <returns>The contents of the file.</returns>
+	static std::string read_file(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+			throw std::runtime_error("Unable to open file.");
+
+		std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+		file.seekg(0);
+		file.read(&text[0], static_cast<std::streamsize>(text.size()));
+		if (!file)
+			throw std::runtime_error("Unable to read file.");
+
+		return text;
+	}
+
+	/// <summary>
+	///   Writes pieces of text to a file in order.
+	/// </summary>
+	/// <param name="path">Path of the file, which is replaced if it exists.</param>
+	/// <param name="pieces">The text to write.</param>
+	static void write_file(const std::string& path, const std::vector<std::string>& pieces)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		for (const std::string& piece : pieces)
+			file.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+
+		file.close();
+		if (!file)
+			throw std::runtime_error("Unable to write file.");
+	}
+
+	/// <summary>
+	///   Splits text into chunks of whole lines, one per scheduler thread 
+	///   for large text.
+	/// </summary>
+	/// <param name="text">The text.</param>
+	/// <param name="begin">Offset of the first line.</param>
+	/// <returns>Offsets of the start of each chunk, followed by the end of the text.</returns>
+	static std::vector<std::size_t> split_lines(const std::string& text, std::size_t begin)
+	{
+		std::size_t size = text.size() - begin;
+		std::size_t chunks = size < TEXT_CHUNK_MIN ? 1 : task_scheduler::instance().threads();
+		std::vector<std::size_t> offsets{ begin };
+
+		for (std::size_t c = 1; c < chunks; c++)
+		{
+			std::size_t offset = std::max(offsets.back(), begin + size * c / chunks);
+			offset = text.find('\n', offset);
+			if (offset == std::string::npos)
+				break;
+			offsets.push_back(offset + 1);
+		}
+		offsets.push_back(text.size());
+
+		return offsets;
+	}
+
+	/// <summary>
+	///   Runs a function on each chunk of text as scheduler tasks.
+	/// </summary>
+	/// <typeparam name="F">Function taking the chunk index, start and end.</typeparam>
+	/// <param name="offsets">Offsets of the chunks, followed by the end.</param>
+	/// <param name="chunk">The function which processes a chunk.</param>
+	template <typename F>
+	static void for_each_chunk(const std::vector<std::size_t>& offsets, F chunk)
+	{
+		if (offsets.size() == 2)
+		{
+			chunk(0, offsets[0], offsets[1]);
+			return;
+		}
+
+		task_group group;
+		for (std::size_t c = 0; c + 1 < offsets.size(); c++)
+			group.run([&chunk, &offsets, c]() { chunk(c, offsets[c], offsets[c + 1]); });
+		group.wait();
+	}
+
+	/// <summary>
+	///   Skips spaces and tabs.
+	/// </summary>
+	/// <param name="p">Position in the text.</param>
+	/// <param name="end">End of the line.</param>
+	/// <returns>Position of the next other character.</returns>
+	static const char* skip_blanks(const char* p, const char* end)
+	{
+		while (p < end && (*p == ' ' || *p == '\t'))
+			p++;
+		return p;
+	}
+
+	/// <summary>
+	///   Gets the end of the line, excluding any carriage return.
+	/// </summary>
+	/// <param name="p">Start of the line.</param>
+	/// <param name="end">End of the text.</param>
+	/// <param name="next">Start of the next line.</param>
+	/// <returns>End of the line.</returns>
+	static const char* line_end(const char* p, const char* end, const char*& next)
+	{
+		const char* e = std::find(p, end, '\n');
+		next = e < end ? e + 1 : end;
+		if (e > p && e[-1] == '\r')
+			e--;
+		return e;
+	}
+
+	/// <summary>
+	///   Parses a number, after any spaces and a leading plus sign.
+	/// </summary>
+	/// <typeparam name="V">Number type.</typeparam>
+	/// <param name="p">Position in the text.</param>
+	/// <param name="end">End of the line.</param>
+	/// <param name="value">The parsed number.</param>
+	/// <returns>Position after the number.</returns>
+	template <typename V>
+	static const char* parse_number(const char* p, const char* end, V& value)
+	{
+		p = skip_blanks(p, end);
+		if (p < end && *p == '+')
+			p++;
+
+		std::from_chars_result result = std::from_chars(p, end, value);
+		if (result.ec != std::errc())
+			throw std::runtime_error("Unable to parse number.");
+
+		return result.ptr;
+	}
+
+	/// <summary>
+	///   Appends the shortest text which reads back as the same number.
+	/// </summary>
+	/// <typeparam name="V">Number type.</typeparam>
+	/// <param name="out">The text to append to.</param>
+	/// <param name="value">The number.</param>
+	template <typename V>
+	static void append_number(std::string& out, V value)
+	{
+		char buffer[64];
+		std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+		out.append(buffer, result.ptr);
+	}
+
+	/// <summary>
+	///   Parses a line of delimited values.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="p">Start of the line.</param>
+	/// <param name="end">End of the line.</param>
+	/// <param name="delimiter">Separator of the values.</param>
+	/// <param name="row">Storage for the values, or null to count them.</param>
+	/// <param name="cols">Number of values the storage holds.</param>
+	/// <returns>Number of values on the line.</returns>
+	template <typename T>
+	static unsigned int parse_delimited(const char* p, const char* end, char delimiter, T* row, unsigned int cols)
+	{
+		bool blank_delimiter = delimiter == ' ' || delimiter == '\t';
+		unsigned int count = 0;
+
+		while (true)
+		{
+			T value;
+			p = skip_blanks(parse_number(p, end, value), end);
+			if (row != nullptr)
+			{
+				if (count == cols)
+					throw std::runtime_error("CSV rows must have the same number of values.");
+				row[count] = value;
+			}
+			count++;
+			if (p == end)
+				break;
+			if (!blank_delimiter && *p++ != delimiter)
+				throw std::runtime_error("Unable to parse CSV file.");
+		}
+
+		return count;
+	}
+
+	/// <summary>
+	///   Reads a matrix from a file of delimited values, with one row per 
+	///   line. Blank lines are ignored. The lines of each chunk are counted,
+	///   then the chunks are parsed in parallel directly into their rows.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file.</param>
+	/// <param name="delimiter">Separator of the values, where a space or tab also allows runs of blanks.</param>
+	/// <returns>A new matrix with the values of the file.</returns>
+	template <typename T>
+	mat<T> read_csv(const std::string& path, char delimiter)
+	{
+		std::string text = read_file(path);
+		std::vector<std::size_t> offsets = split_lines(text, 0);
+		std::vector<unsigned int> first_row(offsets.size(), 0);
+		const char* text_end = text.data() + text.size();
+		unsigned int cols = 0;
+
+		// Count the values on the first line
+		for (const char* p = text.data(); p < text_end && cols == 0; )
+		{
+			const char* next;
+			const char* e = line_end(p, text_end, next);
+			if (skip_blanks(p, e) < e)
+				cols = parse_delimited<T>(p, e, delimiter, nullptr, 0);
+			p = next;
+		}
+
+		// Count the lines of each chunk
+		for_each_chunk(offsets, [&](std::size_t c, std::size_t begin, std::size_t end)
+			{
+				const char* chunk_end = text.data() + end;
+				unsigned int count = 0;
+				for (const char* p = text.data() + begin; p < chunk_end; )
+				{
+					const char* next;
+					const char* e = line_end(p, chunk_end, next);
+					if (skip_blanks(p, e) < e)
+						count++;
+					p = next;
+				}
+				first_row[c + 1] = count;
+			});
+		for (std::size_t c = 1; c < first_row.size(); c++)
+			first_row[c] += first_row[c - 1];
+
+		// Parse the lines of each chunk into their rows
+		mat<T> result(first_row.back(), cols);
+		for_each_chunk(offsets, [&](std::size_t c, std::size_t begin, std::size_t end)
+			{
+				const char* chunk_end = text.data() + end;
+				unsigned int i = first_row[c];
+				for (const char* p = text.data() + begin; p < chunk_end; )
+				{
+					const char* next;
+					const char* e = line_end(p, chunk_end, next);
+					if (skip_blanks(p, e) < e)
+					{
+						if (parse_delimited(p, e, delimiter, result[i].data(), cols) != cols)
+							throw std::runtime_error("CSV rows must have the same number of values.");
+						i++;
+					}
+					p = next;
+				}
+			});
+
+		return result;
+	}
+
+	/// <summary>
+	///   Writes a matrix to a file of delimited values, with one row per 
+	///   line. Each value is written with the fewest digits which read back
+	///   as the same value. Chunks of rows are formatted in parallel.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The matrix.</param>
+	/// <param name="path">Path of the file, which is replaced if it exists.</param>
+	/// <param name="delimiter">Separator of the values.</param>
+	template <typename T>
+	void write_csv(const mat<T>& m, const std::string& path, char delimiter)
+	{
+		std::size_t size = static_cast<std::size_t>(m.rows()) * m.cols() * 16;
+		unsigned int chunks = size < TEXT_CHUNK_MIN ? 1 : std::min(m.rows(), task_scheduler::instance().threads());
+		std::vector<std::size_t> offsets;
+		for (unsigned int c = 0; c <= chunks; c++)
+			offsets.push_back(static_cast<std::size_t>(m.rows()) * c / std::max(chunks, 1u));
+		std::vector<std::string> pieces(std::max(chunks, 1u));
+
+		for_each_chunk(offsets, [&](std::size_t c, std::size_t begin, std::size_t end)
+			{
+				std::string& out = pieces[c];
+				out.reserve((end - begin) * m.cols() * 16);
+				for (std::size_t i = begin; i < end; i++)
+				{
+					for (unsigned int j = 0; j < m.cols(); j++)
+					{
+						if (j > 0)
+							out.push_back(delimiter);
+						append_number(out, m[static_cast<unsigned int>(i)][j]);
+					}
+					out.push_back('\n');
+				}
+			});
+
+		write_file(path, pieces);
+	}
+
+	/// <summary>
+	///   Reads a sparse matrix from a Matrix Market file. Both the 
+	///   coordinate and array formats are read, with real, integer or 
+	///   pattern values, and general, symmetric or skew-symmetric structure.
+	///   Chunks of entries are parsed in parallel.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="path">Path of the file.</param>
+	/// <returns>A new sparse matrix with the entries of the file.</returns>
+	template <typename T>
+	sparse_mat<T> read_matrix_market(const std::string& path)
+	{
+		std::string text = read_file(path);
+		const char* text_end = text.data() + text.size();
+		const char* p = text.data();
+		const char* next;
+		const char* e = line_end(p, text_end, next);
+
+		// Parse the banner
+		std::istringstream banner(std::string(p, e));
+		std::string magic, object, format, field, symmetry;
+		banner >> magic >> object >> format >> field >> symmetry;
+		for (std::string* word : { &object, &format, &field, &symmetry })
+			std::transform(word->begin(), word->end(), word->begin(), [](char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); });
+		if (magic != "%%MatrixMarket" || object != "matrix")
+			throw std::runtime_error("Not a Matrix Market file.");
+		bool coordinate = format == "coordinate";
+		bool pattern = field == "pattern";
+		bool symmetric = symmetry == "symmetric";
+		bool skew = symmetry == "skew-symmetric";
+		if ((!coordinate && format != "array") || (field != "real" && field != "integer" && !pattern)
+			|| (!symmetric && !skew && symmetry != "general") || (pattern && !coordinate))
+			throw std::runtime_error("Unsupported Matrix Market format.");
+
+		// Skip comments and parse the size line
+		for (p = next; p < text_end; p = next)
+		{
+			e = line_end(p, text_end, next);
+			const char* q = skip_blanks(p, e);
+			if (q < e && *q != '%')
+				break;
+		}
+		if (p == text_end)
+			throw std::runtime_error("Matrix Market file is truncated.");
+		unsigned int rows, cols, entries;
+		p = parse_number(p, e, rows);
+		p = parse_number(p, e, cols);
+		if (coordinate)
+			parse_number(p, e, entries);
+		else if (symmetric || skew)
+			entries = rows == 0 ? 0 : (skew ? rows * (rows - 1) / 2 : rows * (rows + 1) / 2);
+		else
+			entries = rows * cols;
+		if ((symmetric || skew) && rows != cols)
+			throw std::runtime_error("Symmetric Matrix Market matrix must be square.");
+
+		// Parse the entries of each chunk
+		std::vector<std::size_t> offsets = split_lines(text, static_cast<std::size_t>(next - text.data()));
+		std::vector<std::vector<unsigned int>> chunk_rows(offsets.size() - 1), chunk_cols(offsets.size() - 1);
+		std::vector<std::vector<T>> chunk_values(offsets.size() - 1);
+		for_each_chunk(offsets, [&](std::size_t c, std::size_t begin, std::size_t end)
+			{
+				const char* chunk_end = text.data() + end;
+				for (const char* q = text.data() + begin; q < chunk_end; )
+				{
+					const char* line_next;
+					const char* line = line_end(q, chunk_end, line_next);
+					if (skip_blanks(q, line) < line && *skip_blanks(q, line) != '%')
+					{
+						unsigned int i = 0, j = 0;
+						T value = 1;
+						if (coordinate)
+						{
+							q = parse_number(q, line, i);
+							q = parse_number(q, line, j);
+							if (i == 0 || j == 0 || i > rows || j > cols)
+								throw std::runtime_error("Matrix Market entry is out of range.");
+							i--;
+							j--;
+						}
+						if (!pattern)
+							parse_number(q, line, value);
+						chunk_rows[c].push_back(i);
+						chunk_cols[c].push_back(j);
+						chunk_values[c].push_back(value);
+					}
+					q = line_next;
+				}
+			});
+
+		// Gather the entries, placing array entries in column order
+		std::vector<unsigned int> row_indices, col_indices;
+		std::vector<T> values;
+		for (std::size_t c = 0; c < chunk_values.size(); c++)
+		{
+			row_indices.insert(row_indices.end(), chunk_rows[c].begin(), chunk_rows[c].end());
+			col_indices.insert(col_indices.end(), chunk_cols[c].begin(), chunk_cols[c].end());
+			values.insert(values.end(), chunk_values[c].begin(), chunk_values[c].end());
+		}
+		if (values.size() != entries)
+			throw std::runtime_error("Matrix Market file is truncated.");
+		if (!coordinate)
+		{
+			unsigned int k = 0;
+			for (unsigned int j = 0; j < cols; j++)
+				for (unsigned int i = symmetric ? j : skew ? j + 1 : 0; i < rows; i++, k++)
+				{
+					row_indices[k] = i;
+					col_indices[k] = j;
+				}
+		}
+
+		// Mirror the entries of a symmetric or skew-symmetric matrix
+		if (symmetric || skew)
+			for (std::size_t k = 0, n = values.size(); k < n; k++)
+				if (row_indices[k] != col_indices[k])
+				{
+					row_indices.push_back(col_indices[k]);
+					col_indices.push_back(row_indices[k]);
+					values.push_back(skew ? -values[k] : values[k]);
+				}
+
+		return sparse_mat<T>::from_triplets(rows, cols, row_indices, col_indices, values);
+	}
+
+	/// <summary>
+	///   Writes a sparse matrix to a Matrix Market file in the general real
+	///   coordinate format.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The sparse matrix.</param>
+	/// <param name="path">Path of the file, which is replaced if it exists.</param>
+	template <typename T>
+	void write_matrix_market(const sparse_mat<T>& m, const std::string& path)
+	{
+		std::vector<std::string> pieces(1);
+		std::string& out = pieces[0];
+
+		out = "%%MatrixMarket matrix coordinate real general\n";
+		append_number(out, m.rows());
+		out.push_back(' ');
+		append_number(out, m.cols());
+		out.push_back(' ');
+		append_number(out, m.nnz());
+		out.push_back('\n');
+		out.reserve(out.size() + static_cast<std::size_t>(m.nnz()) * 32);
+		for (unsigned int i = 0; i < m.rows(); i++)
+			for (unsigned int k = m.row_ptr()[i]; k < m.row_ptr()[i + 1]; k++)
+			{
+				append_number(out, i + 1);
+				out.push_back(' ');
+				append_number(out, m.col_idx()[k] + 1);
+				out.push_back(' ');
+				append_number(out, m.values()[k]);
+				out.push_back('\n');
+			}
+
+		write_file(path, pieces);
+	}
+
+	/// <summary>
+	///   Writes a matrix to a Matrix Market file in the general real array
+	///   format, which lists the elements by column.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="m">The matrix.</param>
+	/// <param name="path">Path of the file, which is replaced if it exists.</param>
+	template <typename T>
+	void write_matrix_market(const mat<T>& m, const std::string& path)
+	{
+		std::vector<std::string> pieces(1);
+		std::string& out = pieces[0];
+
+		out = "%%MatrixMarket matrix array real general\n";
+		append_number(out, m.rows());
+		out.push_back(' ');
+		append_number(out, m.cols());
+		out.push_back('\n');
+		out.reserve(out.size() + static_cast<std::size_t>(m.rows()) * m.cols() * 16);
+		for (unsigned int j = 0; j < m.cols(); j++)
+			for (unsigned int i = 0; i < m.rows(); i++)
+			{
+				append_number(out, m[i][j]);
+				out.push_back('\n');
+			}
+
+		write_file(path, pieces);
+	}
+
+	// Explicit template instantiations
+	template mat<float> read_csv<float>(const std::string& path, char delimiter);
+	template mat<double> read_csv<double>(const std::string& path, char delimiter);
+	template mat<long double> read_csv<long double>(const std::string& path, char delimiter);
+	template void write_csv(const mat<float>& m, const std::string& path, char delimiter);
+	template void write_csv(const mat<double>& m, const std::string& path, char delimiter);
+	template void write_csv(const mat<long double>& m, const std::string& path, char delimiter);
+	template sparse_mat<float> read_matrix_market<float>(const std::string& path);
+	template sparse_mat<double> read_matrix_market<double>(const std::string& path);
+	template sparse_mat<long double> read_matrix_market<long double>(const std::string& path);
+	template void write_matrix_market(const sparse_mat<float>& m, const std::string& path);
+	template void write_matrix_market(const sparse_mat<double>& m, const std::string& path);
+	template void write_matrix_market(const sparse_mat<long double>& m, const std::string& path);
+	template void write_matrix_market(const mat<float>& m, const std::string& path);
+	template void write_matrix_market(const mat<double>& m, const std::string& path);
+	template void write_matrix_market(const mat<long double>& m, const std::string& path);
+}
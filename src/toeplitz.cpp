@@ -0,0 +1,418 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "../inc/toeplitz.hpp"
+#include "../inc/fft.hpp"
+
+namespace linmat
+{
+	/// <summary>
+	///   Circulant matrix class constructor. The eigenvalues, which are the
+	///   transform of the first column, are calculated once.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="first_col">The first column.</param>
+	template <typename T>
+	circulant_mat<T>::circulant_mat(const std::vector<T>& first_col)
+		: m_col(first_col)
+		, m_eigenvalues(first_col.begin(), first_col.end())
+	{
+		if (first_col.empty())
+			throw std::runtime_error("Matrix dimensions must be greater than zero.");
+
+		fft(m_eigenvalues);
+	}
+
+	/// <summary>
+	///   Returns an entry of the circulant matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A scalar value.</returns>
+	template <typename T>
+	T circulant_mat<T>::operator() (unsigned int i, unsigned int j) const
+	{
+		return m_col[(i + rows() - j) % rows()];
+	}
+
+	/// <summary>
+	///   Multiplies a vector by the circulant matrix in O(n log n) 
+	///   operations, as a circular convolution with the first column.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The vector operand.</param>
+	/// <returns>A new vector which is the product.</returns>
+	template <typename T>
+	std::vector<T> circulant_mat<T>::mult(const std::vector<T>& x) const
+	{
+		std::vector<std::complex<T>> y(x.begin(), x.end());
+		std::vector<T> result(x.size());
+
+		// Validate arguments
+		if (x.size() != cols())
+			throw std::runtime_error("Vector length must match columns in matrix.");
+
+		fft(y);
+		for (unsigned int k = 0; k < y.size(); k++)
+			y[k] *= m_eigenvalues[k];
+		fft(y, true);
+
+		for (unsigned int i = 0; i < y.size(); i++)
+			result[i] = y[i].real();
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the circulant matrix, one column
+	///   at a time, in O(k.n log n) operations.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> circulant_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(rows(), other.cols());
+		std::vector<T> x(other.rows());
+
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int j = 0; j < other.cols(); j++)
+		{
+			for (unsigned int i = 0; i < other.rows(); i++)
+				x[i] = other[i][j];
+			std::vector<T> y = mult(x);
+			for (unsigned int i = 0; i < rows(); i++)
+				result[i][j] = y[i];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves C.x = b in O(n log n) operations by dividing the transform of
+	///   b by the eigenvalues.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The right-hand side.</param>
+	/// <returns>A new vector which is the solution.</returns>
+	template <typename T>
+	std::vector<T> circulant_mat<T>::solve(const std::vector<T>& b) const
+	{
+		std::vector<std::complex<T>> y(b.begin(), b.end());
+		std::vector<T> result(b.size());
+
+		// Validate arguments
+		if (b.size() != rows())
+			throw std::runtime_error("Rows in right-hand side must match the matrix.");
+
+		// Treat eigenvalues which are negligible relative to the largest as zero
+		T largest = 0;
+		for (const std::complex<T>& lambda : m_eigenvalues)
+			largest = std::max(largest, std::abs(lambda));
+		T tol = largest * rows() * std::numeric_limits<T>::epsilon();
+
+		fft(y);
+		for (unsigned int k = 0; k < y.size(); k++)
+		{
+			if (!(std::abs(m_eigenvalues[k]) > tol))
+				throw std::runtime_error("Matrix is singular.");
+			y[k] /= m_eigenvalues[k];
+		}
+		fft(y, true);
+
+		for (unsigned int i = 0; i < y.size(); i++)
+			result[i] = y[i].real();
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves C.X = B one column at a time.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> circulant_mat<T>::solve(const mat<T>& b) const
+	{
+		mat<T> result(rows(), b.cols());
+		std::vector<T> y(b.rows());
+
+		for (unsigned int j = 0; j < b.cols(); j++)
+		{
+			for (unsigned int i = 0; i < b.rows(); i++)
+				y[i] = b[i][j];
+			std::vector<T> x = solve(y);
+			for (unsigned int i = 0; i < rows(); i++)
+				result[i][j] = x[i];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> circulant_mat<T>::dense(void) const
+	{
+		mat<T> result(rows(), cols());
+
+		for (unsigned int i = 0; i < rows(); i++)
+			for (unsigned int j = 0; j < cols(); j++)
+				result[i][j] = (*this)(i, j);
+
+		return result;
+	}
+
+	/// <summary>
+	///   Toeplitz matrix class constructor. The first column of a circulant
+	///   embedding, with a power of two size of at least m+n-1, is 
+	///   transformed once.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="first_col">The first column, of length m.</param>
+	/// <param name="first_row">The first row, of length n.</param>
+	template <typename T>
+	toeplitz_mat<T>::toeplitz_mat(const std::vector<T>& first_col, const std::vector<T>& first_row)
+		: m_col(first_col)
+		, m_row(first_row)
+	{
+		if (first_col.empty() || first_row.empty())
+			throw std::runtime_error("Matrix dimensions must be greater than zero.");
+		if (first_col[0] != first_row[0])
+			throw std::runtime_error("First column and row must share their first entry.");
+
+		std::size_t m = first_col.size(), n = first_row.size();
+		std::size_t size = 1;
+		while (size < m + n - 1)
+			size <<= 1;
+
+		// Column then reversed row, wrapping around the embedding
+		m_embedding.resize(size);
+		for (std::size_t i = 0; i < m; i++)
+			m_embedding[i] = first_col[i];
+		for (std::size_t j = 1; j < n; j++)
+			m_embedding[size - j] = first_row[j];
+		fft(m_embedding);
+	}
+
+	/// <summary>
+	///   Returns an entry of the Toeplitz matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="i">The row index.</param>
+	/// <param name="j">The column index.</param>
+	/// <returns>A scalar value.</returns>
+	template <typename T>
+	T toeplitz_mat<T>::operator() (unsigned int i, unsigned int j) const
+	{
+		return i >= j ? m_col[i - j] : m_row[j - i];
+	}
+
+	/// <summary>
+	///   Multiplies a vector by the Toeplitz matrix in O(N log N) operations,
+	///   where N is the size of the circulant embedding.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="x">The vector operand.</param>
+	/// <returns>A new vector which is the product.</returns>
+	template <typename T>
+	std::vector<T> toeplitz_mat<T>::mult(const std::vector<T>& x) const
+	{
+		std::vector<std::complex<T>> y(m_embedding.size());
+		std::vector<T> result(rows());
+
+		// Validate arguments
+		if (x.size() != cols())
+			throw std::runtime_error("Vector length must match columns in matrix.");
+
+		// Zero-padded product with the circulant embedding
+		std::copy(x.begin(), x.end(), y.begin());
+		fft(y);
+		for (std::size_t k = 0; k < y.size(); k++)
+			y[k] *= m_embedding[k];
+		fft(y, true);
+
+		for (unsigned int i = 0; i < rows(); i++)
+			result[i] = y[i].real();
+
+		return result;
+	}
+
+	/// <summary>
+	///   Multiplies a matrix on the left by the Toeplitz matrix, one column at
+	///   a time.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="other">The right matrix operand.</param>
+	/// <returns>A new matrix which is the product.</returns>
+	template <typename T>
+	mat<T> toeplitz_mat<T>::mult(const mat<T>& other) const
+	{
+		mat<T> result(rows(), other.cols());
+		std::vector<T> x(other.rows());
+
+		// Validate arguments
+		if (cols() != other.rows())
+			throw std::runtime_error("Rows in right matrix must match columns in left matrix.");
+
+		for (unsigned int j = 0; j < other.cols(); j++)
+		{
+			for (unsigned int i = 0; i < other.rows(); i++)
+				x[i] = other[i][j];
+			std::vector<T> y = mult(x);
+			for (unsigned int i = 0; i < rows(); i++)
+				result[i][j] = y[i];
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	///   Solves T.X = B for a square Toeplitz matrix in O(n^2) operations 
+	///   using the Levinson recursion. The forward and backward vectors of
+	///   each leading principal submatrix are built up one order at a time,
+	///   so every leading principal submatrix must be non-singular.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The block of right-hand sides.</param>
+	/// <returns>A new matrix which is the solution.</returns>
+	template <typename T>
+	mat<T> toeplitz_mat<T>::solve(const mat<T>& b) const
+	{
+		unsigned int n = rows();
+		mat<T> x(n, b.cols());
+
+		// Validate arguments
+		if (rows() != cols())
+			throw std::runtime_error("Levinson recursion requires a square matrix.");
+		if (b.rows() != n)
+			throw std::runtime_error("Rows in right-hand side must match the matrix.");
+		if (m_col[0] == 0)
+			throw std::runtime_error("Leading principal submatrix is singular.");
+
+		// Forward and backward vectors of order one
+		std::vector<T> f(1, 1 / m_col[0]);
+		std::vector<T> g(f);
+		for (unsigned int j = 0; j < b.cols(); j++)
+			x[0][j] = b[0][j] / m_col[0];
+
+		for (unsigned int m = 1; m < n; m++)
+		{
+			// Errors from extending the vectors with a zero
+			T e_f = 0, e_g = 0;
+			for (unsigned int i = 0; i < m; i++)
+			{
+				e_f += m_col[m - i] * f[i];
+				e_g += m_row[i + 1] * g[i];
+			}
+			T denom = 1 - e_f * e_g;
+			if (denom == 0)
+				throw std::runtime_error("Leading principal submatrix is singular.");
+
+			// Vectors of order m+1
+			std::vector<T> f_next(m + 1), g_next(m + 1);
+			for (unsigned int i = 0; i <= m; i++)
+			{
+				T f_i = i < m ? f[i] : 0;
+				T g_i = i > 0 ? g[i - 1] : 0;
+				f_next[i] = (f_i - e_f * g_i) / denom;
+				g_next[i] = (g_i - e_g * f_i) / denom;
+			}
+			f.swap(f_next);
+			g.swap(g_next);
+
+			// Correct each solution with the backward vector
+			for (unsigned int j = 0; j < b.cols(); j++)
+			{
+				T e_x = 0;
+				for (unsigned int i = 0; i < m; i++)
+					e_x += m_col[m - i] * x[i][j];
+				T d = b[m][j] - e_x;
+				for (unsigned int i = 0; i <= m; i++)
+					x[i][j] += d * g[i];
+			}
+		}
+
+		return x;
+	}
+
+	/// <summary>
+	///   Solves T.x = b for a square Toeplitz matrix using the Levinson
+	///   recursion.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <param name="b">The right-hand side.</param>
+	/// <returns>A new vector which is the solution.</returns>
+	template <typename T>
+	std::vector<T> toeplitz_mat<T>::solve(const std::vector<T>& b) const
+	{
+		mat<T> rhs(static_cast<unsigned int>(b.size()), 1);
+		std::vector<T> result(b.size());
+
+		for (unsigned int i = 0; i < b.size(); i++)
+			rhs[i][0] = b[i];
+		mat<T> x = solve(rhs);
+		for (unsigned int i = 0; i < b.size(); i++)
+			result[i] = x[i][0];
+
+		return result;
+	}
+
+	/// <summary>
+	///   Returns the equivalent dense matrix.
+	/// </summary>
+	/// <typeparam name="T">Element floating-point type (i.e. double).</typeparam>
+	/// <returns>A new dense matrix.</returns>
+	template <typename T>
+	mat<T> toeplitz_mat<T>::dense(void) const
+	{
+		mat<T> result(rows(), cols());
+
+		for (unsigned int i = 0; i < rows(); i++)
+			for (unsigned int j = 0; j < cols(); j++)
+				result[i][j] = (*this)(i, j);
+
+		return result;
+	}
+
+	// Explicit template instantiations
+	template class circulant_mat<float>;
+	template class circulant_mat<double>;
+	template class circulant_mat<long double>;
+	template class toeplitz_mat<float>;
+	template class toeplitz_mat<double>;
+	template class toeplitz_mat<long double>;
+}
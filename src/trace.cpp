@@ -0,0 +1,205 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "../inc/constants.hpp"
+#include "../inc/trace.hpp"
+
+namespace linmat
+{
+	namespace trace
+	{
+		/// <summary>
+		///   Ring buffer of the most recent events of one thread. Only the
+		///   owning thread writes, so recording takes no lock; the count of
+		///   events written is published for the dump. Events before the 
+		///   count at the last clear are not dumped.
+		/// </summary>
+		struct ring
+		{
+			std::vector<event> events;
+			std::atomic<std::uint64_t> written;
+			std::atomic<std::uint64_t> cleared;
+			unsigned int thread;
+		};
+
+		// Buffers of every thread which has recorded an event. A buffer is
+		// kept after its thread exits, so that its events can be dumped, and
+		// is reused by the next new thread, so that the number of buffers is
+		// bounded by the number of threads running at once
+		static std::mutex s_lock;
+		static std::vector<std::unique_ptr<ring>> s_rings;
+		static std::vector<ring*> s_free;
+
+		/// <summary>
+		///   Buffer of the calling thread, which is returned to the free list
+		///   when the thread exits.
+		/// </summary>
+		struct ring_owner
+		{
+			ring* r = nullptr;
+			~ring_owner()
+			{
+				if (r != nullptr)
+				{
+					std::lock_guard<std::mutex> guard(s_lock);
+					s_free.push_back(r);
+				}
+			}
+		};
+		static thread_local ring_owner t_owner;
+		static const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+		/// <summary>
+		///   Gets whether the library was built with LINMAT_TRACE, so that 
+		///   events are recorded.
+		/// </summary>
+		/// <returns>True if events are recorded.</returns>
+		bool enabled(void)
+		{
+#ifdef LINMAT_TRACE
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/// <summary>
+		///   Gets the time since the trace epoch.
+		/// </summary>
+		/// <returns>Time in nanoseconds.</returns>
+		std::uint64_t now(void)
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - s_epoch).count());
+		}
+
+		/// <summary>
+		///   Records an event in the buffer of the calling thread, replacing
+		///   the oldest event once the buffer is full.
+		/// </summary>
+		/// <param name="name">Name of the event, which must be a string literal.</param>
+		/// <param name="start">Start in nanoseconds since the trace epoch.</param>
+		/// <param name="end">End in nanoseconds since the trace epoch.</param>
+		/// <param name="arg">Argument, or negative for none.</param>
+		void record(const char* name, std::uint64_t start, std::uint64_t end, long long arg)
+		{
+			ring* r = t_owner.r;
+
+			if (r == nullptr)
+			{
+				std::lock_guard<std::mutex> guard(s_lock);
+				if (!s_free.empty())
+				{
+					r = s_free.back();
+					s_free.pop_back();
+				}
+				else
+				{
+					std::unique_ptr<ring> created(new ring());
+					created->events.resize(constants::TRACE_BUFFER_EVENTS);
+					created->written = 0;
+					created->cleared = 0;
+					created->thread = static_cast<unsigned int>(s_rings.size());
+					r = created.get();
+					s_rings.push_back(std::move(created));
+				}
+				t_owner.r = r;
+			}
+
+			std::uint64_t index = r->written.load(std::memory_order_relaxed);
+			r->events[index % r->events.size()] = { name, start, end - start, arg };
+			r->written.store(index + 1, std::memory_order_release);
+		}
+
+		/// <summary>
+		///   Writes the recorded events of every thread as a Chrome trace 
+		///   JSON file, which can be opened in Perfetto or chrome://tracing.
+		///   Events are read without stopping the threads recording them, so
+		///   the dump should be taken while linmat is idle; events which may
+		///   have been overwritten while reading are left out.
+		/// </summary>
+		/// <param name="path">Path of the file, which is replaced if it exists.</param>
+		void dump(const std::string& path)
+		{
+			std::lock_guard<std::mutex> guard(s_lock);
+			std::ofstream file(path);
+			bool first = true;
+
+			file << std::fixed << std::setprecision(3);
+			file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+			for (const std::unique_ptr<ring>& r : s_rings)
+			{
+				std::uint64_t size = r->events.size();
+				std::uint64_t end = r->written.load(std::memory_order_acquire);
+				std::uint64_t begin = std::max(end > size ? end - size : 0, r->cleared.load(std::memory_order_acquire));
+				std::vector<event> events;
+				for (std::uint64_t i = begin; i < end; i++)
+					events.push_back(r->events[i % size]);
+
+				// Drop events overwritten during the copy, and the event in the 
+				// slot which may be being written, number after - size
+				std::uint64_t after = r->written.load(std::memory_order_acquire);
+				std::size_t skip = static_cast<std::size_t>(std::min<std::uint64_t>(events.size(), after + 1 > size + begin ? after + 1 - size - begin : 0));
+
+				file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << r->thread
+					<< ",\"args\":{\"name\":\"linmat " << r->thread << "\"}}";
+				first = false;
+				for (std::size_t i = skip; i < events.size(); i++)
+				{
+					const event& e = events[i];
+					file << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << r->thread
+						<< ",\"ts\":" << e.start * 1e-3 << ",\"dur\":" << e.duration * 1e-3;
+					if (e.arg >= 0)
+						file << ",\"args\":{\"i\":" << e.arg << "}";
+					file << "}";
+				}
+			}
+			file << "\n]}\n";
+
+			file.close();
+			if (!file)
+				throw std::runtime_error("Unable to write trace file.");
+		}
+
+		/// <summary>
+		///   Discards the events recorded so far. The count of events written
+		///   is left to the owning threads, and only the point from which 
+		///   events are dumped is moved, so that the clear is not lost when a
+		///   thread is recording at the same time.
+		/// </summary>
+		void clear(void)
+		{
+			std::lock_guard<std::mutex> guard(s_lock);
+
+			for (const std::unique_ptr<ring>& r : s_rings)
+				r->cleared.store(r->written.load(std::memory_order_acquire), std::memory_order_release);
+		}
+	}
+}
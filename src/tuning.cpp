@@ -0,0 +1,423 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2024 James Bott
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files(the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions :
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include "../inc/tuning.hpp"
+#include "../inc/constants.hpp"
+#include "../inc/factorization.hpp"
+#include "../inc/mat.hpp"
+#include "../inc/operators.hpp"
+
+namespace linmat
+{
+	// Current parameters, which are read by each operation
+	static std::atomic<unsigned int> s_gemm_mc(constants::GEMM_MC);
+	static std::atomic<unsigned int> s_gemm_kc(constants::GEMM_KC);
+	static std::atomic<unsigned int> s_gemm_nc(constants::GEMM_NC);
+	static std::atomic<unsigned int> s_strassen_cutoff(constants::STRASSEN_CUTOFF);
+	static std::atomic<unsigned int> s_cholesky_tile(constants::CHOLESKY_TILE);
+	static std::atomic<unsigned int> s_parallel_threshold(constants::PARALLEL_THRESHOLD);
+	static std::atomic<unsigned int> s_inv_iterative_threshold(constants::INV_ITERATIVE_THRESHOLD);
+	static std::once_flag s_loaded;
+
+	/// <summary>
+	///   Stores the parameters without loading the tuning file.
+	/// </summary>
+	/// <param name="params">The parameters.</param>
+	static void store_tuning(const tuning_params& params)
+	{
+		s_gemm_mc = params.gemm_mc;
+		s_gemm_kc = params.gemm_kc;
+		s_gemm_nc = params.gemm_nc;
+		s_strassen_cutoff = params.strassen_cutoff;
+		s_cholesky_tile = params.cholesky_tile;
+		s_parallel_threshold = params.parallel_threshold;
+		s_inv_iterative_threshold = params.inv_iterative_threshold;
+	}
+
+	/// <summary>
+	///   Loads the file named by the LINMAT_TUNING_FILE environment 
+	///   variable, if it is set and the file exists.
+	/// </summary>
+	static void load_startup_tuning(void)
+	{
+		std::string path;
+
+#ifdef _WIN32
+		char* value = nullptr;
+		std::size_t length = 0;
+		if (_dupenv_s(&value, &length, "LINMAT_TUNING_FILE") == 0 && value != nullptr)
+		{
+			path = value;
+			std::free(value);
+		}
+#else
+		const char* value = std::getenv("LINMAT_TUNING_FILE");
+		if (value != nullptr)
+			path = value;
+#endif
+
+		if (!path.empty() && std::ifstream(path).good())
+			store_tuning(load_tuning(path));
+	}
+
+	/// <summary>
+	///   Gets the parameters given by the constants.
+	/// </summary>
+	/// <returns>The default parameters.</returns>
+	tuning_params default_tuning(void)
+	{
+		tuning_params params;
+
+		params.gemm_mc = constants::GEMM_MC;
+		params.gemm_kc = constants::GEMM_KC;
+		params.gemm_nc = constants::GEMM_NC;
+		params.strassen_cutoff = constants::STRASSEN_CUTOFF;
+		params.cholesky_tile = constants::CHOLESKY_TILE;
+		params.parallel_threshold = constants::PARALLEL_THRESHOLD;
+		params.inv_iterative_threshold = constants::INV_ITERATIVE_THRESHOLD;
+
+		return params;
+	}
+
+	/// <summary>
+	///   Gets the current parameters. On first use, these are loaded from 
+	///   the file named by the LINMAT_TUNING_FILE environment variable.
+	/// </summary>
+	/// <returns>The current parameters.</returns>
+	tuning_params tuning(void)
+	{
+		tuning_params params;
+
+		std::call_once(s_loaded, load_startup_tuning);
+		params.gemm_mc = s_gemm_mc;
+		params.gemm_kc = s_gemm_kc;
+		params.gemm_nc = s_gemm_nc;
+		params.strassen_cutoff = s_strassen_cutoff;
+		params.cholesky_tile = s_cholesky_tile;
+		params.parallel_threshold = s_parallel_threshold;
+		params.inv_iterative_threshold = s_inv_iterative_threshold;
+
+		return params;
+	}
+
+	/// <summary>
+	///   Overrides the current parameters. This should not be called while 
+	///   other threads are running operations.
+	/// </summary>
+	/// <param name="params">The parameters.</param>
+	void set_tuning(const tuning_params& params)
+	{
+		// Validate arguments
+		if (params.gemm_mc == 0 || params.gemm_kc == 0 || params.gemm_nc == 0 
+			|| params.strassen_cutoff == 0 || params.cholesky_tile == 0)
+			throw std::runtime_error("Block sizes and cutoffs must be greater than zero.");
+
+		std::call_once(s_loaded, load_startup_tuning);
+		store_tuning(params);
+	}
+
+	/// <summary>
+	///   Measures the shortest of several runs of a function.
+	/// </summary>
+	/// <typeparam name="F">Function type.</typeparam>
+	/// <param name="f">The function.</param>
+	/// <param name="reps">Number of runs.</param>
+	/// <returns>The shortest time in seconds.</returns>
+	template <typename F>
+	static double time_best(F f, unsigned int reps)
+	{
+		double best = std::numeric_limits<double>::max();
+
+		for (unsigned int r = 0; r < reps; r++)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			f();
+			best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+
+		return best;
+	}
+
+	/// <summary>
+	///   Makes a random symmetric positive-definite matrix.
+	/// </summary>
+	/// <param name="n">Order of the matrix.</param>
+	/// <param name="engine">The random number generator.</param>
+	/// <returns>The matrix.</returns>
+	static mat<double> make_spd(unsigned int n, std::mt19937& engine)
+	{
+		mat<double> A = mat<double>::make_randn(n, n, engine).gram();
+
+		for (unsigned int i = 0; i < n; i++)
+			A[i][i] += n;
+
+		return A;
+	}
+
+	/// <summary>
+	///   Benchmarks the block sizes and cutoffs on this host, by timing the 
+	///   multiplication, Cholesky decomposition and inverse of random 
+	///   matrices of double. The current parameters are restored afterwards,
+	///   and the result may be applied with set_tuning(). This takes a few 
+	///   seconds for the default order, and should be run at startup before 
+	///   other threads are running operations.
+	/// </summary>
+	/// <param name="order">Order of the largest matrices timed.</param>
+	/// <returns>The fastest parameters.</returns>
+	tuning_params autotune(unsigned int order)
+	{
+		const unsigned int reps = 3;
+		const unsigned int mc_candidates[] = { 32, 64, 128 };
+		const unsigned int kc_candidates[] = { 128, 256, 512 };
+		const unsigned int nc_candidates[] = { 256, 1024, 4096 };
+		const unsigned int tile_candidates[] = { 64, 128, 256 };
+		tuning_params original = tuning();
+		tuning_params best = original;
+		std::mt19937 engine(constants::RNG_SEED);
+		double best_time;
+
+		// Validate arguments
+		if (order < 8)
+			throw std::runtime_error("Order must be at least eight.");
+
+		mat<double> A = mat<double>::make_randn(order, order, engine);
+		mat<double> B = mat<double>::make_randn(order, order, engine);
+		mat<double> S = make_spd(order, engine);
+		mat<double> L;
+
+		try
+		{
+			// Blocks of the multiplication, first the rows and inner 
+			// dimension, then the columns of the right matrix
+			best_time = std::numeric_limits<double>::max();
+			for (unsigned int mc : mc_candidates)
+				for (unsigned int kc : kc_candidates)
+				{
+					tuning_params params = best;
+					params.gemm_mc = mc;
+					params.gemm_kc = kc;
+					store_tuning(params);
+					double t = time_best([&]() { A.mult(B); }, reps);
+					if (t < best_time)
+					{
+						best_time = t;
+						best = params;
+					}
+				}
+			for (unsigned int nc : nc_candidates)
+			{
+				tuning_params params = best;
+				params.gemm_nc = nc;
+				store_tuning(params);
+				double t = time_best([&]() { A.mult(B); }, reps);
+				if (t < best_time)
+				{
+					best_time = t;
+					best = params;
+				}
+			}
+
+			// Strassen cutoff, compared with the blocked multiplication in
+			// a single thread
+			tuning_params serial = best;
+			serial.parallel_threshold = std::numeric_limits<unsigned int>::max();
+			store_tuning(serial);
+			best_time = time_best([&]() { A.mult(B); }, reps);
+			best.strassen_cutoff = std::max(original.strassen_cutoff, order);
+			for (unsigned int cutoff : { order / 4, order / 2 })
+			{
+				double t = time_best([&]() { A.mult_strassen(B, cutoff); }, reps);
+				if (t < best_time)
+				{
+					best_time = t;
+					best.strassen_cutoff = cutoff;
+				}
+			}
+
+			// Tiles of the parallel Cholesky decomposition
+			store_tuning(best);
+			best_time = std::numeric_limits<double>::max();
+			for (unsigned int tile : tile_candidates)
+				if (2 * tile <= order)
+				{
+					double t = time_best([&]() { S.cholesky_decomposition_tiled(L, tile); }, reps);
+					if (t < best_time)
+					{
+						best_time = t;
+						best.cholesky_tile = tile;
+					}
+				}
+
+			// Order from which the tiled decomposition is faster than the 
+			// serial decomposition
+			best.parallel_threshold = std::max(original.parallel_threshold, 2 * order);
+			for (unsigned int n : { order / 2, order })
+			{
+				if (n < 2 * best.cholesky_tile)
+					continue;
+				mat<double> Sn = make_spd(n, engine);
+				store_tuning(serial);
+				double t_serial = time_best([&]() { Sn.cholesky_decomposition(L); }, reps);
+				double t_tiled = time_best([&]() { Sn.cholesky_decomposition_tiled(L, best.cholesky_tile); }, reps);
+				if (t_tiled < t_serial)
+				{
+					best.parallel_threshold = n;
+					break;
+				}
+			}
+
+			// Order above which Newton-Schulz iteration is faster than LU
+			// factorization for the inverse
+			for (unsigned int n : { order / 4, order / 2 })
+			{
+				if (n < 4)
+					continue;
+				mat<double> An = mat<double>::make_randn(n, n, engine);
+				store_tuning(best);
+				double t_direct = time_best([&]() { lu_factorization<double>(An).inverse(); }, 1);
+				double t_iterative = time_best([&]() { An.inv_shulz(); }, 1);
+				if (t_iterative < t_direct)
+				{
+					best.inv_iterative_threshold = n - 1;
+					break;
+				}
+			}
+		}
+		catch (...)
+		{
+			store_tuning(original);
+			throw;
+		}
+
+		store_tuning(original);
+		return best;
+	}
+
+	/// <summary>
+	///   Loads parameters from a file of "key = value" lines, as written by
+	///   save_tuning(). Parameters missing from the file keep their default
+	///   values, and lines starting with '#' are ignored.
+	/// </summary>
+	/// <param name="path">Path of the file.</param>
+	/// <returns>The parameters.</returns>
+	tuning_params load_tuning(const std::string& path)
+	{
+		tuning_params params = default_tuning();
+		std::ifstream file(path);
+		std::string line;
+
+		if (!file)
+			throw std::runtime_error("Unable to open tuning file.");
+
+		while (std::getline(file, line))
+		{
+			std::istringstream stream(line);
+			std::string key, equals;
+			long long value;
+
+			if (!(stream >> key) || key[0] == '#')
+				continue;
+			if (!(stream >> equals >> value) || equals != "=" || value <= 0 
+				|| value > std::numeric_limits<unsigned int>::max())
+				throw std::runtime_error("Invalid line in tuning file.");
+
+			unsigned int v = static_cast<unsigned int>(value);
+			if (key == "gemm_mc")
+				params.gemm_mc = v;
+			else if (key == "gemm_kc")
+				params.gemm_kc = v;
+			else if (key == "gemm_nc")
+				params.gemm_nc = v;
+			else if (key == "strassen_cutoff")
+				params.strassen_cutoff = v;
+			else if (key == "cholesky_tile")
+				params.cholesky_tile = v;
+			else if (key == "parallel_threshold")
+				params.parallel_threshold = v;
+			else if (key == "inv_iterative_threshold")
+				params.inv_iterative_threshold = v;
+			else
+				throw std::runtime_error("Unknown parameter in tuning file.");
+		}
+
+		return params;
+	}
+
+	/// <summary>
+	///   Saves parameters to a file of "key = value" lines.
+	/// </summary>
+	/// <param name="params">The parameters.</param>
+	/// <param name="path">Path of the file.</param>
+	void save_tuning(const tuning_params& params, const std::string& path)
+	{
+		std::ofstream file(path);
+
+		if (!file)
+			throw std::runtime_error("Unable to create tuning file.");
+
+		file << "# linmat tuning parameters\n"
+			<< "gemm_mc = " << params.gemm_mc << "\n"
+			<< "gemm_kc = " << params.gemm_kc << "\n"
+			<< "gemm_nc = " << params.gemm_nc << "\n"
+			<< "strassen_cutoff = " << params.strassen_cutoff << "\n"
+			<< "cholesky_tile = " << params.cholesky_tile << "\n"
+			<< "parallel_threshold = " << params.parallel_threshold << "\n"
+			<< "inv_iterative_threshold = " << params.inv_iterative_threshold << "\n";
+
+		if (!file)
+			throw std::runtime_error("Unable to write tuning file.");
+	}
+
+	/// <summary>
+	///   Applies the parameters cached in a file, or if the file does not 
+	///   exist, benchmarks them with autotune() and saves them to the file.
+	/// </summary>
+	/// <param name="path">Path of the cache file.</param>
+	/// <param name="order">Order of the largest matrices timed.</param>
+	/// <returns>The parameters applied.</returns>
+	tuning_params load_or_autotune(const std::string& path, unsigned int order)
+	{
+		tuning_params params;
+
+		if (std::ifstream(path).good())
+			params = load_tuning(path);
+		else
+		{
+			params = autotune(order);
+			save_tuning(params, path);
+		}
+		set_tuning(params);
+
+		return params;
+	}
+}
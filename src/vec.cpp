@@ -22,6 +22,7 @@
  * IN THE SOFTWARE.
 */
 #include "../inc/vec.hpp"
+#include "../inc/half.hpp"
 
 namespace linmat
 {
@@ -214,4 +215,8 @@ namespace linmat
 	template class cvec<float>;
 	template class cvec<double>;
 	template class cvec<long double>;
+	template class rvec<float16>;
+	template class rvec<bfloat16>;
+	template class cvec<float16>;
+	template class cvec<bfloat16>;
 };